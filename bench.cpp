@@ -0,0 +1,1172 @@
+// -----------------------------------------------------------------------------
+// BENCHMARK (Pengukuran kecepatan bagian inti, tanpa GUI)
+//   bench load <rows>    : bandingkan loader lama (getline/stringstream) dengan LoadData
+//   bench threads <rows> : ukur LoadData dengan 1, 2, 4, 8, 16 thread parsing
+//   bench layout <rows>  : ukur RecalculateLayout untuk N, 2N, 4N, 8N orang
+//   bench reload <rows>  : bandingkan load+layout penuh dengan ReloadData+UpdateLayout
+//   bench cull <rows>    : waktu query grid untuk satu layar (1024x768) di berbagai posisi scroll
+//   bench chain <rows>   : layout satu garis keturunan sepanjang N generasi (dengan dan tanpa siklus)
+//   bench snapshot <rows>: bandingkan parse+layout CSV dengan menulis/memuat snapshot biner
+//   bench parallel <rows>: layout arsip 50 keluarga akar dengan 1, 2, 4, 8 thread
+//   bench collapse <rows>: ciutkan semua lalu buka satu garis keturunan (waktu per klik)
+//   bench query <rows>   : bangun indeks silsilah lalu ukur pertanyaan hubungan dua orang (satu per
+//                          satu, penelusuran leluhur, dan batch 1, 2, 4, 8 thread)
+//   bench kinship <rows> : koefisien kekerabatan/inbreeding: F semua orang, batch pasangan, dan sub-matriks
+//                          pada data dengan pernikahan sepupu (1, 2, 4, 8 thread)
+//   bench search <rows>  : bangun indeks nama/peran lalu ukur pencarian awalan/substring/nama lengkap
+//   bench zoom <rows>    : blok ringkasan dan satu layar di berbagai skala zoom (kotak lengkap, polos,
+//                          blok per generasi), lalu geser dengan cache tile
+//   bench compact <rows> : layout classic vs compact pada tiga bentuk data (lebar canvas, waktu)
+//   bench gedcom <rows>  : baca CSV vs ekspor + baca GEDCOM (MB/s)
+//   bench validate <rows>: validasi data bersih dan data yang sengaja dirusak (ID ganda, rujukan hilang,
+//                          pasangan sepihak, siklus, peran orang tua) dengan 1, 2, 4, 8 thread
+//   bench generate <rows> [opsi]: tulis CSV sintetis yang bisa diatur (lihat GeneratorOptions)
+//   bench suite [maxRows] [--json F]: waktu per tahap untuk 1k..10M orang, hasil JSON untuk regresi
+// File CSV sintetis dibuat otomatis di folder kerja (bench_<rows>.csv). Benchmark hanya mengukur
+// waktu; kebenaran hasil (termasuk hasil paralel yang harus identik dengan serial) dicek di tests/tests.cpp.
+// -----------------------------------------------------------------------------
+#include <algorithm>   // std::min/max, std::count
+#include <chrono>      // Untuk mengukur durasi
+#include <cmath>       // Langkah skala zoom
+#include <cstdio>      // std::remove untuk file sementara
+#include <filesystem>  // Mengatur waktu modifikasi file pada benchmark reload
+#include <cstring>     // Untuk strcmp pada argumen
+#include <cstdlib>     // std::atof untuk opsi generator
+#include <fstream>     // Untuk menulis file CSV sintetis dan loader pembanding
+#include <iostream>    // Untuk output ke console
+#include <random>      // Generator angka acak deterministik
+#include <sstream>     // Untuk loader pembanding (cara lama)
+#include <thread>      // Jumlah core untuk laporan benchmark parallel
+
+#include "model.h"
+#include "layout.h"
+#include "spatial_index.h"
+#include "snapshot.h"
+#include "generator.h"
+#include "exporter.h"
+#include "gedcom.h"
+#include "pedigree.h"
+#include "search.h"
+#include "tile_cache.h"
+#include "validator.h"
+#include "kinship.h"
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Membuat CSV sintetis: beberapa pasangan akar, lalu anak-anak yang sebagian menikah
+// dengan orang dari luar keluarga (ID baru tanpa orang tua)
+static void WriteSyntheticCsv(const std::string& path, int rows) {
+    std::mt19937 rng(12345);
+    std::ofstream out(path);
+    out << "ID,Name,Role,Gender,FatherID,MotherID,SpouseID\n";
+
+    std::vector<std::pair<int, int>> couples; // (Ayah, Ibu) yang bisa punya anak
+    int nextId = 1;
+    for (int r = 0; r < 4 && nextId + 1 <= rows; ++r) {
+        int a = nextId++, b = nextId++;
+        out << a << ",Leluhur" << a << ",Eyang,M,0,0," << b << "\n";
+        out << b << ",Leluhur" << b << ",Eyang,F,0,0," << a << "\n";
+        couples.push_back({a, b});
+    }
+    while (nextId <= rows) {
+        // Pilih orang tua dari pasangan terbaru agar pohon tumbuh ke bawah
+        size_t window = std::min<size_t>(couples.size(), 64);
+        auto parents = couples[couples.size() - 1 - rng() % window];
+        int id = nextId++;
+        bool male = rng() % 2;
+        bool married = (rng() % 2) && nextId <= rows;
+        int spouseId = married ? nextId++ : 0;
+        out << id << ",Nama" << id << ",Anak," << (male ? "M" : "F") << ","
+            << parents.first << "," << parents.second << "," << spouseId << "\n";
+        if (married) {
+            out << spouseId << ",Pasangan" << spouseId << ",Menantu," << (male ? "F" : "M") << ",0,0," << id << "\n";
+            couples.push_back(male ? std::make_pair(id, spouseId) : std::make_pair(spouseId, id));
+        }
+    }
+}
+
+// Arsip banyak keluarga: `families` pasangan akar yang tumbuh sendiri-sendiri (baris data
+// berselang-seling antar keluarga). Sesekali anak keluarga 0..3 menikah dengan anak keluarga
+// berikutnya sehingga sebagian keluarga terhubung.
+static std::string EnsureForestCsv(int rows, int families) {
+    std::string path = "bench_forest_" + std::to_string(families) + "_" + std::to_string(rows) + ".csv";
+    std::ifstream check(path);
+    if (check.good()) return path;
+    std::mt19937 rng(777);
+    std::ofstream out(path);
+    out << "ID,Name,Role,Gender,FatherID,MotherID,SpouseID\n";
+
+    std::vector<std::vector<std::pair<int, int>>> couples(families);
+    int nextId = 1;
+    for (int f = 0; f < families; ++f) {
+        int a = nextId++, b = nextId++;
+        out << a << ",Leluhur" << a << ",Eyang,M,0,0," << b << "\n";
+        out << b << ",Leluhur" << b << ",Eyang,F,0,0," << a << "\n";
+        couples[f].push_back({a, b});
+    }
+    auto pickParents = [&](int f) {
+        size_t window = std::min<size_t>(couples[f].size(), 64);
+        return couples[f][couples[f].size() - 1 - rng() % window];
+    };
+    while (nextId <= rows) {
+        int f = (int)(rng() % families);
+        auto parents = pickParents(f);
+        int id = nextId++;
+        bool male = rng() % 2;
+        bool married = (rng() % 2) && nextId <= rows;
+        bool cross = married && f < 4 && rng() % 20 == 0;
+        int spouseId = married ? nextId++ : 0;
+        out << id << ",Nama" << id << ",Anak," << (male ? "M" : "F") << ","
+            << parents.first << "," << parents.second << "," << spouseId << "\n";
+        if (married) {
+            auto inLaws = cross ? pickParents(f + 1) : std::make_pair(0, 0);
+            out << spouseId << ",Pasangan" << spouseId << ",Menantu," << (male ? "F" : "M") << ","
+                << inLaws.first << "," << inLaws.second << "," << id << "\n";
+            couples[f].push_back(male ? std::make_pair(id, spouseId) : std::make_pair(spouseId, id));
+        }
+    }
+    return path;
+}
+
+static std::string EnsureCsv(int rows) {
+    std::string path = "bench_" + std::to_string(rows) + ".csv";
+    std::ifstream check(path);
+    if (!check.good()) WriteSyntheticCsv(path, rows);
+    return path;
+}
+
+// Loader pembanding: cara parsing lama (getline + stringstream per baris + std::stoi)
+static int LegacySafeToInt(const std::string& s) {
+    if (s.empty()) return 0;
+    try { return std::stoi(s); } catch (...) { return 0; }
+}
+
+static void LegacyLoad(DataModel& model, const std::string& path) {
+    model.Clear();
+    std::ifstream file(path);
+    std::string line;
+    int lineNum = 0;
+    while (std::getline(file, line)) {
+        lineNum++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        std::string item;
+        Person p;
+        p.line = lineNum;
+        std::getline(ss, item, ','); p.id = LegacySafeToInt(item);
+        if (p.id == 0) continue;
+        std::getline(ss, item, ','); p.name = model.strings.Add(item);
+        std::getline(ss, item, ','); p.role = model.strings.Intern(item);
+        std::getline(ss, item, ','); p.gender = ParseGender(item);
+        std::getline(ss, item, ','); p.fatherId = LegacySafeToInt(item);
+        std::getline(ss, item, ','); p.motherId = LegacySafeToInt(item);
+        p.spouseBegin = (uint32_t)model.spouseLinks.size();
+        if (std::getline(ss, item, ',')) {
+            std::stringstream ssSpouse(item);
+            std::string token;
+            while (std::getline(ssSpouse, token, '|')) {
+                if (token.empty()) continue;
+                bool isEx = (token.back() == 'x' || token.back() == 'X');
+                if (isEx) token.pop_back();
+                int spId = LegacySafeToInt(token);
+                if (spId != 0) model.spouseLinks.push_back({ spId, isEx });
+            }
+        }
+        p.spouseCount = (uint32_t)model.spouseLinks.size() - p.spouseBegin;
+        model.people.push_back(p);
+    }
+    model.BuildIndexes();
+}
+
+static int BenchLoad(int rows) {
+    std::string path = EnsureCsv(rows);
+
+    // Log per baris dimatikan selama pengukuran agar yang diukur hanya parsing
+    std::cout.setstate(std::ios::badbit);
+    DataModel legacy, fast;
+    auto t0 = std::chrono::steady_clock::now();
+    LegacyLoad(legacy, path);
+    double legacyMs = ElapsedMs(t0);
+    t0 = std::chrono::steady_clock::now();
+    LoadData(fast, path, 1);
+    double fastMs = ElapsedMs(t0);
+    std::cout.clear();
+
+    std::cout << "[BENCH] load rows=" << rows
+              << " legacy_ms=" << legacyMs
+              << " mmap_ms=" << fastMs
+              << " speedup=" << (fastMs > 0 ? legacyMs / fastMs : 0) << "\n";
+    return 0;
+}
+
+static int BenchThreads(int rows) {
+    std::string path = EnsureCsv(rows);
+    double serialMs = 0;
+    for (unsigned t = 1; t <= 16; t *= 2) {
+        DataModel model;
+        std::cout.setstate(std::ios::badbit);
+        auto t0 = std::chrono::steady_clock::now();
+        LoadData(model, path, t);
+        double ms = ElapsedMs(t0);
+        std::cout.clear();
+
+        if (t == 1) serialMs = ms;
+        std::cout << "[BENCH] load rows=" << rows << " threads=" << t
+                  << " load_ms=" << ms
+                  << " speedup=" << (ms > 0 ? serialMs / ms : 0) << "\n";
+    }
+    return 0;
+}
+
+static int BenchLayout(int rows) {
+    for (int n = rows; n <= rows * 8; n *= 2) {
+        std::string path = EnsureCsv(n);
+        DataModel model;
+        std::cout.setstate(std::ios::badbit);
+        LoadData(model, path);
+        auto t0 = std::chrono::steady_clock::now();
+        RecalculateLayout(model);
+        double ms = ElapsedMs(t0);
+        std::cout.clear();
+        std::cout << "[BENCH] layout people=" << model.people.size()
+                  << " layout_ms=" << ms
+                  << " ns_per_person=" << (ms * 1e6 / std::max<size_t>(model.people.size(), 1)) << "\n";
+    }
+    return 0;
+}
+
+// Satu garis keturunan lurus: orang ke-i adalah anak orang ke-(i-1). Jika withCycle, istri akar
+// (ID rows+1) adalah anak generasi terakhir sekaligus ibu generasi kedua, sehingga terbentuk siklus.
+static std::string EnsureChainCsv(int rows, bool withCycle) {
+    std::string path = "bench_chain" + std::string(withCycle ? "_cycle_" : "_") + std::to_string(rows) + ".csv";
+    std::ifstream check(path);
+    if (check.good()) return path;
+    std::ofstream out(path);
+    out << "ID,Name,Role,Gender,FatherID,MotherID,SpouseID\n";
+    int wife = rows + 1;
+    out << "1,Leluhur1,Eyang,M,0,0," << (withCycle ? wife : 0) << "\n";
+    for (int id = 2; id <= rows; ++id) {
+        int mother = (withCycle && id == 2) ? wife : 0;
+        out << id << ",Nama" << id << ",Anak,M," << (id - 1) << "," << mother << ",0\n";
+    }
+    if (withCycle) out << wife << ",Istri" << wife << ",Eyang,F," << rows << ",0,1\n";
+    return path;
+}
+
+static int BenchChain(int rows) {
+    for (int cycle = 0; cycle <= 1; ++cycle) {
+        for (int n = rows; n <= rows * 4; n *= 2) {
+            std::string path = EnsureChainCsv(n, cycle != 0);
+            DataModel model;
+            std::cout.setstate(std::ios::badbit);
+            LoadData(model, path);
+            auto t0 = std::chrono::steady_clock::now();
+            LayoutStats st = RecalculateLayout(model);
+            double ms = ElapsedMs(t0);
+            std::cout.clear();
+
+            std::cout << "[BENCH] chain generations=" << n << " cycle=" << (cycle ? "yes" : "no")
+                      << " layout_ms=" << ms
+                      << " ns_per_person=" << (ms * 1e6 / std::max<size_t>(model.people.size(), 1))
+                      << " cycles_ignored=" << st.cyclesIgnored << "\n";
+        }
+    }
+    return 0;
+}
+
+// Menyalin file sambil mengganti satu baris (indeks baris data, header tidak dihitung)
+static void WriteEdited(const std::string& src, const std::string& dst, size_t dataLine, const std::string& newLine) {
+    std::ifstream in(src);
+    std::ofstream out(dst);
+    std::string line;
+    size_t n = 0;
+    std::getline(in, line);
+    out << line << "\n";
+    while (std::getline(in, line)) {
+        out << (n++ == dataLine ? newLine : line) << "\n";
+    }
+}
+
+static int BenchReload(int rows) {
+    std::string path = EnsureCsv(rows);
+    std::string work = "bench_reload.csv";
+    size_t target = (size_t)rows / 2;
+    int targetId = (int)target + 1; // File sintetis memakai ID = nomor baris data + 1
+
+    // Ambil baris target, lalu buat dua variasi: ganti peran saja, dan ganti ayah (struktur)
+    std::string original;
+    {
+        std::ifstream in(path);
+        std::getline(in, original);
+        for (size_t i = 0; i <= target; ++i) std::getline(in, original);
+    }
+    std::vector<std::string> cols;
+    std::stringstream ss(original);
+    for (std::string c; std::getline(ss, c, ',');) cols.push_back(c);
+    while (cols.size() < 7) cols.push_back("0");
+    auto join = [&](const std::vector<std::string>& v) {
+        std::string r;
+        for (size_t i = 0; i < v.size(); ++i) r += (i ? "," : "") + v[i];
+        return r;
+    };
+    std::vector<std::string> roleEdit = cols; roleEdit[2] = "PeranBaru";
+    std::vector<std::string> parentEdit = cols; parentEdit[4] = "1"; parentEdit[5] = "2";
+
+    struct Variant { const char* name; std::string line; } variants[] = {
+        { "role", join(roleEdit) },
+        { "parent", join(parentEdit) },
+    };
+
+    for (const auto& v : variants) {
+        std::cout.setstate(std::ios::badbit);
+        WriteEdited(path, work, target, original);
+        DataModel live;
+        LoadData(live, work);
+        RecalculateLayout(live);
+
+        WriteEdited(path, work, target, v.line);
+        std::filesystem::last_write_time(work, live.lastWriteTime + std::chrono::seconds(1));
+
+        auto t0 = std::chrono::steady_clock::now();
+        ReloadResult r = ReloadData(live, work);
+        LayoutStats st = ApplyReload(live, r);
+        double incMs = ElapsedMs(t0);
+
+        DataModel full;
+        t0 = std::chrono::steady_clock::now();
+        LoadData(full, work);
+        RecalculateLayout(full);
+        double fullMs = ElapsedMs(t0);
+        std::cout.clear();
+
+        std::cout << "[BENCH] reload rows=" << rows << " edit=" << v.name << " (id " << targetId << ")"
+                  << " full_ms=" << fullMs << " incremental_ms=" << incMs
+                  << " modified=" << r.modified << " widths_recomputed=" << st.widthsComputed << "\n";
+    }
+    std::remove(work.c_str());
+    return 0;
+}
+
+static int BenchCull(int rows) {
+    for (int n = rows; n <= rows * 8; n *= 2) {
+        std::string path = EnsureCsv(n);
+        DataModel model;
+        std::cout.setstate(std::ios::badbit);
+        LoadData(model, path);
+        RecalculateLayout(model);
+        std::cout.clear();
+
+        auto t0 = std::chrono::steady_clock::now();
+        SceneIndex scene;
+        BuildSceneIndex(model, scene);
+        double buildMs = ElapsedMs(t0);
+
+        // Viewport dipusatkan pada orang acak (canvas sintetis sangat jarang)
+        std::mt19937 rng(7);
+        std::vector<uint32_t> visible, lines;
+        const int queries = 200;
+        size_t found = 0, foundLines = 0;
+        double queryMs = 0;
+        for (int q = 0; q < queries; ++q) {
+            size_t p = rng() % model.people.size();
+            Rect view = { model.posX[p] - 512, model.posY[p] - 384, model.posX[p] + 512, model.posY[p] + 384 };
+            t0 = std::chrono::steady_clock::now();
+            scene.boxes.Query(view, visible);
+            scene.connectors.Query(view, lines);
+            queryMs += ElapsedMs(t0);
+            found += visible.size();
+            foundLines += lines.size();
+        }
+        std::cout << "[BENCH] cull people=" << model.people.size()
+                  << " build_ms=" << buildMs
+                  << " query_us=" << (queryMs * 1000.0 / queries)
+                  << " boxes_per_view=" << (double)found / queries
+                  << " connectors_per_view=" << (double)foundLines / queries
+                  << " cells=" << scene.boxes.CellCount() << "\n";
+    }
+    return 0;
+}
+
+static int BenchParallel(int rows) {
+    const int families = 50;
+    std::string path = EnsureForestCsv(rows, families);
+    double serialMs = 0;
+    for (unsigned threads = 1; threads <= 8; threads *= 2) {
+        DataModel model;
+        std::cout.setstate(std::ios::badbit);
+        LoadData(model, path);
+        auto t0 = std::chrono::steady_clock::now();
+        LayoutStats st = RecalculateLayout(model, threads);
+        double ms = ElapsedMs(t0);
+        std::cout.clear();
+
+        if (threads == 1) serialMs = ms;
+        std::cout << "[BENCH] parallel people=" << model.people.size() << " families=" << families
+                  << " roots=" << st.rootsPositioned << " threads=" << threads
+                  << " layout_ms=" << ms << " speedup=" << serialMs / ms << "\n";
+    }
+    std::cout << "[BENCH] hardware_threads=" << std::thread::hardware_concurrency() << "\n";
+    return 0;
+}
+
+static int BenchSnapshot(int rows) {
+    std::string path = EnsureCsv(rows);
+    std::remove(SnapshotPath(path).c_str());
+
+    std::cout.setstate(std::ios::badbit);
+    DataModel parsed;
+    auto t0 = std::chrono::steady_clock::now();
+    LoadData(parsed, path);
+    double parseMs = ElapsedMs(t0);
+    t0 = std::chrono::steady_clock::now();
+    RecalculateLayout(parsed);
+    double layoutMs = ElapsedMs(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    bool saved = SaveSnapshot(parsed, path);
+    double saveMs = ElapsedMs(t0);
+
+    DataModel loaded;
+    bool hasLayout = false;
+    t0 = std::chrono::steady_clock::now();
+    bool ok = saved && LoadSnapshot(loaded, path, hasLayout);
+    double loadMs = ElapsedMs(t0);
+    std::cout.clear();
+    if (!ok) {
+        std::cout << "[ERROR] Could not write or read " << SnapshotPath(path) << "\n";
+        return 1;
+    }
+
+    std::error_code ec;
+    std::cout << "[BENCH] snapshot people=" << parsed.people.size()
+              << " parse_ms=" << parseMs << " layout_ms=" << layoutMs
+              << " save_ms=" << saveMs << " load_ms=" << loadMs
+              << " snap_mb=" << std::filesystem::file_size(SnapshotPath(path), ec) / (1024.0 * 1024.0) << "\n";
+    std::remove(SnapshotPath(path).c_str());
+    return 0;
+}
+
+// Membaca opsi generator dari argumen "--nama nilai" (sisanya diabaikan)
+static GeneratorOptions ParseGeneratorOptions(int rows, int argc, char** argv, std::string& out) {
+    GeneratorOptions opt;
+    opt.people = (size_t)rows;
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--unicode") opt.unicodeNames = true;
+        else if (arg == "--out" && hasValue) out = argv[++i];
+        else if (arg == "--roots" && hasValue) opt.roots = std::atoi(argv[++i]);
+        else if (arg == "--depth" && hasValue) opt.maxDepth = std::atoi(argv[++i]);
+        else if (arg == "--branching" && hasValue) opt.branching = std::atof(argv[++i]);
+        else if (arg == "--marriage" && hasValue) opt.marriageRate = std::atof(argv[++i]);
+        else if (arg == "--remarriage" && hasValue) opt.remarriageRate = std::atof(argv[++i]);
+        else if (arg == "--single-parent" && hasValue) opt.singleParentRate = std::atof(argv[++i]);
+        else if (arg == "--consanguinity" && hasValue) opt.consanguinityRate = std::atof(argv[++i]);
+        else if (arg == "--seed" && hasValue) opt.seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        else std::cout << "[BENCH] ignoring option " << arg << "\n";
+    }
+    return opt;
+}
+
+static void PrintGeneratorStats(const std::string& path, const GeneratorStats& st, double ms) {
+    std::cout << "[BENCH] generate file=" << path << " people=" << st.people << " roots=" << st.roots
+              << " marriages=" << st.marriages << " divorces=" << st.divorces
+              << " single_parent=" << st.singleParent << " consanguineous=" << st.consanguineous << " depth=" << st.depth << " ms=" << ms << "\n";
+}
+
+// bench_gen_<rows>.csv dari generator dengan opsi bawaan dan nama Unicode (dibuat jika belum ada)
+static std::string EnsureGeneratedCsv(int rows) {
+    std::string path = "bench_gen_" + std::to_string(rows) + ".csv";
+    std::ifstream check(path);
+    if (!check.good()) {
+        GeneratorOptions opt;
+        opt.people = (size_t)rows;
+        opt.unicodeNames = true;
+        opt.maxDepth = 30;
+        GeneratorStats st;
+        auto t0 = std::chrono::steady_clock::now();
+        GenerateFamilyCsv(path, opt, &st);
+        PrintGeneratorStats(path, st, ElapsedMs(t0));
+    }
+    return path;
+}
+
+static int BenchCollapse(int rows) {
+    std::string path = EnsureCsv(rows);
+    DataModel model;
+    std::cout.setstate(std::ios::badbit);
+    LoadData(model, path);
+    auto t0 = std::chrono::steady_clock::now();
+    RecalculateLayout(model);
+    double fullMs = ElapsedMs(t0);
+    std::cout.clear();
+
+    auto countPlaced = [&]() { return (size_t)std::count(model.placed.begin(), model.placed.end(), 1); };
+    t0 = std::chrono::steady_clock::now();
+    SetAllCollapsed(model, true);
+    double collapseAllMs = ElapsedMs(t0);
+    size_t rootsOnly = countPlaced();
+
+    // Buka leluhur orang terakhir di data dari akar ke bawah, seperti pengguna mengklik satu cabang
+    std::vector<int> chain;
+    for (size_t i = model.people.size() - 1; i != IdIndex::NPOS; ) {
+        chain.push_back(model.people[i].id);
+        // Naik lewat orang tua yang punya orang tua lagi (bukan menantu dari luar keluarga)
+        uint32_t f = model.fatherIndex[i], m = model.motherIndex[i];
+        bool fatherUp = f != DataModel::NO_INDEX && (model.fatherIndex[f] != DataModel::NO_INDEX || m == DataModel::NO_INDEX);
+        uint32_t up = fatherUp ? f : m;
+        if (up == DataModel::NO_INDEX) break;
+        i = up;
+    }
+    double totalMs = 0, maxMs = 0, sceneMs = 0;
+    size_t toggles = 0;
+    SceneIndex scene;
+    const size_t maxToggles = 64; // Cukup untuk rata-rata; garis keturunan sintetis bisa sangat dalam
+    if (chain.size() > maxToggles) chain.erase(chain.begin(), chain.end() - maxToggles);
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        t0 = std::chrono::steady_clock::now();
+        LayoutStats st = SetCollapsed(model, *it, false);
+        double ms = ElapsedMs(t0);
+        t0 = std::chrono::steady_clock::now();
+        BuildSceneIndex(model, scene);
+        sceneMs += ElapsedMs(t0);
+        totalMs += ms;
+        maxMs = std::max(maxMs, ms);
+        toggles++;
+        if (toggles == 1) {
+            std::cout << "[BENCH] collapse first toggle widths=" << st.widthsComputed << " widths_ms=" << st.widthsMs
+                      << " position_ms=" << st.positionMs << " connectors_ms=" << st.connectorsMs << "\n";
+        }
+    }
+    size_t branch = countPlaced();
+
+    // Menciutkan satu orang di pohon yang terbuka penuh: semua posisi di kanannya ikut bergeser
+    SetAllCollapsed(model, false);
+    t0 = std::chrono::steady_clock::now();
+    SetCollapsed(model, chain.back(), true);
+    SetCollapsed(model, chain.back(), false);
+    double expandedToggleMs = ElapsedMs(t0) / 2;
+
+    std::cout << "[BENCH] collapse people=" << model.people.size()
+              << " full_layout_ms=" << fullMs
+              << " collapse_all_ms=" << collapseAllMs
+              << " visible_roots_only=" << rootsOnly
+              << " chain=" << toggles
+              << " toggle_avg_ms=" << (toggles ? totalMs / toggles : 0)
+              << " toggle_max_ms=" << maxMs
+              << " scene_avg_ms=" << (toggles ? sceneMs / toggles : 0)
+              << " visible_after=" << branch
+              << " toggle_expanded_ms=" << expandedToggleMs << "\n";
+    return 0;
+}
+
+static int BenchCompact(int rows) {
+    struct Input { const char* name; std::string path; };
+    Input inputs[] = {
+        { "synthetic", EnsureCsv(rows) },
+        { "forest", EnsureForestCsv(rows, 50) },
+        { "generated", EnsureGeneratedCsv(rows) },
+    };
+    for (const Input& in : inputs) {
+        DataModel classic, compact;
+        std::cout.setstate(std::ios::badbit);
+        LoadData(classic, in.path);
+        LoadData(compact, in.path);
+        compact.layoutMode = LayoutMode::Compact;
+        auto t0 = std::chrono::steady_clock::now();
+        RecalculateLayout(classic, 1);
+        double classicMs = ElapsedMs(t0);
+        t0 = std::chrono::steady_clock::now();
+        LayoutStats st = RecalculateLayout(compact, 1);
+        double compactMs = ElapsedMs(t0);
+        std::cout.clear();
+
+        std::cout << "[BENCH] compact data=" << in.name << " people=" << compact.people.size()
+                  << " classic_canvas=" << classic.maxX << "x" << classic.maxY
+                  << " compact_canvas=" << compact.maxX << "x" << compact.maxY
+                  << " width_ratio=" << (double)compact.maxX / classic.maxX
+                  << " classic_ms=" << classicMs << " compact_ms=" << compactMs
+                  << " contour_ms=" << st.widthsMs << " position_ms=" << st.positionMs << "\n";
+    }
+    return 0;
+}
+
+static int BenchGedcom(int rows) {
+    struct Input { const char* name; std::string path; };
+    Input inputs[] = {
+        { "synthetic", EnsureCsv(rows) },
+        { "generated", EnsureGeneratedCsv(rows) },
+    };
+    for (const Input& in : inputs) {
+        std::string gedPath = in.path.substr(0, in.path.size() - 4) + ".ged";
+        DataModel csv, ged;
+        std::cout.setstate(std::ios::badbit);
+        auto t0 = std::chrono::steady_clock::now();
+        LoadData(csv, in.path, 1);
+        double csvMs = ElapsedMs(t0);
+        t0 = std::chrono::steady_clock::now();
+        bool written = ExportGedcom(csv, gedPath);
+        double exportMs = ElapsedMs(t0);
+        t0 = std::chrono::steady_clock::now();
+        LoadData(ged, gedPath);
+        double gedMs = ElapsedMs(t0);
+        std::cout.clear();
+        if (!written) {
+            std::cout << "[ERROR] Could not write " << gedPath << "\n";
+            return 1;
+        }
+
+        std::error_code ec;
+        double csvMb = std::filesystem::file_size(in.path, ec) / (1024.0 * 1024.0);
+        double gedMb = std::filesystem::file_size(gedPath, ec) / (1024.0 * 1024.0);
+        std::cout << "[BENCH] gedcom data=" << in.name << " people=" << csv.people.size()
+                  << " csv_mb=" << csvMb << " csv_ms=" << csvMs << " csv_mb_s=" << (csvMs > 0 ? csvMb * 1000 / csvMs : 0)
+                  << " ged_mb=" << gedMb << " export_ms=" << exportMs << " export_mb_s=" << (exportMs > 0 ? gedMb * 1000 / exportMs : 0)
+                  << " ged_ms=" << gedMs << " ged_mb_s=" << (gedMs > 0 ? gedMb * 1000 / gedMs : 0)
+                  << " ged_vs_csv_time=" << (csvMs > 0 ? gedMs / csvMs : 0) << "\n";
+    }
+    return 0;
+}
+
+// Salinan CSV sintetis (ID = nomor baris data + 1) dengan kesalahan yang sengaja dibuat
+static std::string EnsureBrokenCsv(int rows) {
+    std::string src = EnsureCsv(rows);
+    std::string path = "bench_broken_" + std::to_string(rows) + ".csv";
+    std::ifstream in(src);
+    std::string header, line;
+    std::getline(in, header);
+    std::vector<std::vector<std::string>> table;
+    while (std::getline(in, line)) {
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string item;
+        while (std::getline(ss, item, ',')) fields.push_back(item);
+        fields.resize(7);
+        table.push_back(fields);
+    }
+    size_t n = table.size();
+    table[0][3] = "F";                                        // Ayah akar pertama menjadi perempuan
+    table[3][6] += "|5";                                      // Pasangan sepihak
+    table[n / 4][4] = "2000000000";                           // Ayah yang tidak ada
+    table[n / 2][0] = table[n / 2 - 1][0];                    // ID ganda
+    for (size_t k = n * 3 / 4; k < n; ++k) {                  // Siklus: Ayah X menjadi anak X
+        int father = std::atoi(table[k][4].c_str());
+        if (father <= 8) continue;
+        table[(size_t)father - 1][4] = table[k][0];
+        break;
+    }
+    std::ofstream out(path);
+    out << header << "\n";
+    for (const auto& fields : table) {
+        for (size_t f = 0; f < fields.size(); ++f) out << (f ? "," : "") << fields[f];
+        out << "\n";
+    }
+    return path;
+}
+
+static int BenchValidate(int rows) {
+    struct Input { const char* name; std::string path; bool clean; };
+    Input inputs[] = {
+        { "clean", EnsureCsv(rows), true },
+        { "broken", EnsureBrokenCsv(rows), false },
+    };
+    for (const Input& in : inputs) {
+        DataModel model;
+        std::cout.setstate(std::ios::badbit);
+        LoadData(model, in.path);
+        std::cout.clear();
+
+        ValidationReport serial;
+        for (unsigned t = 1; t <= 8; t *= 2) {
+            ValidationReport report = ValidateModel(model, t);
+            if (t == 1) serial = report;
+            std::cout << "[BENCH] validate data=" << in.name << " people=" << report.people << " threads=" << t
+                      << " ms=" << report.ms << " speedup=" << (report.ms > 0 ? serial.ms / report.ms : 0)
+                      << " issues=" << report.issues.size() << " unreachable=" << report.unreachable << "\n";
+        }
+        if (!in.clean) {
+            for (size_t k = 0; k < (size_t)IssueKind::Count; ++k) {
+                if (serial.counts[k]) std::cout << "[BENCH]   " << IssueKindName((IssueKind)k) << "=" << serial.counts[k] << "\n";
+            }
+        }
+    }
+    return 0;
+}
+
+// Separuh pasangan acak (kebanyakan tidak berhubungan atau sepupu jauh), separuh kerabat dekat:
+// naik 1-4 generasi lewat orang tua acak lalu turun 1-4 generasi lewat anak acak
+static std::vector<std::pair<uint32_t, uint32_t>> MixedPairs(const DataModel& model, const PedigreeIndex& pedigree, size_t count) {
+    size_t n = model.people.size();
+    std::mt19937 rng(777);
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    pairs.reserve(count);
+    for (size_t k = 0; k < count; ++k) {
+        uint32_t a = (uint32_t)(rng() % n), b = (uint32_t)(rng() % n);
+        if (k % 2) {
+            b = a;
+            for (int up = 1 + (int)(rng() % 4); up > 0; --up) {
+                uint32_t p = (rng() % 2) ? model.fatherIndex[b] : model.motherIndex[b];
+                if (p == DataModel::NO_INDEX) p = model.fatherIndex[b];
+                if (p == DataModel::NO_INDEX) p = model.motherIndex[b];
+                if (p == DataModel::NO_INDEX) break;
+                b = p;
+            }
+            for (int down = 1 + (int)(rng() % 4); down > 0; --down) {
+                std::vector<Relative> kids = pedigree.Descendants(b, 1);
+                if (kids.empty()) break;
+                b = kids[rng() % kids.size()].index;
+            }
+        }
+        pairs.push_back({ a, b });
+    }
+    return pairs;
+}
+
+static int BenchQuery(int rows) {
+    // Data generator (cerai/menikah lagi dan orang tua tunggal) agar jalur lambat ikut teruji
+    std::string path = "bench_query_" + std::to_string(rows) + ".csv";
+    std::ifstream check(path);
+    if (!check.good()) {
+        GeneratorOptions opt;
+        opt.people = (size_t)rows;
+        opt.maxDepth = 30;
+        GeneratorStats st;
+        auto t0 = std::chrono::steady_clock::now();
+        GenerateFamilyCsv(path, opt, &st);
+        PrintGeneratorStats(path, st, ElapsedMs(t0));
+    }
+    check.close();
+
+    DataModel model;
+    std::cout.setstate(std::ios::badbit);
+    LoadData(model, path);
+    std::cout.clear();
+    size_t n = model.people.size();
+    if (n == 0) return 1;
+
+    PedigreeIndex pedigree;
+    auto t0 = std::chrono::steady_clock::now();
+    pedigree.Build(model);
+    double buildMs = ElapsedMs(t0);
+
+    const size_t PAIRS = 200000;
+    std::vector<std::pair<uint32_t, uint32_t>> pairs = MixedPairs(model, pedigree, PAIRS);
+
+    size_t simple = 0;
+    for (const auto& pr : pairs) simple += pedigree.SimpleLine(pr.first) && pedigree.SimpleLine(pr.second);
+
+    std::vector<Relationship> serial(pairs.size());
+    t0 = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < pairs.size(); ++k) serial[k] = pedigree.Relate(pairs[k].first, pairs[k].second);
+    double singleNs = ElapsedMs(t0) * 1e6 / pairs.size();
+
+    size_t related = 0, exact = 0; // exact hanya agar hasil RelateExact tidak dibuang compiler
+    t0 = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < pairs.size(); k += 4) { // Penelusuran leluhur lambat: seperempat saja
+        exact += pedigree.RelateExact(pairs[k].first, pairs[k].second).related;
+    }
+    double exactNs = ElapsedMs(t0) * 1e6 / ((pairs.size() + 3) / 4);
+    for (const Relationship& r : serial) related += r.related;
+
+    std::cout << "[BENCH] query people=" << n << " build_ms=" << buildMs << " cycles_cut=" << pedigree.CyclesCut()
+              << " pairs=" << pairs.size() << " related=" << related << " fast_path=" << (100.0 * simple / pairs.size()) << "%"
+              << " relate_ns=" << singleNs << " exact_ns=" << exactNs << "\n";
+
+    for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+        std::vector<Relationship> out;
+        t0 = std::chrono::steady_clock::now();
+        pedigree.RelateBatch(pairs, out, threads);
+        double ms = ElapsedMs(t0);
+        std::cout << "[BENCH] query batch threads=" << threads << " ms=" << ms
+                  << " pairs_per_sec=" << (size_t)(pairs.size() / (ms / 1000.0)) << "\n";
+    }
+
+    // Contoh nama hubungan dari pasangan kerabat dekat
+    for (size_t k = 1; k < 12; k += 2) {
+        const Person& pa = model.people[pairs[k].first];
+        std::cout << "[BENCH] query " << pa.id << " -> " << model.people[pairs[k].second].id << ": "
+                  << RelationshipName(serial[k], pa.gender) << "\n";
+    }
+    return 0;
+}
+
+// Data generator dengan pernikahan antar sepupu (dibuat jika belum ada)
+static std::string EnsureConsanguineousCsv(int rows, double rate) {
+    std::string path = "bench_kinship_" + std::to_string(rows) + "_" + std::to_string((int)(rate * 100 + 0.5)) + ".csv";
+    std::ifstream check(path);
+    if (!check.good()) {
+        GeneratorOptions opt;
+        opt.people = (size_t)rows;
+        opt.maxDepth = 30;
+        opt.consanguinityRate = rate;
+        GeneratorStats st;
+        auto t0 = std::chrono::steady_clock::now();
+        GenerateFamilyCsv(path, opt, &st);
+        PrintGeneratorStats(path, st, ElapsedMs(t0));
+    }
+    return path;
+}
+
+static bool LoadQuiet(DataModel& model, const std::string& path) {
+    std::cout.setstate(std::ios::badbit);
+    bool ok = LoadData(model, path);
+    std::cout.clear();
+    return ok && !model.people.empty();
+}
+
+static int BenchKinship(int rows) {
+    // F semua orang dengan 1..8 thread, lalu pasangan dan sub-matriks
+    DataModel model;
+    if (!LoadQuiet(model, EnsureConsanguineousCsv(rows, 0.02))) return 1;
+    size_t n = model.people.size();
+    PedigreeIndex pedigree;
+    auto t0 = std::chrono::steady_clock::now();
+    pedigree.Build(model);
+    double pedigreeMs = ElapsedMs(t0);
+
+    KinshipIndex kinship;
+    double serialMs = 0;
+    for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+        kinship.Build(pedigree, threads);
+        const KinshipStats& st = kinship.Stats();
+        if (threads == 1) serialMs = st.ms;
+        std::cout << "[BENCH] kinship inbreeding people=" << n << " threads=" << threads << " pedigree_ms=" << pedigreeMs
+                  << " ms=" << st.ms << " speedup=" << (st.ms > 0 ? serialMs / st.ms : 0) << " both_parents=" << st.bothParents
+                  << " inbred=" << st.inbred << " mean_f=" << st.meanInbreeding << " max_f=" << st.maxInbreeding
+                  << " pairs_computed=" << st.pairsComputed << " memo_clears=" << st.memoClears << "\n";
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> pairs = MixedPairs(model, pedigree, 200000);
+    for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+        std::vector<double> out;
+        t0 = std::chrono::steady_clock::now();
+        kinship.KinshipBatch(pairs, out, threads);
+        double ms = ElapsedMs(t0);
+        size_t related = 0;
+        for (double v : out) related += v > 0;
+        std::cout << "[BENCH] kinship batch pairs=" << pairs.size() << " threads=" << threads << " ms=" << ms
+                  << " pairs_per_sec=" << (size_t)(pairs.size() / (ms / 1000.0)) << " related=" << related << "\n";
+    }
+
+    // Sub-matriks: orang inbred (sampai 1000)
+    std::vector<uint32_t> group;
+    for (size_t i = 0; i < n && group.size() < 1000; ++i) {
+        if (kinship.Inbreeding(i) > 0) group.push_back((uint32_t)i);
+    }
+    if (!group.empty()) {
+        std::vector<double> matrix;
+        t0 = std::chrono::steady_clock::now();
+        kinship.KinshipMatrix(group, matrix);
+        double ms = ElapsedMs(t0);
+        std::cout << "[BENCH] kinship matrix size=" << group.size() << "x" << group.size() << " ms=" << ms << "\n";
+    }
+    return 0;
+}
+
+static int BenchSearch(int rows) {
+    // Nama Unicode ikut dibuat agar pelipatan huruf/diakritik teruji
+    std::string path = EnsureGeneratedCsv(rows);
+
+    DataModel model;
+    std::cout.setstate(std::ios::badbit);
+    LoadData(model, path);
+    std::cout.clear();
+    size_t n = model.people.size();
+    if (n == 0) return 1;
+
+    SearchIndex index;
+    double buildMs[4] = {};
+    unsigned threadCounts[4] = { 1, 2, 4, 8 };
+    for (int k = 0; k < 4; ++k) {
+        auto t0 = std::chrono::steady_clock::now();
+        index.Build(model, threadCounts[k]);
+        buildMs[k] = ElapsedMs(t0);
+    }
+
+    // Query dari nama sungguhan: potongan 3-8 byte dari tengah nama, dan 1-6 byte awal kata kedua
+    std::mt19937 rng(4242);
+    std::vector<std::string> substrings, prefixes;
+    for (int k = 0; k < 2000; ++k) {
+        std::string name(model.Text(model.people[rng() % n].name));
+        size_t len = std::min(name.size(), (size_t)(3 + rng() % 6));
+        std::string sub = name.substr(rng() % (name.size() - len + 1), len);
+        sub.erase(0, sub.find_first_not_of(' ')); // Find membuang spasi di awal/akhir query
+        sub.erase(sub.find_last_not_of(' ') + 1);
+        if (!sub.empty()) substrings.push_back(sub);
+        size_t space = name.find(' ');
+        std::string word = (space == std::string::npos) ? name : name.substr(space + 1);
+        prefixes.push_back(word.substr(0, std::min(word.size(), (size_t)(1 + rng() % 6))));
+    }
+
+    std::vector<SearchHit> hits;
+    auto timeQueries = [&](const std::vector<std::string>& queries, SearchMode mode, double& avgUs, double& maxUs, size_t& matches) {
+        SearchOptions opt;
+        opt.mode = mode;
+        opt.limit = 20;
+        avgUs = maxUs = 0;
+        matches = 0;
+        for (const std::string& q : queries) {
+            auto t0 = std::chrono::steady_clock::now();
+            matches += index.Find(model, q, opt, hits);
+            double us = ElapsedMs(t0) * 1000;
+            avgUs += us;
+            maxUs = std::max(maxUs, us);
+        }
+        avgUs /= queries.size();
+    };
+    double subAvg, subMax, preAvg, preMax, fullAvg, fullMax;
+    size_t subMatches, preMatches, fullMatches;
+    timeQueries(substrings, SearchMode::Substring, subAvg, subMax, subMatches);
+    timeQueries(prefixes, SearchMode::Prefix, preAvg, preMax, preMatches);
+    // Nama lengkap: pencarian yang paling selektif (data sintetis hanya punya sedikit nama berbeda)
+    std::vector<std::string> fullNames;
+    for (int k = 0; k < 2000; ++k) fullNames.emplace_back(model.Text(model.people[rng() % n].name));
+    timeQueries(fullNames, SearchMode::Prefix, fullAvg, fullMax, fullMatches);
+
+    std::cout << "[BENCH] search people=" << n
+              << " build_ms(1/2/4/8 threads)=" << buildMs[0] << "/" << buildMs[1] << "/" << buildMs[2] << "/" << buildMs[3] << "\n"
+              << "[BENCH] search substring queries=" << substrings.size() << " avg_us=" << subAvg << " max_us=" << subMax
+              << " avg_matches=" << subMatches / substrings.size() << "\n"
+              << "[BENCH] search prefix queries=" << prefixes.size() << " avg_us=" << preAvg << " max_us=" << preMax
+              << " avg_matches=" << preMatches / prefixes.size() << "\n"
+              << "[BENCH] search full_name queries=" << fullNames.size() << " avg_us=" << fullAvg << " max_us=" << fullMax
+              << " avg_matches=" << fullMatches / fullNames.size() << "\n";
+    return 0;
+}
+
+static int BenchGenerate(int rows, int argc, char** argv) {
+    std::string path = "gen_" + std::to_string(rows) + ".csv";
+    GeneratorOptions opt = ParseGeneratorOptions(rows, argc, argv, path);
+    GeneratorStats st;
+    auto t0 = std::chrono::steady_clock::now();
+    if (!GenerateFamilyCsv(path, opt, &st)) {
+        std::cout << "[ERROR] Could not write " << path << "\n";
+        return 1;
+    }
+    PrintGeneratorStats(path, st, ElapsedMs(t0));
+    return 0;
+}
+
+// Hasil satu ukuran data pada bench suite (waktu terbaik dari beberapa ulangan)
+struct SuiteResult {
+    int rows = 0;
+    size_t people = 0;
+    uintmax_t csvBytes = 0;
+    int repeats = 0;
+    double loadMs = 0, widthsMs = 0, positionMs = 0, connectorsMs = 0, sceneMs = 0, paintMs = 0;
+    int paintFrames = 0;
+    int canvasW = 0, canvasH = 0;
+};
+
+// Waktu per tahap untuk satu file: LoadData, lebar sub-pohon, penempatan, garis, grid, dan
+// menggambar layar 1024x768 tanpa jendela (rasterizer ekspor). Layout serial (1 thread) agar
+// tiap tahap terukur terpisah; parsing memakai thread otomatis seperti aplikasi.
+static const char* DetailName(DetailLevel detail) {
+    switch (detail) {
+        case DetailLevel::Full: return "full";
+        case DetailLevel::Plain: return "plain";
+        default: return "blocks";
+    }
+}
+
+static int BenchZoom(int rows) {
+    std::string path = EnsureGeneratedCsv(rows);
+    DataModel model;
+    std::cout.setstate(std::ios::badbit);
+    LoadData(model, path);
+    RecalculateLayout(model);
+    std::cout.clear();
+    if (model.people.empty()) return 1;
+
+    auto t0 = std::chrono::steady_clock::now();
+    SceneIndex scene;
+    BuildSceneIndex(model, scene);
+    double sceneMs = ElapsedMs(t0);
+    t0 = std::chrono::steady_clock::now();
+    std::vector<uint32_t> placed;
+    for (uint32_t i = 0; i < model.people.size(); ++i) if (model.placed[i]) placed.push_back(i);
+    scene.overview.Build(model, placed);
+    double overviewMs = ElapsedMs(t0);
+
+    const int FRAME_W = 1024, FRAME_H = 768;
+    std::vector<uint8_t> rgb;
+    size_t mid = placed[placed.size() / 2];
+    int cx = model.posX[mid], cy = model.posY[mid];
+
+    std::cout << "[BENCH] zoom people=" << model.people.size() << " canvas=" << model.maxX << "x" << model.maxY
+              << " scene_index_ms=" << sceneMs << " overview_ms=" << overviewMs << " levels=" << scene.overview.Levels()
+              << " level0_blocks=" << scene.overview.BlockCount(0) << "\n";
+
+    // Satu layar di tengah orang yang sama untuk skala 1 sampai seluruh pohon terlihat (langkah sqrt 2)
+    double fit = std::min((double)FRAME_W / std::max(1, model.maxX), (double)FRAME_H / std::max(1, model.maxY));
+    for (double scale = 1.0; ; scale /= std::sqrt(2.0)) {
+        if (scale < fit) scale = fit;
+        double left = cx - FRAME_W / 2 / scale, top = cy - FRAME_H / 2 / scale;
+        if (scale == fit) { left = 0; top = 0; }
+        const int reps = 5;
+        size_t drawn = 0;
+        t0 = std::chrono::steady_clock::now();
+        for (int r = 0; r < reps; ++r) drawn = RenderView(model, scene, left, top, scale, FRAME_W, FRAME_H, rgb);
+        double ms = ElapsedMs(t0) / reps;
+        std::cout << "[BENCH] zoom scale=" << scale << " detail=" << DetailName(ChooseDetail(scale))
+                  << " drawn=" << drawn << " frame_ms=" << ms << "\n";
+        if (scale == fit) break;
+    }
+
+    // Geser 200 frame x 16 piksel layar dengan cache tile 256x256: tile baru digambar sekali,
+    // selebihnya hanya disalin
+    for (double scale : { 1.0, 0.25, 1.0 / 64, fit }) {
+        const int TILE = 256, FRAMES = 200, STEP = 16;
+        TileCache<std::vector<uint8_t>> cache(160);
+        std::vector<uint8_t> frame((size_t)FRAME_W * FRAME_H * 3);
+        double startX = std::floor(cx * scale) - FRAME_W / 2, startY = std::floor(cy * scale) - FRAME_H / 2;
+        if (scale == fit) startX = startY = 0;
+        double firstMs = 0, panMs = 0;
+        size_t rendered = 0;
+        for (int f = 0; f <= FRAMES; ++f) {
+            auto tf = std::chrono::steady_clock::now();
+            long long vx = (long long)startX + (long long)f * STEP, vy = (long long)startY;
+            long long tx0 = (vx >= 0 ? vx : vx - TILE + 1) / TILE, ty0 = (vy >= 0 ? vy : vy - TILE + 1) / TILE;
+            for (long long ty = ty0; ty * TILE < vy + FRAME_H; ++ty) {
+                for (long long tx = tx0; tx * TILE < vx + FRAME_W; ++tx) {
+                    bool fresh;
+                    std::vector<uint8_t>& tile = cache.Acquire({ 0, (int)tx, (int)ty }, fresh);
+                    if (fresh) {
+                        RenderView(model, scene, tx * TILE / scale, ty * TILE / scale, scale, TILE, TILE, tile);
+                        rendered++;
+                    }
+                    // Salin bagian tile yang terlihat ke frame
+                    long long x0 = std::max(vx, tx * TILE), x1 = std::min(vx + FRAME_W, (tx + 1) * TILE);
+                    for (long long y = std::max(vy, ty * TILE); y < std::min(vy + FRAME_H, (ty + 1) * TILE); ++y) {
+                        std::memcpy(&frame[((size_t)(y - vy) * FRAME_W + (x0 - vx)) * 3],
+                                    &tile[((size_t)(y - ty * TILE) * TILE + (x0 - tx * TILE)) * 3], (size_t)(x1 - x0) * 3);
+                    }
+                }
+            }
+            double ms = ElapsedMs(tf);
+            if (f == 0) firstMs = ms; else panMs += ms;
+        }
+        std::cout << "[BENCH] zoom pan scale=" << scale << " detail=" << DetailName(ChooseDetail(scale))
+                  << " first_frame_ms=" << firstMs << " pan_frame_ms=" << panMs / FRAMES
+                  << " tiles_rendered=" << rendered << " cache_hits=" << cache.Hits() << "\n";
+    }
+    return 0;
+}
+
+static SuiteResult RunSuiteSize(int rows) {
+    SuiteResult res;
+    res.rows = rows;
+    std::string path = EnsureGeneratedCsv(rows);
+    std::error_code ec;
+    res.csvBytes = std::filesystem::file_size(path, ec);
+
+    const int FRAME_W = 1024, FRAME_H = 768;
+    res.repeats = rows <= 100000 ? 5 : 1;
+    for (int rep = 0; rep < res.repeats; ++rep) {
+        std::cout.setstate(std::ios::badbit);
+        DataModel model;
+        auto t0 = std::chrono::steady_clock::now();
+        LoadData(model, path);
+        double loadMs = ElapsedMs(t0);
+        LayoutStats st = RecalculateLayout(model, 1);
+        t0 = std::chrono::steady_clock::now();
+        SceneIndex scene;
+        BuildSceneIndex(model, scene);
+        double sceneMs = ElapsedMs(t0);
+
+        // Layar di sekitar orang-orang yang tersebar merata di data
+        std::vector<uint8_t> rgb;
+        int frames = 0;
+        t0 = std::chrono::steady_clock::now();
+        size_t step = std::max<size_t>(1, model.people.size() / 32);
+        for (size_t i = 0; i < model.people.size(); i += step) {
+            if (!model.placed[i]) continue;
+            int x = std::max(0, model.posX[i] - FRAME_W / 2), y = std::max(0, model.posY[i] - FRAME_H / 2);
+            RenderArea(model, scene, { x, y, x + FRAME_W, y + FRAME_H }, rgb);
+            frames++;
+        }
+        double paintMs = frames ? ElapsedMs(t0) / frames : 0;
+        std::cout.clear();
+
+        auto best = [&](double& field, double value) { if (rep == 0 || value < field) field = value; };
+        best(res.loadMs, loadMs);
+        best(res.widthsMs, st.widthsMs);
+        best(res.positionMs, st.positionMs);
+        best(res.connectorsMs, st.connectorsMs);
+        best(res.sceneMs, sceneMs);
+        best(res.paintMs, paintMs);
+        res.people = model.people.size();
+        res.paintFrames = frames;
+        res.canvasW = model.maxX;
+        res.canvasH = model.maxY;
+    }
+
+    std::cout << "[BENCH] suite people=" << res.people << " load_ms=" << res.loadMs
+              << " widths_ms=" << res.widthsMs << " position_ms=" << res.positionMs
+              << " connectors_ms=" << res.connectorsMs << " scene_index_ms=" << res.sceneMs
+              << " paint_ms_per_frame=" << res.paintMs << " repeats=" << res.repeats << "\n";
+    return res;
+}
+
+static int BenchSuite(int maxRows, int argc, char** argv) {
+    std::string jsonPath = "bench_results.json";
+    for (int i = 3; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) jsonPath = argv[i + 1];
+    }
+
+    std::vector<SuiteResult> results;
+    for (int rows = 1000; rows <= maxRows && rows <= 10000000; rows *= 10) results.push_back(RunSuiteSize(rows));
+
+    // Satu objek per ukuran data; nama field stabil agar bisa dibandingkan antar commit
+    std::ofstream json(jsonPath);
+    json << "{\n  \"benchmark\": \"suite\",\n  \"version\": 1,\n"
+         << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+         << "  \"layout_threads\": 1,\n  \"results\": [\n";
+    for (size_t k = 0; k < results.size(); ++k) {
+        const SuiteResult& r = results[k];
+        json << "    {\"rows\": " << r.rows << ", \"people\": " << r.people << ", \"csv_bytes\": " << r.csvBytes
+             << ", \"repeats\": " << r.repeats << ", \"load_ms\": " << r.loadMs << ", \"widths_ms\": " << r.widthsMs
+             << ", \"position_ms\": " << r.positionMs << ", \"connectors_ms\": " << r.connectorsMs
+             << ", \"scene_index_ms\": " << r.sceneMs << ", \"paint_frames\": " << r.paintFrames
+             << ", \"paint_ms_per_frame\": " << r.paintMs << ", \"canvas_width\": " << r.canvasW
+             << ", \"canvas_height\": " << r.canvasH << "}" << (k + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    if (!json) {
+        std::cout << "[ERROR] Could not write " << jsonPath << "\n";
+        return 1;
+    }
+    std::cout << "[BENCH] results written to " << jsonPath << "\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " load|threads|layout|reload|cull|chain|snapshot|parallel|collapse|compact|query|kinship|search|zoom|gedcom|validate|generate|suite [rows] [options]\n";
+        return 1;
+    }
+    int rows = (argc > 2) ? std::atoi(argv[2]) : 1000000;
+    if (std::strcmp(argv[1], "load") == 0) return BenchLoad(rows);
+    if (std::strcmp(argv[1], "threads") == 0) return BenchThreads(rows);
+    if (std::strcmp(argv[1], "layout") == 0) return BenchLayout(rows);
+    if (std::strcmp(argv[1], "reload") == 0) return BenchReload(rows);
+    if (std::strcmp(argv[1], "cull") == 0) return BenchCull(rows);
+    if (std::strcmp(argv[1], "chain") == 0) return BenchChain(rows);
+    if (std::strcmp(argv[1], "snapshot") == 0) return BenchSnapshot(rows);
+    if (std::strcmp(argv[1], "parallel") == 0) return BenchParallel(rows);
+    if (std::strcmp(argv[1], "collapse") == 0) return BenchCollapse(rows);
+    if (std::strcmp(argv[1], "compact") == 0) return BenchCompact(rows);
+    if (std::strcmp(argv[1], "query") == 0) return BenchQuery(rows);
+    if (std::strcmp(argv[1], "kinship") == 0) return BenchKinship(rows);
+    if (std::strcmp(argv[1], "search") == 0) return BenchSearch(rows);
+    if (std::strcmp(argv[1], "zoom") == 0) return BenchZoom(rows);
+    if (std::strcmp(argv[1], "gedcom") == 0) return BenchGedcom(rows);
+    if (std::strcmp(argv[1], "validate") == 0) return BenchValidate(rows);
+    if (std::strcmp(argv[1], "generate") == 0) return BenchGenerate(rows, argc, argv);
+    if (std::strcmp(argv[1], "suite") == 0) return BenchSuite((argc > 2) ? rows : 10000000, argc, argv);
+    std::cout << "Unknown benchmark: " << argv[1] << "\n";
+    return 1;
+}
@@ -0,0 +1,399 @@
+// -----------------------------------------------------------------------------
+// CLI DRIVER (Versi command-line tanpa GUI, untuk Linux/server batch)
+// Memuat CSV (atau GEDCOM .ged), menjalankan layout, lalu mencetak koordinat dan waktu proses.
+// -----------------------------------------------------------------------------
+#include <chrono>      // Untuk mengukur durasi tiap tahap
+#include <condition_variable> // Menunggu notifikasi dari FileWatcher (mode --watch)
+#include <cstdlib>     // Untuk atoi pada argumen
+#include <cstring>     // Untuk strcmp pada argumen
+#include <fstream>     // Untuk membaca file pasangan --relate-file
+#include <iostream>    // Untuk output ke console
+#include <mutex>
+#include <sstream>
+
+#include "model.h"
+#include "layout.h"
+#include "file_watcher.h"
+#include "snapshot.h"
+#include "spatial_index.h"
+#include "exporter.h"
+#include "gedcom.h"
+#include "pedigree.h"
+#include "search.h"
+#include "validator.h"
+#include "kinship.h"
+#include "stats.h"
+
+// Menghitung durasi dalam milidetik sejak titik waktu tertentu
+static double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void PrintUsage(const char* exe) {
+    std::cout << "Usage: " << exe << " [--no-coords] [--threads N] [--layout classic|compact] [--snapshot] [--svg out.svg] [--gedcom out.ged] [--png-tiles dir [--tile-size N]]\n"
+              << "       [--relate A B] [--ancestors ID] [--descendants ID] [--max-gen N] [--relate-file F]\n"
+              << "       [--find TEXT [--find-prefix] [--find-case] [--find-accents] [--find-limit N]]\n"
+              << "       [--inbreeding] [--kinship A B] [--kinship-file F] [--kinship-matrix ID,ID,...]\n"
+              << "       [--validate [--validate-limit N]]\n"
+              << "       [--watch] [--poll] [--quiet | --verbose] [--stats-json F] [file.csv]\n"
+              << "  file.csv     File data keluarga (default: Family.csv); file .ged dibaca sebagai GEDCOM\n"
+              << "  --no-coords  Hanya cetak ringkasan dan waktu, tanpa daftar koordinat\n"
+              << "  --threads N  Jumlah thread untuk parsing CSV, layout, dan ekspor PNG (default: otomatis)\n"
+              << "  --layout M   classic (default) atau compact: sub-pohon didekatkan menurut konturnya (canvas lebih sempit)\n"
+              << "  --snapshot   Muat dari file.csv.snap jika masih berlaku, jika tidak parse lalu tulis snapshot\n"
+              << "  --svg F      Ekspor seluruh pohon ke file SVG F\n"
+              << "  --gedcom F   Ekspor data (orang, orang tua, pasangan) ke file GEDCOM 5.5.1 F\n"
+              << "  --png-tiles D  Ekspor seluruh pohon sebagai tile PNG ke folder D (tile_<baris>_<kolom>.png)\n"
+              << "  --tile-size N  Ukuran tile PNG dalam piksel (default: 1024)\n"
+              << "  --relate A B    Cetak hubungan darah/pasangan orang ID A terhadap ID B\n"
+              << "  --ancestors ID  Cetak semua leluhur ID (id,generasi)\n"
+              << "  --descendants ID  Cetak semua keturunan ID (id,generasi)\n"
+              << "  --max-gen N     Batas generasi untuk --ancestors/--descendants (default: tanpa batas)\n"
+              << "  --relate-file F Baris \"A,B\" di file F dijawab sekaligus (paralel) sebagai \"A,B,hubungan\"\n"
+              << "  --find TEXT     Cari nama/peran (tanpa beda huruf besar/kecil dan diakritik), cetak id,nama,peran\n"
+              << "  --find-prefix   Hanya cocok di awal kata (default: di mana saja)\n"
+              << "  --find-case     Bedakan huruf besar/kecil\n"
+              << "  --find-accents  Bedakan huruf berdiakritik (e != é)\n"
+              << "  --find-limit N  Jumlah hasil yang dicetak (default: 50)\n"
+              << "  --inbreeding    Cetak koefisien inbreeding (id,inbreeding) semua orang dengan F > 0\n"
+              << "  --kinship A B   Cetak koefisien kekerabatan ID A dan ID B (A,B,kinship)\n"
+              << "  --kinship-file F  Baris \"A,B\" di file F dijawab sekaligus (paralel) sebagai \"A,B,kinship\"\n"
+              << "  --kinship-matrix L  Matriks kekerabatan untuk daftar ID L (dipisah koma), satu baris CSV per orang\n"
+              << "  --validate   Periksa integritas data (ID ganda, rujukan hilang, pasangan sepihak, siklus, orang tak tergambar)\n"
+              << "               dan cetak line,issue,id,other_id,other_line,count per masalah (exit 2 jika ada masalah)\n"
+              << "  --validate-limit N  Jumlah masalah yang dicetak (default: semua), ringkasan per jenis tetap dicetak\n"
+              << "  --watch      Tetap berjalan dan reload inkremental setiap kali file disimpan\n"
+              << "  --poll       Pakai polling, bukan notifikasi sistem (bersama --watch)\n"
+              << "  --quiet      Hanya cetak error dan hasil (tanpa log per tahap)\n"
+              << "  --verbose    Cetak juga satu baris per orang/akar (lambat untuk file besar)\n"
+              << "  --stats-json F  Tulis waktu per tahap, penghitung, dan alokasi ke file JSON F\n";
+}
+
+// Mode --watch: menunggu notifikasi perubahan file lalu menerapkan reload inkremental
+static int WatchLoop(DataModel& model, const std::string& path, unsigned threads, bool poll, const std::string& statsPath) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool changed = false;
+    std::chrono::steady_clock::time_point notifiedAt;
+
+    FileWatcher watcher;
+    auto backend = poll ? FileWatcher::Backend::Polling : FileWatcher::Backend::Auto;
+    if (!watcher.Start(path, [&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            changed = true;
+            notifiedAt = std::chrono::steady_clock::now();
+            cv.notify_one();
+        }, 50, backend)) {
+        std::cout << "[ERROR] Could not watch " << path << "\n";
+        return 1;
+    }
+    std::cout << "[WATCH] " << path << " (backend: " << watcher.BackendName() << ")\n";
+
+    for (;;) {
+        std::chrono::steady_clock::time_point t0;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return changed; });
+            changed = false;
+            t0 = notifiedAt;
+        }
+
+        ReloadResult r = ReloadData(model, path, threads);
+        if (!r.changed) continue;
+        LayoutStats st = ApplyReload(model, r, threads);
+
+        std::cout << "[RELOAD] added=" << r.added << " removed=" << r.removed << " modified=" << r.modified
+                  << " widths_recomputed=" << st.widthsComputed << " roots_repositioned=" << st.rootsPositioned
+                  << " reload_ms=" << ElapsedMs(t0) << std::endl;
+        if (!statsPath.empty()) WriteStatsJson(statsPath);
+    }
+}
+
+// Pertanyaan silsilah dari argumen (--relate, --ancestors, --descendants, --relate-file, --kinship...)
+struct QueryOptions {
+    std::vector<std::pair<int, int>> relate;
+    int ancestorsOf = 0;
+    int descendantsOf = 0;
+    int maxGenerations = -1;
+    std::string relateFile;
+    std::string find;
+    SearchOptions findOptions;
+    bool inbreeding = false;
+    std::vector<std::pair<int, int>> kinship;
+    std::string kinshipFile;
+    std::vector<int> kinshipMatrix;
+    bool Kinship() const { return inbreeding || !kinship.empty() || !kinshipFile.empty() || !kinshipMatrix.empty(); }
+    bool Pedigree() const { return !relate.empty() || ancestorsOf || descendantsOf || !relateFile.empty() || Kinship(); }
+    bool Any() const { return Pedigree() || !find.empty(); }
+};
+
+// Indeks orang berdasarkan ID, atau mencetak error jika tidak ada
+static bool ResolveId(const DataModel& model, int id, size_t& index) {
+    index = model.IndexOf(id);
+    if (index != IdIndex::NPOS) return true;
+    std::cout << "[ERROR] Unknown ID " << id << "\n";
+    return false;
+}
+
+// Baris "A,B" dari file menjadi pasangan indeks (baris kosong/header dilewati, ID tak dikenal diberi peringatan)
+static bool ReadPairFile(const DataModel& model, const std::string& path, std::vector<std::pair<uint32_t, uint32_t>>& pairs) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cout << "[ERROR] Could not open " << path << "\n";
+        return false;
+    }
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        lineNo++;
+        std::stringstream ss(line);
+        int idA = 0, idB = 0;
+        char comma = 0;
+        if (!(ss >> idA >> comma >> idB) || comma != ',') continue; // Baris kosong/header
+        size_t a = model.IndexOf(idA), b = model.IndexOf(idB);
+        if (a == IdIndex::NPOS || b == IdIndex::NPOS) {
+            std::cout << "[WARNING] " << path << ":" << lineNo << " unknown ID\n";
+            continue;
+        }
+        pairs.push_back({ (uint32_t)a, (uint32_t)b });
+    }
+    return true;
+}
+
+// --find: bangun indeks pencarian lalu cetak hasil terbaik (id,nama,peran)
+static void RunSearch(const DataModel& model, const QueryOptions& q, unsigned threads) {
+    auto t0 = std::chrono::steady_clock::now();
+    SearchIndex index;
+    index.Build(model, threads);
+    double buildMs = ElapsedMs(t0);
+    std::vector<SearchHit> hits;
+    t0 = std::chrono::steady_clock::now();
+    size_t total = index.Find(model, q.find, q.findOptions, hits);
+    double findMs = ElapsedMs(t0);
+    std::cout << "id,name,role\n";
+    for (const SearchHit& h : hits) {
+        const Person& p = model.people[h.index];
+        std::cout << p.id << "," << model.Text(p.name) << "," << model.Text(p.role) << "\n";
+    }
+    if (LogEnabled(LogLevel::Info)) {
+        std::cout << "[SEARCH] matches=" << total << " shown=" << hits.size() << " build_ms=" << buildMs
+                  << " find_us=" << findMs * 1000 << "\n";
+    }
+}
+
+// --inbreeding, --kinship, --kinship-file, --kinship-matrix (F semua orang dihitung dulu)
+static int RunKinship(const DataModel& model, const PedigreeIndex& pedigree, const QueryOptions& q, unsigned threads) {
+    KinshipIndex kinship;
+    kinship.Build(pedigree, threads);
+    const KinshipStats& st = kinship.Stats();
+    if (LogEnabled(LogLevel::Info)) {
+        std::cout << "[KINSHIP] people=" << st.people << " both_parents=" << st.bothParents << " inbred=" << st.inbred
+                  << " mean_f=" << st.meanInbreeding << " max_f=" << st.maxInbreeding
+                  << " pairs_computed=" << st.pairsComputed << " build_ms=" << st.ms << "\n";
+    }
+
+    if (q.inbreeding) {
+        std::cout << "id,inbreeding\n";
+        for (size_t i = 0; i < kinship.Size(); ++i) {
+            if (kinship.Inbreeding(i) > 0) std::cout << model.people[i].id << "," << kinship.Inbreeding(i) << "\n";
+        }
+    }
+    for (const auto& pair : q.kinship) {
+        size_t a, b;
+        if (!ResolveId(model, pair.first, a) || !ResolveId(model, pair.second, b)) return 1;
+        std::cout << pair.first << "," << pair.second << "," << kinship.Kinship(a, b) << "\n";
+    }
+    if (!q.kinshipFile.empty()) {
+        std::vector<std::pair<uint32_t, uint32_t>> pairs;
+        if (!ReadPairFile(model, q.kinshipFile, pairs)) return 1;
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<double> out;
+        kinship.KinshipBatch(pairs, out, threads);
+        double batchMs = ElapsedMs(t0);
+        for (size_t k = 0; k < pairs.size(); ++k) {
+            std::cout << model.people[pairs[k].first].id << "," << model.people[pairs[k].second].id << "," << out[k] << "\n";
+        }
+        if (LogEnabled(LogLevel::Info)) {
+            std::cout << "[KINSHIP] pairs=" << pairs.size() << " batch_ms=" << batchMs << "\n";
+        }
+    }
+    if (!q.kinshipMatrix.empty()) {
+        std::vector<uint32_t> people;
+        for (int id : q.kinshipMatrix) {
+            size_t index;
+            if (!ResolveId(model, id, index)) return 1;
+            people.push_back((uint32_t)index);
+        }
+        std::vector<double> matrix;
+        kinship.KinshipMatrix(people, matrix, threads);
+        size_t k = people.size();
+        std::cout << "id";
+        for (int id : q.kinshipMatrix) std::cout << "," << id;
+        std::cout << "\n";
+        for (size_t i = 0; i < k; ++i) {
+            std::cout << q.kinshipMatrix[i];
+            for (size_t j = 0; j < k; ++j) std::cout << "," << matrix[i * k + j];
+            std::cout << "\n";
+        }
+    }
+    return 0;
+}
+
+static int RunQueries(const DataModel& model, const QueryOptions& q, unsigned threads) {
+    if (!q.find.empty()) RunSearch(model, q, threads);
+    if (!q.Pedigree()) return 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    PedigreeIndex pedigree;
+    pedigree.Build(model, threads);
+    if (LogEnabled(LogLevel::Info)) {
+        std::cout << "[PEDIGREE] people=" << pedigree.Size() << " cycles_cut=" << pedigree.CyclesCut()
+                  << " build_ms=" << ElapsedMs(t0) << "\n";
+    }
+
+    for (const auto& pair : q.relate) {
+        size_t a, b;
+        if (!ResolveId(model, pair.first, a) || !ResolveId(model, pair.second, b)) return 1;
+        std::cout << pair.first << "," << pair.second << "," << DescribeRelationship(model, pedigree, a, b) << "\n";
+    }
+    auto printRelatives = [&](const char* header, int id, bool ancestors) {
+        size_t index;
+        if (!ResolveId(model, id, index)) return false;
+        auto list = ancestors ? pedigree.Ancestors(index, q.maxGenerations) : pedigree.Descendants(index, q.maxGenerations);
+        std::cout << header << "\n";
+        for (const Relative& r : list) std::cout << model.people[r.index].id << "," << r.generations << "\n";
+        return true;
+    };
+    if (q.ancestorsOf && !printRelatives("id,generations_up", q.ancestorsOf, true)) return 1;
+    if (q.descendantsOf && !printRelatives("id,generations_down", q.descendantsOf, false)) return 1;
+
+    if (!q.relateFile.empty()) {
+        std::vector<std::pair<uint32_t, uint32_t>> pairs;
+        if (!ReadPairFile(model, q.relateFile, pairs)) return 1;
+        t0 = std::chrono::steady_clock::now();
+        std::vector<Relationship> out;
+        pedigree.RelateBatch(pairs, out, threads);
+        double batchMs = ElapsedMs(t0);
+        for (size_t k = 0; k < pairs.size(); ++k) {
+            const Person& pa = model.people[pairs[k].first];
+            std::cout << pa.id << "," << model.people[pairs[k].second].id << "," << RelationshipName(out[k], pa.gender) << "\n";
+        }
+        if (LogEnabled(LogLevel::Info)) {
+            std::cout << "[QUERY] pairs=" << pairs.size() << " batch_ms=" << batchMs << "\n";
+        }
+    }
+    return q.Kinship() ? RunKinship(model, pedigree, q, threads) : 0;
+}
+
+int main(int argc, char** argv) {
+    std::string path = "Family.csv";
+    bool printCoords = true;
+    unsigned threads = 0;
+    bool watch = false;
+    bool poll = false;
+    bool useSnapshot = false;
+    std::string svgPath, gedcomPath, tileDir, statsPath;
+    int tileSize = 1024;
+    QueryOptions queries;
+    LayoutMode layoutMode = LayoutMode::Classic;
+    bool validate = false;
+    size_t validateLimit = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--no-coords") == 0) printCoords = false;
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = (unsigned)std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--layout") == 0 && i + 1 < argc) {
+            if (!ParseLayoutMode(argv[++i], layoutMode)) { std::cout << "[ERROR] Unknown layout mode " << argv[i] << "\n"; return 1; }
+        }
+        else if (std::strcmp(argv[i], "--validate") == 0) validate = true;
+        else if (std::strcmp(argv[i], "--validate-limit") == 0 && i + 1 < argc) validateLimit = (size_t)std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--watch") == 0) watch = true;
+        else if (std::strcmp(argv[i], "--poll") == 0) poll = true;
+        else if (std::strcmp(argv[i], "--snapshot") == 0) useSnapshot = true;
+        else if (std::strcmp(argv[i], "--svg") == 0 && i + 1 < argc) svgPath = argv[++i];
+        else if (std::strcmp(argv[i], "--gedcom") == 0 && i + 1 < argc) gedcomPath = argv[++i];
+        else if (std::strcmp(argv[i], "--png-tiles") == 0 && i + 1 < argc) tileDir = argv[++i];
+        else if (std::strcmp(argv[i], "--tile-size") == 0 && i + 1 < argc) tileSize = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--relate") == 0 && i + 2 < argc) {
+            int a = std::atoi(argv[++i]);
+            queries.relate.push_back({ a, std::atoi(argv[++i]) });
+        }
+        else if (std::strcmp(argv[i], "--ancestors") == 0 && i + 1 < argc) queries.ancestorsOf = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--descendants") == 0 && i + 1 < argc) queries.descendantsOf = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--max-gen") == 0 && i + 1 < argc) queries.maxGenerations = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--relate-file") == 0 && i + 1 < argc) queries.relateFile = argv[++i];
+        else if (std::strcmp(argv[i], "--inbreeding") == 0) queries.inbreeding = true;
+        else if (std::strcmp(argv[i], "--kinship") == 0 && i + 2 < argc) {
+            int a = std::atoi(argv[++i]);
+            queries.kinship.push_back({ a, std::atoi(argv[++i]) });
+        }
+        else if (std::strcmp(argv[i], "--kinship-file") == 0 && i + 1 < argc) queries.kinshipFile = argv[++i];
+        else if (std::strcmp(argv[i], "--kinship-matrix") == 0 && i + 1 < argc) {
+            std::stringstream ss(argv[++i]);
+            std::string item;
+            while (std::getline(ss, item, ',')) if (!item.empty()) queries.kinshipMatrix.push_back(std::atoi(item.c_str()));
+        }
+        else if (std::strcmp(argv[i], "--find") == 0 && i + 1 < argc) queries.find = argv[++i];
+        else if (std::strcmp(argv[i], "--find-prefix") == 0) queries.findOptions.mode = SearchMode::Prefix;
+        else if (std::strcmp(argv[i], "--find-case") == 0) queries.findOptions.ignoreCase = false;
+        else if (std::strcmp(argv[i], "--find-accents") == 0) queries.findOptions.ignoreDiacritics = false;
+        else if (std::strcmp(argv[i], "--find-limit") == 0 && i + 1 < argc) queries.findOptions.limit = (size_t)std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--quiet") == 0) SetLogLevel(LogLevel::Quiet);
+        else if (std::strcmp(argv[i], "--verbose") == 0) SetLogLevel(LogLevel::Verbose);
+        else if (std::strcmp(argv[i], "--stats-json") == 0 && i + 1 < argc) statsPath = argv[++i];
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) { PrintUsage(argv[0]); return 0; }
+        else path = argv[i];
+    }
+
+    DataModel model;
+    model.layoutMode = layoutMode; // Sebelum snapshot dimuat: layout dengan mode lain tidak dipakai
+
+    auto t0 = std::chrono::steady_clock::now();
+    bool hasLayout = false;
+    bool fromSnapshot = useSnapshot && LoadSnapshot(model, path, hasLayout);
+    if (!fromSnapshot && !LoadData(model, path, threads)) return 1;
+    double loadMs = ElapsedMs(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    if (!hasLayout) RecalculateLayout(model, threads);
+    double layoutMs = ElapsedMs(t0);
+
+    if (useSnapshot && !fromSnapshot) SaveSnapshot(model, path);
+
+    if (printCoords) {
+        std::cout << "id,x,y,subtreeWidth\n";
+        for (size_t i = 0; i < model.people.size(); ++i) {
+            if (!model.placed[i]) continue;
+            std::cout << model.people[i].id << "," << model.posX[i] << "," << model.posY[i] << "," << model.subtreeWidth[i] << "\n";
+        }
+    }
+
+    std::cout << "[TIME] people=" << model.people.size()
+              << " load_ms=" << loadMs
+              << " layout_ms=" << layoutMs
+              << " canvas=" << model.maxX << "x" << model.maxY << "\n";
+
+    bool invalid = false;
+    if (validate) {
+        ValidationReport report = ValidateModel(model, threads);
+        PrintValidationReport(model, report, std::cout, validateLimit);
+        invalid = !report.Ok();
+    }
+
+    if (queries.Any() && RunQueries(model, queries, threads) != 0) return 1;
+
+    if (!svgPath.empty() && !ExportSvg(model, svgPath)) return 1;
+    if (!gedcomPath.empty() && !ExportGedcom(model, gedcomPath)) return 1;
+    if (!tileDir.empty()) {
+        SceneIndex scene;
+        BuildSceneIndex(model, scene);
+        if (!ExportPngTiles(model, scene, tileDir, tileSize, threads)) return 1;
+    }
+
+    if (!statsPath.empty() && !WriteStatsJson(statsPath)) {
+        std::cout << "[ERROR] Could not write " << statsPath << "\n";
+        return 1;
+    }
+    if (watch) return WatchLoop(model, path, threads, poll, statsPath);
+    return invalid ? 2 : 0;
+}
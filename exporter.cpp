@@ -0,0 +1,609 @@
+#include "exporter.h"
+#include "layout.h"
+#include "parallel.h"
+#include "stats.h"
+
+#include <algorithm>   // std::min/std::max untuk clipping
+#include <atomic>      // Pembagian tile antar thread
+#include <chrono>      // Untuk mengukur durasi ekspor
+#include <cmath>       // Pembulatan koordinat zoom
+#include <cstdlib>     // std::abs untuk arah garis
+#include <cstring>     // std::memcpy ke buffer PNG
+#include <filesystem>  // Membuat folder tujuan tile
+#include <fstream>     // Menulis file SVG/PNG
+#include <iostream>    // Untuk output ke console
+#include <thread>      // Thread penggambar tile
+
+// Warna sama dengan konfigurasi visual di main.cpp
+struct Color { uint8_t r, g, b; };
+static const Color COL_CANVAS = { 242, 242, 235 };
+static const Color COL_BOX_FEM = { 245, 144, 144 };
+static const Color COL_BOX_MALE = { 123, 157, 201 };
+static const Color COL_SHADOW = { 220, 220, 220 };
+static const Color COL_BLACK = { 0, 0, 0 };
+
+static const int SHADOW_OFFSET = 4; // Bayangan kotak digeser 4 piksel (sama dengan DrawBox)
+static const int DOT_LENGTH = 3;    // Pola garis mantan pasangan: 3 piksel nyala, 3 piksel mati
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// -----------------------------------------------------------------------------
+// SVG (Streaming: garis dulu lalu kotak, ditulis langsung ke file)
+// -----------------------------------------------------------------------------
+
+static void WriteEscaped(std::ostream& out, std::string_view text) {
+    for (char c : text) {
+        switch (c) {
+            case '&': out << "&amp;"; break;
+            case '<': out << "&lt;"; break;
+            case '>': out << "&gt;"; break;
+            case '"': out << "&quot;"; break;
+            default: out << c; break;
+        }
+    }
+}
+
+// Garis ditulis sebagai beberapa <path> (maksimal 1000 segmen per path) agar baris tidak terlalu panjang
+static void WriteSvgLines(std::ostream& out, const DataModel& model, bool dotted) {
+    const size_t PER_PATH = 1000;
+    size_t inPath = 0;
+    for (const LineSegment& s : model.segments) {
+        if (s.dotted != dotted) continue;
+        if (inPath == 0) out << "<path" << (dotted ? " class=\"ex\"" : "") << " d=\"";
+        out << 'M' << s.x1 << ' ' << s.y1 << 'L' << s.x2 << ' ' << s.y2;
+        if (++inPath == PER_PATH) { out << "\"/>\n"; inPath = 0; }
+    }
+    if (inPath) out << "\"/>\n";
+}
+
+bool ExportSvg(const DataModel& model, const std::string& path) {
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<char> buffer(1 << 20);
+    std::ofstream out;
+    out.rdbuf()->pubsetbuf(buffer.data(), (std::streamsize)buffer.size());
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cout << "[ERROR] Could not write " << path << "\n";
+        return false;
+    }
+
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << model.maxX << "\" height=\"" << model.maxY
+        << "\" viewBox=\"0 0 " << model.maxX << ' ' << model.maxY << "\">\n"
+        << "<style>"
+        << "path{fill:none;stroke:#000;stroke-width:1}path.ex{stroke-dasharray:" << DOT_LENGTH << "," << DOT_LENGTH << "}"
+        << ".s{fill:#dcdcdc}.b{stroke:#000;stroke-width:1}.m{fill:#7b9dc9}.f{fill:#f59090}"
+        << "text{text-anchor:middle;dominant-baseline:central;font-family:'Segoe UI',sans-serif}"
+        << ".n{font-weight:bold;font-size:16px}.r{font-size:14px}"
+        << "</style>\n"
+        << "<rect width=\"100%\" height=\"100%\" fill=\"#f2f2eb\"/>\n";
+
+    // Setengah piksel: garis 1 piksel jatuh tepat di piksel yang sama dengan GDI
+    out << "<g transform=\"translate(0.5,0.5)\">\n";
+    WriteSvgLines(out, model, false);
+    WriteSvgLines(out, model, true);
+    out << "</g>\n";
+
+    // Tiap kotak adalah <svg> bersarang: teks yang terlalu panjang terpotong di tepi kotak
+    size_t boxes = 0;
+    for (size_t i = 0; i < model.people.size(); ++i) {
+        if (!model.placed[i]) continue;
+        const Person& p = model.people[i];
+        int x = model.posX[i], y = model.posY[i];
+        out << "<rect class=\"s\" x=\"" << x + SHADOW_OFFSET << "\" y=\"" << y + SHADOW_OFFSET
+            << "\" width=\"" << BOX_WIDTH << "\" height=\"" << BOX_HEIGHT << "\"/>"
+            << "<svg x=\"" << x << "\" y=\"" << y << "\" width=\"" << BOX_WIDTH << "\" height=\"" << BOX_HEIGHT << "\">"
+            << "<rect class=\"b " << (p.gender == Gender::Female ? 'f' : 'm')
+            << "\" x=\"0.5\" y=\"0.5\" width=\"" << BOX_WIDTH - 1 << "\" height=\"" << BOX_HEIGHT - 1 << "\"/>"
+            << "<text class=\"n\" x=\"" << BOX_WIDTH / 2 << "\" y=\"" << BOX_HEIGHT / 4 << "\">";
+        WriteEscaped(out, model.Text(p.name));
+        out << "</text><text class=\"r\" x=\"" << BOX_WIDTH / 2 << "\" y=\"" << BOX_HEIGHT * 3 / 4 << "\">";
+        WriteEscaped(out, model.Text(p.role));
+        out << "</text></svg>\n";
+        boxes++;
+    }
+    out << "</svg>\n";
+    out.close();
+    if (!out) {
+        std::cout << "[ERROR] Could not write " << path << "\n";
+        return false;
+    }
+
+    if (LogEnabled(LogLevel::Info)) std::cout << "[EXPORT] svg=" << path << " boxes=" << boxes << " segments=" << model.segments.size()
+              << " canvas=" << model.maxX << "x" << model.maxY << " ms=" << ElapsedMs(t0) << "\n";
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// RASTERIZER (Menggambar satu tile RGB di memori)
+// -----------------------------------------------------------------------------
+
+// Font bitmap 5x7 untuk ASCII 0x20..0x7E; tiap byte satu kolom, bit 0 = baris paling atas
+static const uint8_t FONT_5X7[95][5] = {
+    {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14},
+    {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, {0x36,0x49,0x55,0x22,0x50}, {0x00,0x05,0x03,0x00,0x00},
+    {0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, {0x14,0x08,0x3E,0x08,0x14}, {0x08,0x08,0x3E,0x08,0x08},
+    {0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x60,0x60,0x00,0x00}, {0x20,0x10,0x08,0x04,0x02},
+    {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31},
+    {0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03},
+    {0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, {0x00,0x36,0x36,0x00,0x00}, {0x00,0x56,0x36,0x00,0x00},
+    {0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14}, {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06},
+    {0x32,0x49,0x79,0x41,0x3E}, {0x7E,0x11,0x11,0x11,0x7E}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22},
+    {0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01}, {0x3E,0x41,0x49,0x49,0x7A},
+    {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41},
+    {0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x0C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E},
+    {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, {0x46,0x49,0x49,0x49,0x31},
+    {0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F}, {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F},
+    {0x63,0x14,0x08,0x14,0x63}, {0x07,0x08,0x70,0x08,0x07}, {0x61,0x51,0x49,0x45,0x43}, {0x00,0x7F,0x41,0x41,0x00},
+    {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40},
+    {0x00,0x01,0x02,0x04,0x00}, {0x20,0x54,0x54,0x54,0x78}, {0x7F,0x48,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x20},
+    {0x38,0x44,0x44,0x48,0x7F}, {0x38,0x54,0x54,0x54,0x18}, {0x08,0x7E,0x09,0x01,0x02}, {0x0C,0x52,0x52,0x52,0x3E},
+    {0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x44,0x3D,0x00}, {0x7F,0x10,0x28,0x44,0x00},
+    {0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x18,0x04,0x78}, {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38},
+    {0x7C,0x14,0x14,0x14,0x08}, {0x08,0x14,0x14,0x18,0x7C}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x20},
+    {0x04,0x3F,0x44,0x40,0x20}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C}, {0x3C,0x40,0x30,0x40,0x3C},
+    {0x44,0x28,0x10,0x28,0x44}, {0x0C,0x50,0x50,0x50,0x3C}, {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00},
+    {0x00,0x00,0x7F,0x00,0x00}, {0x00,0x41,0x36,0x08,0x00}, {0x08,0x04,0x08,0x10,0x08},
+};
+static const int GLYPH_ADVANCE = 6; // 5 kolom + 1 kolom jarak
+static const int GLYPH_HEIGHT = 7;
+
+// Satu tile canvas: piksel RGB untuk area [x0, x0+w) x [y0, y0+h) dalam koordinat canvas
+struct TileCanvas {
+    int x0 = 0, y0 = 0, w = 0, h = 0;
+    std::vector<uint8_t> rgb;
+
+    void Reset(int x, int y, int width, int height) {
+        x0 = x; y0 = y; w = width; h = height;
+        rgb.resize((size_t)w * h * 3);
+    }
+
+    void Pixel(int x, int y, Color c) {
+        x -= x0; y -= y0;
+        if (x < 0 || y < 0 || x >= w || y >= h) return;
+        uint8_t* p = &rgb[((size_t)y * w + x) * 3];
+        p[0] = c.r; p[1] = c.g; p[2] = c.b;
+    }
+
+    // Mengisi rect (right/bottom eksklusif, seperti FillRect) setelah dipotong ke tile
+    void Fill(int left, int top, int right, int bottom, Color c) {
+        left = std::max(left - x0, 0); right = std::min(right - x0, w);
+        top = std::max(top - y0, 0); bottom = std::min(bottom - y0, h);
+        for (int y = top; y < bottom; ++y) {
+            uint8_t* p = &rgb[((size_t)y * w + left) * 3];
+            for (int x = left; x < right; ++x, p += 3) { p[0] = c.r; p[1] = c.g; p[2] = c.b; }
+        }
+    }
+};
+
+// Garis 1 piksel seperti LineTo: titik akhir tidak ikut digambar. Garis horizontal/vertikal
+// (hampir semua garis silsilah) langsung dipotong ke tile, selebihnya memakai Bresenham.
+static void DrawSegment(TileCanvas& tile, const LineSegment& s) {
+    int dx = s.x2 - s.x1, dy = s.y2 - s.y1;
+    int steps = std::max(std::abs(dx), std::abs(dy));
+    if (steps == 0) return;
+    auto on = [&](int t) { return !s.dotted || (t / DOT_LENGTH) % 2 == 0; };
+
+    if (dx == 0 || dy == 0) {
+        int sx = (dx > 0) - (dx < 0), sy = (dy > 0) - (dy < 0);
+        // Rentang t yang jatuh di dalam tile (sumbu yang bergerak saja)
+        int pos = sx ? s.x1 : s.y1, dir = sx ? sx : sy;
+        int lo = sx ? tile.x0 : tile.y0, hi = lo + (sx ? tile.w : tile.h) - 1;
+        int fixed = sx ? s.y1 : s.x1, fixedLo = sx ? tile.y0 : tile.x0, fixedHi = fixedLo + (sx ? tile.h : tile.w);
+        if (fixed < fixedLo || fixed >= fixedHi) return;
+        int t0 = dir > 0 ? lo - pos : pos - hi;
+        int t1 = dir > 0 ? hi - pos : pos - lo;
+        t0 = std::max(t0, 0);
+        t1 = std::min(t1, steps - 1);
+        for (int t = t0; t <= t1; ++t) {
+            if (!on(t)) continue;
+            if (sx) tile.Pixel(s.x1 + t * sx, s.y1, COL_BLACK);
+            else tile.Pixel(s.x1, s.y1 + t * sy, COL_BLACK);
+        }
+        return;
+    }
+
+    int ax = std::abs(dx), ay = -std::abs(dy);
+    int sx = dx > 0 ? 1 : -1, sy = dy > 0 ? 1 : -1;
+    int err = ax + ay, x = s.x1, y = s.y1;
+    for (int t = 0; t < steps; ++t) {
+        if (on(t)) tile.Pixel(x, y, COL_BLACK);
+        int e2 = 2 * err;
+        if (e2 >= ay) { err += ay; x += sx; }
+        if (e2 <= ax) { err += ax; y += sy; }
+    }
+}
+
+// Menulis teks di tengah rect dan terpotong di tepinya (seperti DrawCenteredText + ETO_CLIPPED).
+// Tebal digambar dua kali dengan geser 1 piksel.
+static void DrawCenteredText(TileCanvas& tile, int left, int top, int right, int bottom, std::string_view text, bool bold) {
+    int chars = 0;
+    for (char c : text) if (((unsigned char)c & 0xC0) != 0x80) chars++; // Hitung code point UTF-8
+    if (chars == 0) return;
+    int width = chars * GLYPH_ADVANCE - 1 + (bold ? 1 : 0);
+    int x = left + ((right - left) - width) / 2;
+    int y = top + ((bottom - top) - GLYPH_HEIGHT) / 2;
+    // Lewati jika teks sama sekali tidak menyentuh tile
+    if (x >= tile.x0 + tile.w || y >= tile.y0 + tile.h || x + width <= tile.x0 || y + GLYPH_HEIGHT <= tile.y0) return;
+
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = (unsigned char)text[i];
+        if ((c & 0xC0) == 0x80) continue; // Byte lanjutan UTF-8
+        const uint8_t* glyph = FONT_5X7[(c >= 0x20 && c < 0x7F) ? c - 0x20 : '?' - 0x20];
+        for (int col = 0; col < 5; ++col) {
+            for (int row = 0; row < GLYPH_HEIGHT; ++row) {
+                if (!(glyph[col] & (1 << row))) continue;
+                for (int b = 0; b <= (bold ? 1 : 0); ++b) {
+                    int px = x + col + b, py = y + row;
+                    if (px >= left && px < right && py >= top && py < bottom) tile.Pixel(px, py, COL_BLACK);
+                }
+            }
+        }
+        x += GLYPH_ADVANCE;
+    }
+}
+
+// Sama dengan DrawBox: bayangan, isi sesuai jenis kelamin, bingkai hitam, nama (tebal) dan peran
+static void DrawBox(TileCanvas& tile, const DataModel& model, size_t index) {
+    if (!model.placed[index]) return;
+    int x = model.posX[index], y = model.posY[index];
+    int right = x + BOX_WIDTH, bottom = y + BOX_HEIGHT;
+
+    tile.Fill(x + SHADOW_OFFSET, y + SHADOW_OFFSET, right + SHADOW_OFFSET, bottom + SHADOW_OFFSET, COL_SHADOW);
+    const Person& p = model.people[index];
+    tile.Fill(x, y, right, bottom, p.gender == Gender::Female ? COL_BOX_FEM : COL_BOX_MALE);
+
+    tile.Fill(x, y, right, y + 1, COL_BLACK);
+    tile.Fill(x, bottom - 1, right, bottom, COL_BLACK);
+    tile.Fill(x, y, x + 1, bottom, COL_BLACK);
+    tile.Fill(right - 1, y, right, bottom, COL_BLACK);
+
+    DrawCenteredText(tile, x, y, right, bottom - BOX_HEIGHT / 2, model.Text(p.name), true);
+    DrawCenteredText(tile, x, y + BOX_HEIGHT / 2, right, bottom, model.Text(p.role), false);
+}
+
+// -----------------------------------------------------------------------------
+// PNG (Encoder kecil tanpa library: deflate dengan kode Huffman tetap + LZ77 sederhana)
+// -----------------------------------------------------------------------------
+
+static uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    static const auto table = [] {
+        std::vector<uint32_t> t(256);
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[n] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static uint32_t Adler32(const uint8_t* data, size_t size) {
+    uint32_t a = 1, b = 0;
+    while (size > 0) {
+        size_t n = std::min(size, (size_t)5552); // Batas agar penjumlahan tidak overflow sebelum modulo
+        for (size_t i = 0; i < n; ++i) { a += data[i]; b += a; }
+        a %= 65521; b %= 65521;
+        data += n; size -= n;
+    }
+    return (b << 16) | a;
+}
+
+// Penulis bit deflate: nilai biasa LSB dulu, kode Huffman MSB dulu
+struct BitWriter {
+    std::vector<uint8_t>& out;
+    uint64_t acc = 0;
+    int bits = 0;
+
+    explicit BitWriter(std::vector<uint8_t>& o) : out(o) {}
+    void Put(uint32_t value, int count) {
+        acc |= (uint64_t)value << bits;
+        bits += count;
+        while (bits >= 8) { out.push_back((uint8_t)acc); acc >>= 8; bits -= 8; }
+    }
+    void PutCode(uint32_t code, int count) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < count; ++i) reversed |= ((code >> i) & 1) << (count - 1 - i);
+        Put(reversed, count);
+    }
+    void Flush() {
+        if (bits) out.push_back((uint8_t)acc);
+        acc = 0; bits = 0;
+    }
+};
+
+static const uint16_t LENGTH_BASE[29] = { 3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258 };
+static const uint8_t LENGTH_EXTRA[29] = { 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0 };
+static const uint16_t DIST_BASE[30] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577 };
+static const uint8_t DIST_EXTRA[30] = { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13 };
+
+// Kode Huffman tetap (RFC 1951 3.2.6) untuk simbol literal/panjang
+static void PutSymbol(BitWriter& bw, int sym) {
+    if (sym < 144) bw.PutCode(0x30 + sym, 8);
+    else if (sym < 256) bw.PutCode(0x190 + (sym - 144), 9);
+    else if (sym < 280) bw.PutCode(sym - 256, 7);
+    else bw.PutCode(0xC0 + (sym - 280), 8);
+}
+
+// Buffer encoder per thread (dipakai ulang untuk setiap tile)
+struct PngEncoder {
+    static constexpr int WINDOW = 32768;
+    static constexpr int HASH_SIZE = 1 << 15;
+    static constexpr int MAX_CHAIN = 16;
+    static constexpr int GOOD_MATCH = 32; // Kecocokan sepanjang ini tidak perlu dicari lewat hash
+
+    std::vector<uint8_t> raw;   // Baris PNG: byte filter (0) + piksel RGB
+    std::vector<uint8_t> zlib;  // Data IDAT
+    std::vector<uint8_t> png;   // File PNG lengkap
+    std::vector<int> head, prev;
+
+    // Stream zlib satu blok deflate (Huffman tetap). Gambar silsilah didominasi bidang warna
+    // rata, jadi kandidat pertama adalah baris di atasnya dan piksel sebelumnya; rantai hash
+    // hanya dipakai jika keduanya tidak menghasilkan kecocokan panjang.
+    void Compress(int rowBytes) {
+        zlib.clear();
+        zlib.push_back(0x78); zlib.push_back(0x01);
+        BitWriter bw(zlib);
+        bw.Put(1, 1); // BFINAL
+        bw.Put(1, 2); // BTYPE = Huffman tetap
+
+        head.assign(HASH_SIZE, -1);
+        prev.assign(WINDOW, -1);
+        const uint8_t* d = raw.data();
+        int n = (int)raw.size();
+        auto hash = [&](int i) { return ((d[i] << 10) ^ (d[i + 1] << 5) ^ d[i + 2]) & (HASH_SIZE - 1); };
+        auto insert = [&](int i) {
+            if (i + 2 >= n) return;
+            int h = hash(i);
+            prev[i & (WINDOW - 1)] = head[h];
+            head[h] = i;
+        };
+
+        int i = 0;
+        while (i < n) {
+            int bestLen = 0, bestDist = 0;
+            int maxLen = std::min(258, n - i);
+            auto tryDist = [&](int dist) {
+                if (dist <= 0 || dist > i || dist > WINDOW) return;
+                int len = 0;
+                while (len < maxLen && d[i - dist + len] == d[i + len]) len++;
+                if (len > bestLen) { bestLen = len; bestDist = dist; }
+            };
+            tryDist(rowBytes);
+            if (bestLen < maxLen) tryDist(3);
+            if (bestLen < GOOD_MATCH && i + 2 < n) {
+                int cand = head[hash(i)];
+                for (int chain = 0; cand >= 0 && i - cand <= WINDOW && chain < MAX_CHAIN; ++chain) {
+                    tryDist(i - cand);
+                    if (bestLen == maxLen) break;
+                    cand = prev[cand & (WINDOW - 1)];
+                }
+            }
+            if (bestLen >= 3) {
+                int li = 28;
+                while (LENGTH_BASE[li] > bestLen) li--;
+                PutSymbol(bw, 257 + li);
+                bw.Put(bestLen - LENGTH_BASE[li], LENGTH_EXTRA[li]);
+                int di = 29;
+                while (DIST_BASE[di] > bestDist) di--;
+                bw.PutCode(di, 5);
+                bw.Put(bestDist - DIST_BASE[di], DIST_EXTRA[di]);
+                // Kecocokan panjang (bidang rata) cukup dicatat awalnya saja
+                if (bestLen < GOOD_MATCH) for (int k = 0; k < bestLen; ++k) insert(i + k);
+                else insert(i);
+                i += bestLen;
+            } else {
+                PutSymbol(bw, d[i]);
+                insert(i);
+                i++;
+            }
+        }
+        PutSymbol(bw, 256); // Akhir blok
+        bw.Flush();
+        uint32_t adler = Adler32(raw.data(), raw.size());
+        for (int s = 24; s >= 0; s -= 8) zlib.push_back((uint8_t)(adler >> s));
+    }
+
+    // Mengisi png dengan file PNG (RGB 8 bit) dari isi tile
+    void Encode(const TileCanvas& tile) {
+        size_t stride = (size_t)tile.w * 3;
+        raw.resize((stride + 1) * tile.h);
+        for (int y = 0; y < tile.h; ++y) {
+            raw[y * (stride + 1)] = 0; // Filter "None"
+            std::memcpy(&raw[y * (stride + 1) + 1], &tile.rgb[y * stride], stride);
+        }
+        Compress((int)stride + 1);
+
+        static const uint8_t SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        png.assign(SIGNATURE, SIGNATURE + 8);
+        auto put32 = [&](uint32_t v) { for (int s = 24; s >= 0; s -= 8) png.push_back((uint8_t)(v >> s)); };
+        auto chunk = [&](const char* type, const uint8_t* data, size_t size) {
+            put32((uint32_t)size);
+            png.insert(png.end(), type, type + 4);
+            if (size) png.insert(png.end(), data, data + size);
+            put32(Crc32(data, size, Crc32((const uint8_t*)type, 4)));
+        };
+        uint8_t ihdr[13] = {
+            (uint8_t)(tile.w >> 24), (uint8_t)(tile.w >> 16), (uint8_t)(tile.w >> 8), (uint8_t)tile.w,
+            (uint8_t)(tile.h >> 24), (uint8_t)(tile.h >> 16), (uint8_t)(tile.h >> 8), (uint8_t)tile.h,
+            8, 2, 0, 0, 0 // 8 bit per kanal, RGB, tanpa interlace
+        };
+        chunk("IHDR", ihdr, sizeof(ihdr));
+        chunk("IDAT", zlib.data(), zlib.size());
+        chunk("IEND", nullptr, 0);
+    }
+};
+
+static bool WriteFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+    return (bool)out;
+}
+
+// -----------------------------------------------------------------------------
+// TILE PNG (Paralel: setiap thread mengambil tile berikutnya sampai habis)
+// -----------------------------------------------------------------------------
+
+// Menggambar satu area canvas: latar, garis milik `lines`, lalu kotak `boxes` (hasil query grid)
+static void DrawArea(TileCanvas& tile, const DataModel& model, const Rect& area,
+                     const std::vector<uint32_t>& lines, const std::vector<uint32_t>& boxes) {
+    tile.Reset(area.left, area.top, area.right - area.left, area.bottom - area.top);
+    tile.Fill(area.left, area.top, area.right, area.bottom, COL_CANVAS);
+    // Urutan sama dengan WM_PAINT: garis dulu, lalu kotak menimpa garis
+    for (uint32_t i : lines) {
+        for (uint32_t k = model.segmentStart[i]; k < model.segmentStart[i + 1]; ++k) DrawSegment(tile, model.segments[k]);
+    }
+    for (uint32_t i : boxes) DrawBox(tile, model, i);
+}
+
+void RenderArea(const DataModel& model, const SceneIndex& scene, const Rect& area, std::vector<uint8_t>& rgb) {
+    TileCanvas tile;
+    tile.rgb.swap(rgb); // Pakai ulang buffer pemanggil
+    std::vector<uint32_t> lines, boxes;
+    scene.connectors.QueryConcurrent(area, lines);
+    scene.boxes.QueryConcurrent(area, boxes);
+    DrawArea(tile, model, area, lines, boxes);
+    rgb.swap(tile.rgb);
+}
+
+// -----------------------------------------------------------------------------
+// ZOOM VIEW (Satu layar dengan skala dan tingkat detail, seperti tile di jendela)
+// -----------------------------------------------------------------------------
+
+// Warna blok ringkasan: campuran warna laki-laki/perempuan menurut jumlah perempuan di blok
+static Color BlendBlockColor(const OverviewBlock& b) {
+    double f = b.people ? (double)b.females / b.people : 0;
+    auto mix = [f](uint8_t m, uint8_t w) { return (uint8_t)(m + (w - m) * f + 0.5); };
+    return { mix(COL_BOX_MALE.r, COL_BOX_FEM.r), mix(COL_BOX_MALE.g, COL_BOX_FEM.g), mix(COL_BOX_MALE.b, COL_BOX_FEM.b) };
+}
+
+size_t RenderView(const DataModel& model, const SceneIndex& scene, double left, double top, double scale,
+                  int width, int height, std::vector<uint8_t>& rgb) {
+    TileCanvas tile;
+    tile.rgb.swap(rgb);
+    tile.Reset(0, 0, width, height);
+    tile.Fill(0, 0, width, height, COL_CANVAS);
+    size_t drawn = 0;
+
+    // Koordinat canvas -> layar (dibulatkan ke bawah); rect minimal 1 piksel agar tidak hilang
+    auto toX = [&](double x) { return (int)std::floor((x - left) * scale); };
+    auto toY = [&](double y) { return (int)std::floor((y - top) * scale); };
+    auto clampInt = [](double v) { return (int)std::max<double>(INT32_MIN, std::min<double>(INT32_MAX, v)); };
+    Rect area = { clampInt(std::floor(left)), clampInt(std::floor(top)),
+                  clampInt(std::ceil(left + width / scale) + 1), clampInt(std::ceil(top + height / scale) + 1) };
+
+    DetailLevel detail = ChooseDetail(scale);
+    if (detail == DetailLevel::Blocks) {
+        std::vector<OverviewBlock> blocks;
+        scene.overview.Query(scene.overview.LevelForScale(scale), area, blocks);
+        for (const OverviewBlock& b : blocks) {
+            int l = toX(b.rect.left), t = toY(b.rect.top);
+            tile.Fill(l, t, std::max(l + 1, toX(b.rect.right)), std::max(t + 1, toY(b.rect.bottom)), BlendBlockColor(b));
+        }
+        drawn = blocks.size();
+    } else {
+        std::vector<uint32_t> lines, boxes;
+        scene.connectors.QueryConcurrent(area, lines);
+        scene.boxes.QueryConcurrent(area, boxes);
+        for (uint32_t i : lines) {
+            for (uint32_t k = model.segmentStart[i]; k < model.segmentStart[i + 1]; ++k) {
+                LineSegment s = model.segments[k];
+                s.x1 = toX(s.x1); s.y1 = toY(s.y1); s.x2 = toX(s.x2); s.y2 = toY(s.y2);
+                DrawSegment(tile, s);
+            }
+        }
+        int shadow = std::max(1, (int)std::lround(SHADOW_OFFSET * scale));
+        for (uint32_t i : boxes) {
+            int x = toX(model.posX[i]), y = toY(model.posY[i]);
+            int right = std::max(x + 1, toX(model.posX[i] + BOX_WIDTH)), bottom = std::max(y + 1, toY(model.posY[i] + BOX_HEIGHT));
+            const Person& p = model.people[i];
+            Color fill = p.gender == Gender::Female ? COL_BOX_FEM : COL_BOX_MALE;
+            if (detail == DetailLevel::Plain) { // Kotak polos: isi saja
+                tile.Fill(x, y, right, bottom, fill);
+                continue;
+            }
+            tile.Fill(x + shadow, y + shadow, right + shadow, bottom + shadow, COL_SHADOW);
+            tile.Fill(x, y, right, bottom, fill);
+            tile.Fill(x, y, right, y + 1, COL_BLACK);
+            tile.Fill(x, bottom - 1, right, bottom, COL_BLACK);
+            tile.Fill(x, y, x + 1, bottom, COL_BLACK);
+            tile.Fill(right - 1, y, right, bottom, COL_BLACK);
+            int middle = y + (bottom - y) / 2;
+            DrawCenteredText(tile, x, y, right, middle, model.Text(p.name), true);
+            DrawCenteredText(tile, x, middle, right, bottom, model.Text(p.role), false);
+        }
+        drawn = boxes.size();
+    }
+    rgb.swap(tile.rgb);
+    return drawn;
+}
+
+bool ExportPngTiles(const DataModel& model, const SceneIndex& scene, const std::string& dir, int tileSize, unsigned threads) {
+    auto t0 = std::chrono::steady_clock::now();
+    if (tileSize <= 0 || model.maxX <= 0 || model.maxY <= 0) return false;
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec) {
+        std::cout << "[ERROR] Could not create " << dir << "\n";
+        return false;
+    }
+
+    int cols = (model.maxX + tileSize - 1) / tileSize;
+    int rows = (model.maxY + tileSize - 1) / tileSize;
+    size_t total = (size_t)cols * rows;
+    threads = ResolveThreads(threads);
+    threads = (unsigned)std::min<size_t>(threads, total);
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::atomic<uint64_t> written(0);
+    std::atomic<size_t> blank(0);
+    auto worker = [&]() {
+        TileCanvas tile;
+        PngEncoder encoder;
+        std::vector<uint32_t> lines, boxes;
+        std::vector<uint8_t> blankPng; // Tile kosong (hanya latar) dengan ukuran blankW x blankH
+        int blankW = 0, blankH = 0;
+        for (size_t t = next++; t < total && !failed; t = next++) {
+            int row = (int)(t / cols), col = (int)(t % cols);
+            int x = col * tileSize, y = row * tileSize;
+            int w = std::min(tileSize, model.maxX - x), h = std::min(tileSize, model.maxY - y);
+            Rect area = { x, y, x + w, y + h };
+            scene.connectors.QueryConcurrent(area, lines);
+            scene.boxes.QueryConcurrent(area, boxes);
+
+            const std::vector<uint8_t>* bytes = &blankPng;
+            if (!lines.empty() || !boxes.empty() || w != blankW || h != blankH) {
+                DrawArea(tile, model, area, lines, boxes);
+                encoder.Encode(tile);
+                bytes = &encoder.png;
+                // Canvas silsilah besar sebagian besar kosong: tile kosong cukup di-encode sekali
+                if (lines.empty() && boxes.empty()) { blankPng = encoder.png; blankW = w; blankH = h; }
+            }
+
+            std::string path = dir + "/tile_" + std::to_string(row) + "_" + std::to_string(col) + ".png";
+            if (!WriteFile(path, *bytes)) {
+                std::cout << "[ERROR] Could not write " << path << "\n";
+                failed = true;
+            }
+            written += bytes->size();
+            if (bytes == &blankPng) blank++;
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned k = 1; k < threads; ++k) pool.emplace_back(worker);
+    worker();
+    for (std::thread& th : pool) th.join();
+    if (failed) return false;
+
+    if (LogEnabled(LogLevel::Info)) std::cout << "[EXPORT] png_tiles=" << dir << " tiles=" << cols << "x" << rows << " tile_size=" << tileSize
+              << " threads=" << threads << " canvas=" << model.maxX << "x" << model.maxY
+              << " blank_tiles=" << blank << " mb=" << written / (1024.0 * 1024.0) << " ms=" << ElapsedMs(t0) << "\n";
+    return true;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// EXPORT (Menggambar seluruh pohon ke file tanpa jendela: SVG dan tile PNG)
+// Tampilan mengikuti DrawBox/DrawConnectors di main.cpp: warna per jenis kelamin, bayangan,
+// bingkai hitam, dan garis putus-putus untuk mantan pasangan. Keduanya ditulis bertahap
+// (SVG per orang, PNG per tile) sehingga memori tidak bergantung pada ukuran canvas.
+// -----------------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "model.h"
+#include "spatial_index.h"
+
+// Menulis canvas (0,0)-(maxX,maxY) sebagai satu file SVG. Model harus sudah di-layout.
+bool ExportSvg(const DataModel& model, const std::string& path);
+
+// Membagi canvas menjadi tile tileSize x tileSize piksel dan menulis "<dir>/tile_<baris>_<kolom>.png".
+// Tile digambar paralel oleh `threads` thread (0 = otomatis); memori sekitar threads x satu tile.
+// scene harus dibangun dari model yang sama (BuildSceneIndex). Teks memakai font bitmap 5x7
+// bawaan (ASCII; karakter lain digambar sebagai '?').
+bool ExportPngTiles(const DataModel& model, const SceneIndex& scene, const std::string& dir,
+                    int tileSize = 1024, unsigned threads = 0);
+
+// Menggambar area canvas ke rgb (3 byte per piksel, baris demi baris) tanpa menulis file, dengan
+// rasterizer yang sama seperti tile PNG. Dipakai benchmark untuk mengukur biaya satu layar.
+void RenderArea(const DataModel& model, const SceneIndex& scene, const Rect& area, std::vector<uint8_t>& rgb);
+
+// Menggambar satu layar width x height dengan zoom: titik canvas (left, top) di pojok kiri atas,
+// scale = piksel layar per piksel canvas. Tingkat detail mengikuti ChooseDetail(scale) seperti tile
+// di jendela (kotak lengkap, kotak polos, atau blok ringkasan). Mengembalikan jumlah kotak/blok.
+size_t RenderView(const DataModel& model, const SceneIndex& scene, double left, double top, double scale,
+                  int width, int height, std::vector<uint8_t>& rgb);
@@ -0,0 +1,232 @@
+#include "file_watcher.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <algorithm>
+#include <cwctype>
+#elif defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cstring>
+#endif
+
+bool FileWatcher::Start(const std::string& path, Callback onChange, int debounceMs, Backend backend) {
+    Stop();
+    m_path = path;
+    m_onChange = std::move(onChange);
+    m_debounceMs = debounceMs;
+    m_stop = false;
+
+    // Pantau folder, bukan file-nya: editor yang menyimpan dengan "tulis file sementara lalu
+    // rename" mengganti inode/handle file, sehingga watch langsung pada file akan hilang
+    std::filesystem::path p = std::filesystem::absolute(path);
+    m_dir = p.parent_path().string();
+    m_fileName = p.filename().string();
+
+    if (backend != Backend::Polling && StartNative()) {
+        m_thread = std::thread(&FileWatcher::RunNative, this);
+        return true;
+    }
+    if (backend == Backend::Native) return false;
+
+    m_backendName = "polling";
+    m_thread = std::thread(&FileWatcher::RunPolling, this);
+    return true;
+}
+
+bool FileWatcher::WaitForStop(int ms) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_cv.wait_for(lock, std::chrono::milliseconds(ms), [this] { return m_stop.load(); });
+}
+
+// Cadangan: bandingkan waktu modifikasi & ukuran file secara berkala
+void FileWatcher::RunPolling() {
+    auto stamp = [this] {
+        std::error_code ec;
+        auto t = std::filesystem::last_write_time(m_path, ec);
+        auto s = std::filesystem::file_size(m_path, ec);
+        return std::make_pair(t, ec ? (std::uintmax_t)-1 : s);
+    };
+    auto last = stamp();
+    while (!WaitForStop(m_pollMs)) {
+        auto now = stamp();
+        if (now == last) continue;
+        // Tunggu sampai file berhenti berubah (editor yang menulis bertahap)
+        do {
+            last = now;
+            if (WaitForStop(m_debounceMs)) return;
+            now = stamp();
+        } while (now != last);
+        m_onChange();
+    }
+}
+
+#ifdef _WIN32
+
+bool FileWatcher::StartNative() {
+    std::wstring dir = std::filesystem::path(m_dir).wstring();
+    HANDLE hDir = CreateFileW(dir.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+    if (hDir == INVALID_HANDLE_VALUE) return false;
+    m_hDir = hDir;
+    m_hIoEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+    m_hStopEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+    m_backendName = "ReadDirectoryChangesW";
+    return true;
+}
+
+void FileWatcher::RunNative() {
+    std::wstring target = std::filesystem::path(m_fileName).wstring();
+    alignas(DWORD) char buffer[16 * 1024];
+    OVERLAPPED ov = {};
+    ov.hEvent = m_hIoEvent;
+    HANDLE waits[2] = { m_hIoEvent, m_hStopEvent };
+    const DWORD filter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE;
+
+    // Mengecek apakah buffer notifikasi menyebut file yang dipantau (nama file di Windows tidak case-sensitive)
+    auto mentionsTarget = [&](DWORD bytes) {
+        if (bytes == 0) return true; // Buffer overflow: anggap file ikut berubah
+        const char* cur = buffer;
+        for (;;) {
+            const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*)cur;
+            std::wstring name(info->FileName, info->FileNameLength / sizeof(wchar_t));
+            if (name.size() == target.size() &&
+                std::equal(name.begin(), name.end(), target.begin(), [](wchar_t a, wchar_t b) { return towlower(a) == towlower(b); }))
+                return true;
+            if (info->NextEntryOffset == 0) return false;
+            cur += info->NextEntryOffset;
+        }
+    };
+
+    bool pending = false;   // Ada perubahan yang belum dilaporkan (menunggu debounce)
+    bool ioPending = false; // Permintaan ReadDirectoryChangesW masih berjalan
+    while (!m_stop) {
+        if (!ioPending) {
+            ResetEvent(m_hIoEvent);
+            if (!ReadDirectoryChangesW(m_hDir, buffer, sizeof(buffer), FALSE, filter, NULL, &ov, NULL)) break;
+            ioPending = true;
+        }
+
+        // Tanpa event: tunggu selamanya (tidak memakai CPU). Ada event tertunda: tunggu jeda debounce.
+        DWORD r = WaitForMultipleObjects(2, waits, FALSE, pending ? (DWORD)m_debounceMs : INFINITE);
+        if (r == WAIT_OBJECT_0 + 1) break;
+        if (r == WAIT_TIMEOUT) {
+            pending = false;
+            m_onChange();
+            continue;
+        }
+        DWORD bytes = 0;
+        ioPending = false;
+        if (!GetOverlappedResult(m_hDir, &ov, &bytes, FALSE)) break;
+        if (mentionsTarget(bytes)) pending = true;
+    }
+    if (ioPending) {
+        CancelIoEx(m_hDir, &ov);
+        DWORD ignored = 0;
+        GetOverlappedResult(m_hDir, &ov, &ignored, TRUE);
+    }
+}
+
+void FileWatcher::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex); // Agar WaitForStop tidak melewatkan notifikasi
+        m_stop = true;
+    }
+    if (m_hStopEvent) SetEvent(m_hStopEvent);
+    m_cv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+    if (m_hDir) CloseHandle(m_hDir);
+    if (m_hIoEvent) CloseHandle(m_hIoEvent);
+    if (m_hStopEvent) CloseHandle(m_hStopEvent);
+    m_hDir = m_hIoEvent = m_hStopEvent = nullptr;
+    m_backendName = "none";
+}
+
+#elif defined(__linux__)
+
+bool FileWatcher::StartNative() {
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0) return false;
+    // IN_CLOSE_WRITE: penyimpanan biasa selesai; IN_MOVED_TO/IN_CREATE: simpan via rename atomik
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MODIFY | IN_DELETE;
+    if (inotify_add_watch(m_inotifyFd, m_dir.c_str(), mask) < 0 || pipe2(m_stopPipe, O_CLOEXEC) != 0) {
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+        return false;
+    }
+    m_backendName = "inotify";
+    return true;
+}
+
+void FileWatcher::RunNative() {
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    pollfd fds[2] = { { m_inotifyFd, POLLIN, 0 }, { m_stopPipe[0], POLLIN, 0 } };
+    bool pending = false;
+
+    while (!m_stop) {
+        // Tanpa event: blok selamanya (tidak memakai CPU). Ada event tertunda: tunggu jeda debounce.
+        int r = poll(fds, 2, pending ? m_debounceMs : -1);
+        if (r < 0) continue; // EINTR
+        if (fds[1].revents) break;
+        if (r == 0) {
+            pending = false;
+            m_onChange();
+            continue;
+        }
+
+        ssize_t len;
+        while ((len = read(m_inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* cur = buffer; cur < buffer + len;) {
+                const inotify_event* ev = (const inotify_event*)cur;
+                if (ev->mask & IN_Q_OVERFLOW) pending = true;
+                else if (ev->len > 0 && m_fileName == ev->name) pending = true;
+                cur += sizeof(inotify_event) + ev->len;
+            }
+        }
+    }
+}
+
+void FileWatcher::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex); // Agar WaitForStop tidak melewatkan notifikasi
+        m_stop = true;
+    }
+    if (m_stopPipe[1] >= 0) {
+        char c = 0;
+        (void)!write(m_stopPipe[1], &c, 1);
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+    if (m_inotifyFd >= 0) close(m_inotifyFd);
+    if (m_stopPipe[0] >= 0) close(m_stopPipe[0]);
+    if (m_stopPipe[1] >= 0) close(m_stopPipe[1]);
+    m_inotifyFd = m_stopPipe[0] = m_stopPipe[1] = -1;
+    m_backendName = "none";
+}
+
+#else
+
+// Platform lain: belum ada backend native, selalu memakai polling
+bool FileWatcher::StartNative() { return false; }
+void FileWatcher::RunNative() {}
+
+void FileWatcher::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex); // Agar WaitForStop tidak melewatkan notifikasi
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+    m_backendName = "none";
+}
+
+#endif
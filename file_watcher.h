@@ -0,0 +1,62 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// FILE WATCHER (Memantau perubahan file untuk live reload, tanpa polling tiap detik)
+//   - Linux   : inotify pada folder file (menangkap juga simpan via rename atomik)
+//   - Windows : ReadDirectoryChangesW pada folder file
+//   - Lainnya : polling waktu modifikasi sebagai cadangan
+// Callback dipanggil dari thread pemantau setelah rentetan event mereda (debounce).
+// -----------------------------------------------------------------------------
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class FileWatcher {
+public:
+    enum class Backend { Auto, Native, Polling };
+    using Callback = std::function<void()>;
+
+    FileWatcher() = default;
+    ~FileWatcher() { Stop(); }
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Mulai memantau path. debounceMs: jeda tanpa event sebelum callback dipanggil.
+    // Backend::Auto memakai backend native bila tersedia dan jatuh ke polling bila gagal.
+    bool Start(const std::string& path, Callback onChange, int debounceMs = 50, Backend backend = Backend::Auto);
+    void Stop();
+
+    // Nama backend yang sedang aktif ("inotify", "ReadDirectoryChangesW", "polling", atau "none")
+    const char* BackendName() const { return m_backendName; }
+
+private:
+    bool StartNative();
+    void RunNative();
+    void RunPolling();
+    bool WaitForStop(int ms); // Tidur maksimal ms milidetik; true jika Stop() dipanggil
+
+    std::string m_path;
+    std::string m_dir;
+    std::string m_fileName;
+    Callback m_onChange;
+    int m_debounceMs = 50;
+    int m_pollMs = 500;
+    const char* m_backendName = "none";
+
+    std::thread m_thread;
+    std::atomic<bool> m_stop{false};
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+
+#ifdef _WIN32
+    void* m_hDir = nullptr;
+    void* m_hIoEvent = nullptr;
+    void* m_hStopEvent = nullptr;
+#else
+    int m_inotifyFd = -1;
+    int m_stopPipe[2] = {-1, -1};
+#endif
+};
@@ -0,0 +1,644 @@
+#include "gedcom.h"
+#include "stats.h"
+
+#include <algorithm>   // std::sort untuk cek ID unik
+#include <charconv>    // std::from_chars untuk angka di xref
+#include <chrono>      // Untuk mengukur durasi ekspor
+#include <cstring>     // std::memchr/std::memmove pada buffer baca
+#include <fstream>     // Membaca/menulis file GEDCOM
+#include <iostream>    // Untuk output ke console
+#include <unordered_map> // FAM per grup orang tua / pasangan saat menulis
+
+bool IsGedcomPath(const std::string& path) {
+    if (path.size() < 4) return false;
+    std::string_view ext(path.data() + path.size() - 4, 4);
+    return ext[0] == '.' && (ext[1] == 'g' || ext[1] == 'G') && (ext[2] == 'e' || ext[2] == 'E') && (ext[3] == 'd' || ext[3] == 'D');
+}
+
+// -----------------------------------------------------------------------------
+// PEMBACA (Streaming: satu baris "level [@xref@] TAG [nilai]" per langkah)
+// -----------------------------------------------------------------------------
+
+namespace {
+
+struct GedLine {
+    int level = -1;
+    std::string_view xref;  // "@I1@" (kosong jika tidak ada)
+    std::string_view tag;
+    std::string_view value; // Sisa baris setelah satu spasi pemisah
+};
+
+// Satu record FAM. Rujukan masih berupa nomor xref (0 = tidak ada) sampai tahap penyelesaian.
+struct GedFamily {
+    uint32_t xref = 0;
+    uint32_t husb = 0;
+    uint32_t wife = 0;
+    uint32_t childBegin = 0; // CHIL ada di GedcomReader::m_children[childBegin .. +childCount)
+    uint32_t childCount = 0;
+    bool divorced = false;
+};
+
+static bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+static std::string_view Trim(std::string_view s) {
+    while (!s.empty() && IsSpace(s.front())) s.remove_prefix(1);
+    while (!s.empty() && IsSpace(s.back())) s.remove_suffix(1);
+    return s;
+}
+
+// Spasi/tab di awal baris diizinkan GEDCOM 5.5.1; CR dari pasangan LF/CR ikut terbuang di sini
+static bool ParseLine(const char* b, const char* e, GedLine& out) {
+    while (b < e && IsSpace(*b)) ++b;
+    while (e > b && (e[-1] == '\r' || e[-1] == '\n')) --e;
+    int level = 0;
+    const char* digits = b;
+    while (b < e && *b >= '0' && *b <= '9' && b - digits < 3) level = level * 10 + (*b++ - '0');
+    if (b == digits || b == e || *b != ' ') return false;
+    while (b < e && *b == ' ') ++b;
+
+    out.level = level;
+    out.xref = {};
+    if (b < e && *b == '@') {
+        const char* close = (const char*)std::memchr(b + 1, '@', (size_t)(e - b - 1));
+        if (!close) return false;
+        out.xref = std::string_view(b, (size_t)(close + 1 - b));
+        b = close + 1;
+        while (b < e && *b == ' ') ++b;
+    }
+    const char* tag = b;
+    while (b < e && *b != ' ') ++b;
+    if (b == tag) return false;
+    out.tag = std::string_view(tag, (size_t)(b - tag));
+    if (b < e) ++b; // Satu spasi pemisah; spasi lain termasuk nilai
+    out.value = std::string_view(b, (size_t)(e - b));
+    return true;
+}
+
+// Angka di xref INDI: "@I12@" -> 12, "@P-3@" -> -3. 0 jika bukan huruf lalu angka saja.
+static int XrefNumber(std::string_view xref) {
+    if (xref.size() < 3) return 0;
+    const char* b = xref.data() + 1;
+    const char* e = xref.data() + xref.size() - 1;
+    while (b < e && ((*b >= 'A' && *b <= 'Z') || (*b >= 'a' && *b <= 'z') || *b == '_')) ++b;
+    int value = 0;
+    auto res = std::from_chars(b, e, value);
+    if (res.ec != std::errc() || res.ptr != e) return 0;
+    return value;
+}
+
+// Teks GEDCOM: "@@" berarti satu '@'
+static void AppendText(std::string& out, std::string_view text) {
+    for (size_t i = 0; i < text.size(); ++i) {
+        out += text[i];
+        if (text[i] == '@' && i + 1 < text.size() && text[i + 1] == '@') ++i;
+    }
+}
+
+// Xref -> nomor (1..): tabel hash terbuka datar seperti ParentGroupTable. Teks xref disimpan sekali
+// di pool; hash 64-bit hanya menyaring, kecocokan tetap dicek dengan teksnya. 0 = tidak ada.
+class XrefTable {
+public:
+    XrefTable() { m_slots.resize(1 << 12); }
+
+    uint32_t Intern(std::string_view xref) {
+        uint64_t h = Hash(xref);
+        size_t mask = m_slots.size() - 1;
+        for (size_t i = (size_t)(h >> 20) & mask;; i = (i + 1) & mask) {
+            Slot& slot = m_slots[i];
+            if (slot.handle == 0) {
+                slot.hash = h;
+                slot.handle = m_text.Add(xref);
+                if (++m_count * 2 > m_slots.size()) Rehash(m_slots.size() * 2);
+                return (uint32_t)m_count;
+            }
+            if (slot.hash == h && m_text.Get(slot.handle) == xref) return slot.handle;
+        }
+    }
+    size_t Count() const { return m_count + 1; } // Termasuk nomor 0
+
+private:
+    struct Slot {
+        uint64_t hash = 0;
+        uint32_t handle = 0;
+    };
+    static uint64_t Hash(std::string_view s) {
+        uint64_t h = 0xcbf29ce484222325ull; // FNV-1a
+        for (char c : s) h = (h ^ (uint8_t)c) * 0x100000001b3ull;
+        return h;
+    }
+    void Rehash(size_t capacity) {
+        std::vector<Slot> old(capacity);
+        old.swap(m_slots);
+        size_t mask = capacity - 1;
+        for (const Slot& slot : old) {
+            if (slot.handle == 0) continue;
+            size_t i = (size_t)(slot.hash >> 20) & mask;
+            while (m_slots[i].handle != 0) i = (i + 1) & mask;
+            m_slots[i] = slot;
+        }
+    }
+
+    std::vector<Slot> m_slots; // Ukuran selalu pangkat dua
+    StringPool m_text;         // Nomor teks di pool = nomor xref (Add berurutan mulai dari 1)
+    size_t m_count = 0;
+};
+
+class GedcomReader {
+public:
+    explicit GedcomReader(DataModel& model) : m_model(model) {}
+
+    bool Read(const std::string& path);
+
+private:
+    enum class Record { None, Indi, Fam };
+    enum class Field { None, Name, Role, Title }; // Tag level 1 yang boleh disambung CONC/CONT
+
+    void HandleLine(const char* b, const char* e);
+    void FinishRecord();
+    uint32_t Pointer(std::string_view value); // Nomor xref dari nilai "@X1@" (0 jika bukan rujukan)
+    void Resolve();
+
+    DataModel& m_model;
+    int m_lineNum = 0;
+    size_t m_skipped = 0;
+
+    // Tahap 1: isi record apa adanya, rujukan dicatat sebagai nomor xref
+    XrefTable m_xrefs;                      // Teks xref -> nomor (0 = tidak ada)
+    std::vector<uint32_t> m_personXref;     // Per orang
+    std::vector<uint32_t> m_famc;           // Per orang: FAMC pertama
+    std::vector<std::pair<uint32_t, uint32_t>> m_fams; // (orang, xref FAM) sesuai urutan file
+    std::vector<GedFamily> m_families;
+    std::vector<uint32_t> m_children;       // xref CHIL semua FAM, berdampingan per FAM
+
+    // Record yang sedang dibaca
+    Record m_record = Record::None;
+    Field m_field = Field::None;
+    Person m_person;
+    std::string m_name, m_role, m_title;
+    bool m_hasName = false;
+};
+
+bool GedcomReader::Read(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cout << "[ERROR] Could not open file stream!\n";
+        return false;
+    }
+
+    // Buffer tetap 1 MB; hanya membesar jika satu baris lebih panjang dari buffer
+    std::vector<char> buffer(1 << 20);
+    size_t carried = 0; // Sisa baris yang belum lengkap dari bacaan sebelumnya (di awal buffer)
+    bool first = true;
+    char eol = '\n';
+    for (;;) {
+        if (carried == buffer.size()) buffer.resize(buffer.size() * 2);
+        in.read(buffer.data() + carried, (std::streamsize)(buffer.size() - carried));
+        size_t got = (size_t)in.gcount();
+        size_t size = carried + got;
+        const char* data = buffer.data();
+        size_t pos = 0;
+
+        if (first) {
+            first = false;
+            if (size >= 3 && (uint8_t)data[0] == 0xEF && (uint8_t)data[1] == 0xBB && (uint8_t)data[2] == 0xBF) pos = 3;
+            // Akhir baris GEDCOM boleh CR, LF, CR LF, atau LF CR: cukup pilih satu pemisah dari
+            // bacaan pertama, pasangannya dibuang ParseLine sebagai spasi
+            if (!std::memchr(data, '\n', size) && std::memchr(data, '\r', size)) eol = '\r';
+        }
+
+        for (;;) {
+            const char* nl = (const char*)std::memchr(data + pos, eol, size - pos);
+            if (!nl) break;
+            HandleLine(data + pos, nl);
+            pos = (size_t)(nl - data) + 1;
+        }
+        if (got == 0) {
+            if (pos < size) HandleLine(data + pos, data + size); // Baris terakhir tanpa akhir baris
+            break;
+        }
+        carried = size - pos;
+        std::memmove(buffer.data(), data + pos, carried);
+    }
+    FinishRecord();
+    Resolve();
+    return true;
+}
+
+uint32_t GedcomReader::Pointer(std::string_view value) {
+    value = Trim(value);
+    if (value.size() < 3 || value.front() != '@' || value.back() != '@') return 0;
+    return m_xrefs.Intern(value);
+}
+
+void GedcomReader::HandleLine(const char* b, const char* e) {
+    m_lineNum++;
+    GedLine line;
+    if (!ParseLine(b, e, line)) {
+        std::string_view text = Trim(std::string_view(b, (size_t)(e - b)));
+        if (text.empty()) return;
+        m_skipped++;
+        if (LogEnabled(LogLevel::Info)) std::cout << "[SKIP] Line " << m_lineNum << ": '" << text << "' (Not GEDCOM)\n";
+        return;
+    }
+
+    if (line.level == 0) {
+        FinishRecord();
+        if (line.xref.empty()) return;
+        if (line.tag == "INDI") {
+            m_record = Record::Indi;
+            m_person = Person();
+            m_person.line = m_lineNum;
+            m_person.id = XrefNumber(line.xref);
+            m_personXref.push_back(m_xrefs.Intern(line.xref));
+            m_famc.push_back(0);
+            m_name.clear();
+            m_role.clear();
+            m_title.clear();
+            m_hasName = false;
+        } else if (line.tag == "FAM") {
+            m_record = Record::Fam;
+            GedFamily f;
+            f.xref = m_xrefs.Intern(line.xref);
+            f.childBegin = (uint32_t)m_children.size();
+            m_families.push_back(f);
+        }
+        return;
+    }
+    if (m_record == Record::None) return;
+
+    if (line.level == 1) {
+        m_field = Field::None;
+        if (m_record == Record::Indi) {
+            if (line.tag == "NAME") {
+                if (m_hasName) return; // Nama pertama yang dipakai
+                m_hasName = true;
+                m_field = Field::Name;
+                AppendText(m_name, line.value);
+            } else if (line.tag == "SEX") {
+                m_person.gender = ParseGender(Trim(line.value));
+            } else if (line.tag == "_ROLE") {
+                m_field = Field::Role;
+                m_role.clear();
+                AppendText(m_role, line.value);
+            } else if (line.tag == "TITL") {
+                if (!m_title.empty()) return;
+                m_field = Field::Title;
+                AppendText(m_title, line.value);
+            } else if (line.tag == "FAMC") {
+                uint32_t& famc = m_famc.back();
+                if (famc == 0) famc = Pointer(line.value);
+            } else if (line.tag == "FAMS") {
+                uint32_t fam = Pointer(line.value);
+                if (fam) m_fams.emplace_back((uint32_t)m_personXref.size() - 1, fam);
+            }
+        } else {
+            GedFamily& f = m_families.back();
+            if (line.tag == "HUSB") {
+                if (f.husb == 0) f.husb = Pointer(line.value);
+            } else if (line.tag == "WIFE") {
+                if (f.wife == 0) f.wife = Pointer(line.value);
+            } else if (line.tag == "CHIL") {
+                uint32_t child = Pointer(line.value);
+                if (child) {
+                    m_children.push_back(child);
+                    f.childCount++;
+                }
+            } else if (line.tag == "DIV") {
+                f.divorced = true;
+            }
+        }
+        return;
+    }
+
+    // Sambungan teks panjang (level 2 di bawah NAME/_ROLE/TITL)
+    if (line.level == 2 && m_field != Field::None && (line.tag == "CONC" || line.tag == "CONT")) {
+        std::string& target = (m_field == Field::Name) ? m_name : (m_field == Field::Role) ? m_role : m_title;
+        if (line.tag == "CONT") target += ' ';
+        AppendText(target, line.value);
+    }
+}
+
+void GedcomReader::FinishRecord() {
+    if (m_record == Record::Indi) {
+        // "Budi /Santoso/" -> "Budi Santoso": garis miring hanya penanda nama keluarga
+        m_name.erase(std::remove(m_name.begin(), m_name.end(), '/'), m_name.end());
+        m_person.name = m_model.strings.Add(Trim(m_name));
+        m_person.role = m_model.strings.Intern(Trim(m_role.empty() ? m_title : m_role));
+        m_model.people.push_back(m_person);
+    }
+    m_record = Record::None;
+    m_field = Field::None;
+}
+
+// -----------------------------------------------------------------------------
+// TAHAP 2 (Menyelesaikan rujukan @xref@ setelah seluruh file terbaca)
+// -----------------------------------------------------------------------------
+void GedcomReader::Resolve() {
+    const uint32_t NONE = DataModel::NO_INDEX;
+    std::vector<Person>& people = m_model.people;
+    const size_t n = people.size();
+    size_t unresolved = 0, duplicates = 0;
+
+    // xref -> indeks orang / FAM (xref ganda: record pertama yang dipakai)
+    std::vector<uint32_t> personOf(m_xrefs.Count(), NONE);
+    std::vector<uint32_t> familyOf(m_xrefs.Count(), NONE);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t& slot = personOf[m_personXref[i]];
+        if (slot == NONE) slot = (uint32_t)i;
+        else duplicates++;
+    }
+    for (size_t f = 0; f < m_families.size(); ++f) {
+        uint32_t& slot = familyOf[m_families[f].xref];
+        if (slot == NONE) slot = (uint32_t)f;
+        else duplicates++;
+    }
+    auto person = [&](uint32_t xref) -> uint32_t {
+        if (xref == 0) return NONE;
+        if (personOf[xref] == NONE) unresolved++;
+        return personOf[xref];
+    };
+    auto family = [&](uint32_t xref) -> uint32_t {
+        if (xref == 0) return NONE;
+        if (familyOf[xref] == NONE) unresolved++;
+        return familyOf[xref];
+    };
+
+    // ID dari angka xref hanya jika semuanya ada dan unik; jika tidak, nomor urut di file
+    std::vector<int> ids(n);
+    for (size_t i = 0; i < n; ++i) ids[i] = people[i].id;
+    std::sort(ids.begin(), ids.end());
+    bool numbered = (n == 0 || ids[0] != 0) && std::adjacent_find(ids.begin(), ids.end()) == ids.end();
+    if (!numbered) {
+        for (size_t i = 0; i < n; ++i) people[i].id = (int)i + 1;
+        std::cout << "[WARNING] GEDCOM: INDI xrefs are not unique numbers, people renumbered 1.." << n << "\n";
+    }
+    std::vector<int>().swap(ids);
+
+    std::vector<uint32_t> husb(m_families.size()), wife(m_families.size());
+    for (size_t f = 0; f < m_families.size(); ++f) {
+        husb[f] = person(m_families[f].husb);
+        wife[f] = person(m_families[f].wife);
+    }
+
+    // Orang tua: FAMC orang itu sendiri, atau FAM pertama yang mencantumkannya sebagai CHIL
+    std::vector<uint8_t> hasParents(n, 0);
+    auto setParents = [&](size_t i, uint32_t f) {
+        people[i].fatherId = (husb[f] != NONE) ? people[husb[f]].id : 0;
+        people[i].motherId = (wife[f] != NONE) ? people[wife[f]].id : 0;
+        hasParents[i] = 1;
+    };
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t f = family(m_famc[i]);
+        if (f != NONE) setParents(i, f);
+    }
+    for (size_t f = 0; f < m_families.size(); ++f) {
+        const GedFamily& fam = m_families[f];
+        for (uint32_t k = 0; k < fam.childCount; ++k) {
+            uint32_t child = person(m_children[fam.childBegin + k]);
+            if (child != NONE && !hasParents[child]) setParents(child, (uint32_t)f);
+        }
+    }
+
+    // Pasangan: FAM per orang (format CSR), FAMS dulu sesuai urutan file lalu FAM tempat orang itu
+    // tercatat sebagai HUSB/WIFE. Penghitungan stabil menjaga urutan itu untuk setiap orang.
+    std::vector<std::pair<uint32_t, uint32_t>> entries; // (orang, FAM)
+    entries.reserve(m_fams.size() + m_families.size() * 2);
+    for (const auto& fs : m_fams) {
+        uint32_t f = family(fs.second);
+        if (f != NONE) entries.emplace_back(fs.first, f);
+    }
+    for (size_t f = 0; f < m_families.size(); ++f) {
+        if (husb[f] != NONE) entries.emplace_back(husb[f], (uint32_t)f);
+        if (wife[f] != NONE) entries.emplace_back(wife[f], (uint32_t)f);
+    }
+    std::vector<uint32_t> offsets(n + 1, 0);
+    for (const auto& en : entries) offsets[en.first + 1]++;
+    for (size_t i = 0; i < n; ++i) offsets[i + 1] += offsets[i];
+    std::vector<uint32_t> entryFamily(entries.size());
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (const auto& en : entries) entryFamily[fill[en.first]++] = en.second;
+    }
+    std::vector<std::pair<uint32_t, uint32_t>>().swap(entries);
+
+    std::vector<SpouseLink>& links = m_model.spouseLinks;
+    links.clear();
+    links.reserve(entryFamily.size() / 2);
+    for (size_t i = 0; i < n; ++i) {
+        Person& p = people[i];
+        p.spouseBegin = (uint32_t)links.size();
+        for (uint32_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+            uint32_t f = entryFamily[k];
+            uint32_t partner = (husb[f] == i) ? wife[f] : (wife[f] == i) ? husb[f] : NONE;
+            if (partner == NONE || partner == i) continue;
+            SpouseLink link{ people[partner].id, m_families[f].divorced };
+            bool merged = false;
+            for (size_t s = p.spouseBegin; s < links.size() && !merged; ++s) {
+                if (links[s].id == link.id) {
+                    links[s].ex = links[s].ex || link.ex;
+                    merged = true;
+                }
+            }
+            if (!merged) links.push_back(link);
+        }
+        p.spouseCount = (uint32_t)links.size() - p.spouseBegin;
+    }
+
+    AddCounter(Counter::RowsSkipped, m_skipped);
+    if (unresolved || duplicates) {
+        std::cout << "[WARNING] GEDCOM: " << unresolved << " unresolved references, " << duplicates << " duplicate xrefs\n";
+    }
+    if (LogEnabled(LogLevel::Info)) {
+        std::cout << "[INFO] GEDCOM: " << m_lineNum << " lines, " << n << " individuals, " << m_families.size() << " families\n";
+    }
+}
+
+} // namespace
+
+bool ReadGedcom(DataModel& model, const std::string& path) {
+    GedcomReader reader(model);
+    return reader.Read(path);
+}
+
+// -----------------------------------------------------------------------------
+// PENULIS (Streaming: HEAD, INDI per orang sesuai urutan, FAM, TRLR)
+// -----------------------------------------------------------------------------
+
+static void WriteText(std::ostream& out, std::string_view text) {
+    for (char c : text) {
+        if (c == '@') out << '@';
+        out << c;
+    }
+}
+
+bool ExportGedcom(const DataModel& model, const std::string& path) {
+    const uint32_t NONE = DataModel::NO_INDEX;
+    auto t0 = std::chrono::steady_clock::now();
+    const size_t n = model.people.size();
+    size_t dropped = 0, duplicates = 0;
+
+    auto indexOf = [&](int id) -> uint32_t {
+        if (id == 0) return NONE;
+        size_t index = model.IndexOf(id);
+        if (index == IdIndex::NPOS) {
+            dropped++;
+            return NONE;
+        }
+        return (uint32_t)index;
+    };
+
+    // 1. FAM: satu per grup orang tua (urutan anak pertama di file), lalu satu per pasangan yang
+    //    belum punya FAM. Orang tua anak-anak sekaligus pasangan memakai FAM grupnya.
+    struct OutFamily {
+        uint32_t husb = NONE;
+        uint32_t wife = NONE;
+        bool divorced = false;
+    };
+    std::vector<OutFamily> families;
+    std::vector<uint32_t> famc(n, NONE);
+    std::unordered_map<long long, uint32_t> groupFamily; // ParentKey(Ayah, Ibu) -> FAM
+    std::unordered_map<long long, uint32_t> pairFamily;  // (indeks kecil, indeks besar) -> FAM
+    auto pairKey = [](uint32_t a, uint32_t b) {
+        if (a > b) std::swap(a, b);
+        return (long long)(((unsigned long long)a << 32) | b);
+    };
+    for (size_t i = 0; i < n; ++i) {
+        const Person& p = model.people[i];
+        if (p.fatherId == 0 && p.motherId == 0) continue;
+        auto it = groupFamily.find(DataModel::ParentKey(p.fatherId, p.motherId));
+        if (it == groupFamily.end()) {
+            OutFamily f;
+            f.husb = indexOf(p.fatherId);
+            f.wife = indexOf(p.motherId);
+            uint32_t number = (uint32_t)families.size();
+            families.push_back(f);
+            if (f.husb != NONE && f.wife != NONE && f.husb != f.wife) pairFamily.emplace(pairKey(f.husb, f.wife), number);
+            it = groupFamily.emplace(DataModel::ParentKey(p.fatherId, p.motherId), number).first;
+        }
+        famc[i] = it->second;
+    }
+    std::vector<uint32_t> linkFamily(model.spouseLinks.size(), NONE); // FAM per pasangan (urutan FAMS)
+    for (size_t i = 0; i < n; ++i) {
+        const Person& p = model.people[i];
+        const SpouseLink* links = model.spouseLinks.data() + p.spouseBegin;
+        for (uint32_t k = 0; k < p.spouseCount; ++k) {
+            uint32_t s = indexOf(links[k].id);
+            if (s == NONE || s == i) continue;
+            auto it = pairFamily.find(pairKey((uint32_t)i, s));
+            if (it == pairFamily.end()) {
+                OutFamily f;
+                bool swap = model.people[i].gender == Gender::Female && model.people[s].gender != Gender::Female;
+                f.husb = swap ? s : (uint32_t)i;
+                f.wife = swap ? (uint32_t)i : s;
+                it = pairFamily.emplace(pairKey((uint32_t)i, s), (uint32_t)families.size()).first;
+                families.push_back(f);
+            }
+            families[it->second].divorced = families[it->second].divorced || links[k].ex;
+            linkFamily[p.spouseBegin + k] = it->second;
+        }
+    }
+    pairFamily = {};
+    groupFamily = {};
+
+    // 2. FAM tempat setiap orang menjadi HUSB/WIFE, dan anak per FAM (keduanya format CSR)
+    std::vector<uint32_t> memberOffsets(n + 1, 0), memberFamily;
+    std::vector<uint32_t> childOffsets(families.size() + 1, 0), childIndex;
+    for (const OutFamily& f : families) {
+        if (f.husb != NONE) memberOffsets[f.husb + 1]++;
+        if (f.wife != NONE && f.wife != f.husb) memberOffsets[f.wife + 1]++;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        memberOffsets[i + 1] += memberOffsets[i];
+        if (famc[i] != NONE) childOffsets[famc[i] + 1]++;
+    }
+    for (size_t f = 0; f < families.size(); ++f) childOffsets[f + 1] += childOffsets[f];
+    memberFamily.resize(memberOffsets[n]);
+    childIndex.resize(childOffsets[families.size()]);
+    {
+        std::vector<uint32_t> fill(memberOffsets.begin(), memberOffsets.end() - 1);
+        for (size_t f = 0; f < families.size(); ++f) {
+            if (families[f].husb != NONE) memberFamily[fill[families[f].husb]++] = (uint32_t)f;
+            if (families[f].wife != NONE && families[f].wife != families[f].husb) memberFamily[fill[families[f].wife]++] = (uint32_t)f;
+        }
+        fill.assign(childOffsets.begin(), childOffsets.end() - 1);
+        for (size_t i = 0; i < n; ++i) {
+            if (famc[i] != NONE) childIndex[fill[famc[i]]++] = (uint32_t)i;
+        }
+    }
+
+    // 3. Tulis
+    std::vector<char> buffer(1 << 20);
+    std::ofstream out;
+    out.rdbuf()->pubsetbuf(buffer.data(), (std::streamsize)buffer.size());
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cout << "[ERROR] Could not write " << path << "\n";
+        return false;
+    }
+    out << "0 HEAD\n1 SOUR SILSILAH\n1 GEDC\n2 VERS 5.5.1\n2 FORM LINEAGE-LINKED\n1 CHAR UTF-8\n";
+
+    std::vector<uint32_t> written; // FAMS yang sudah ditulis untuk orang yang sedang ditulis
+    size_t individuals = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const Person& p = model.people[i];
+        // ID ganda: hanya baris yang dipakai idToIndex yang bisa dirujuk, baris lain dilewati
+        if (model.IndexOf(p.id) != i) {
+            duplicates++;
+            continue;
+        }
+        individuals++;
+        out << "0 @I" << p.id << "@ INDI\n";
+        std::string_view name = model.Text(p.name);
+        if (!name.empty()) {
+            out << "1 NAME ";
+            WriteText(out, name);
+            out << '\n';
+        }
+        if (p.gender != Gender::Unknown) out << "1 SEX " << (p.gender == Gender::Female ? 'F' : 'M') << '\n';
+        std::string_view role = model.Text(p.role);
+        if (!role.empty()) {
+            out << "1 _ROLE ";
+            WriteText(out, role);
+            out << '\n';
+        }
+        if (famc[i] != NONE) out << "1 FAMC @F" << famc[i] + 1 << "@\n";
+
+        // FAMS sesuai urutan pasangan di file, lalu FAM grup orang tua yang bukan pasangannya
+        written.clear();
+        auto writeFams = [&](uint32_t f) {
+            if (f == NONE || std::find(written.begin(), written.end(), f) != written.end()) return;
+            written.push_back(f);
+            out << "1 FAMS @F" << f + 1 << "@\n";
+        };
+        for (uint32_t k = 0; k < p.spouseCount; ++k) writeFams(linkFamily[p.spouseBegin + k]);
+        for (uint32_t k = memberOffsets[i]; k < memberOffsets[i + 1]; ++k) writeFams(memberFamily[k]);
+    }
+
+    for (size_t f = 0; f < families.size(); ++f) {
+        const OutFamily& fam = families[f];
+        out << "0 @F" << f + 1 << "@ FAM\n";
+        if (fam.husb != NONE) out << "1 HUSB @I" << model.people[fam.husb].id << "@\n";
+        if (fam.wife != NONE) out << "1 WIFE @I" << model.people[fam.wife].id << "@\n";
+        for (uint32_t k = childOffsets[f]; k < childOffsets[f + 1]; ++k) {
+            uint32_t c = childIndex[k];
+            if (model.IndexOf(model.people[c].id) == c) out << "1 CHIL @I" << model.people[c].id << "@\n";
+        }
+        if (fam.divorced) out << "1 DIV Y\n";
+    }
+    out << "0 TRLR\n";
+    out.close();
+    if (!out) {
+        std::cout << "[ERROR] Could not write " << path << "\n";
+        return false;
+    }
+
+    if (dropped || duplicates) {
+        std::cout << "[WARNING] GEDCOM: " << dropped << " references to missing IDs and " << duplicates
+                  << " duplicate IDs not written\n";
+    }
+    if (LogEnabled(LogLevel::Info)) {
+        std::cout << "[EXPORT] gedcom=" << path << " individuals=" << individuals << " families=" << families.size()
+                  << " ms=" << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() << "\n";
+    }
+    return true;
+}
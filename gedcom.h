@@ -0,0 +1,33 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// GEDCOM (Impor/ekspor format silsilah standar di samping CSV)
+// Pembaca berjalan satu kali dari awal sampai akhir file dengan buffer tetap (tanpa memuat
+// seluruh file): INDI menjadi Person, FAM dicatat sebagai pasangan HUSB/WIFE, daftar CHIL, dan
+// tanda DIV. Rujukan @xref@ baru diselesaikan setelah file habis (tahap kedua), sehingga FAM
+// boleh muncul sebelum atau sesudah INDI yang dirujuknya. Penulis juga streaming lewat buffer.
+// Teks dianggap UTF-8 (HEAD CHAR ANSEL tidak dikonversi).
+// -----------------------------------------------------------------------------
+#include <string>
+
+#include "model.h"
+
+// true jika path berakhiran ".ged" (huruf besar/kecil sama saja)
+bool IsGedcomPath(const std::string& path);
+
+// Mengisi model yang masih kosong dari file GEDCOM: people, strings, dan spouseLinks (indeks
+// belum dibangun; LoadData/ReloadData memanggil ini lewat ParseFile untuk file .ged).
+// - ID diambil dari angka di xref INDI (@I12@ -> 12) jika semuanya unik; jika tidak, orang
+//   diberi nomor ulang 1..N sesuai urutan file.
+// - Ayah/Ibu dari FAM yang dirujuk FAMC orang itu, atau FAM pertama yang mencantumkannya di CHIL.
+// - Pasangan mengikuti urutan FAMS, lalu FAM lain tempat orang itu menjadi HUSB/WIFE. FAM dengan
+//   DIV menjadikan keduanya mantan pasangan.
+// - NAME tanpa garis miring penanda nama keluarga, _ROLE (atau TITL) menjadi peran,
+//   Person::line = nomor baris INDI.
+// Mengembalikan false jika file tidak bisa dibuka.
+bool ReadGedcom(DataModel& model, const std::string& path);
+
+// Menulis model sebagai GEDCOM 5.5.1 (UTF-8). Setiap grup orang tua (Ayah, Ibu) dan setiap
+// pasangan menjadi satu FAM (pasangan yang juga orang tua anak-anaknya berbagi FAM yang sama).
+// Rujukan ke ID yang tidak ada di data tidak bisa ditulis dan hanya dihitung di log.
+bool ExportGedcom(const DataModel& model, const std::string& path);
@@ -0,0 +1,186 @@
+#include "generator.h"
+
+#include <algorithm>   // std::max untuk rata-rata anak, std::min untuk pencarian kerabat
+#include <deque>       // Antrian pasangan per generasi
+#include <fstream>     // Menulis file CSV
+#include <random>      // Generator angka acak deterministik
+
+// Nama depan (berselang-seling laki-laki/perempuan) dan nama keluarga. Daftar UTF-8 ikut dipakai
+// jika unicodeNames aktif, untuk menguji konversi teks dan lebar label.
+static const char* const GIVEN_NAMES[] = {
+    "Budi", "Siti", "Agus", "Dewi", "Joko", "Rina", "Hendra", "Wati", "Bambang", "Sri",
+    "Andi", "Ayu", "Rudi", "Lestari", "Eko", "Nur", "Hadi", "Indah", "Yusuf", "Fitri",
+};
+static const char* const FAMILY_NAMES[] = {
+    "Santoso", "Wijaya", "Saputra", "Hidayat", "Kusuma", "Pratama", "Nugroho", "Halim",
+    "Siregar", "Nasution", "Tanjung", "Lubis", "Harahap", "Sinaga", "Gunawan", "Setiawan",
+};
+static const char* const GIVEN_NAMES_UNICODE[] = {
+    "José", "Zoë", "Søren", "Ayşe", "Łukasz", "Μαρία", "Иван", "Ngọc", "Jürgen", "سارة", "Đức", "明华",
+};
+static const char* const FAMILY_NAMES_UNICODE[] = {
+    "Nguyễn", "Müller", "Łęcki", "Ōtani", "Петров", "Παπαδόπουλος", "王", "Ibáñez",
+};
+
+template <typename T, size_t N> static constexpr size_t CountOf(T (&)[N]) { return N; }
+
+namespace {
+
+// Pasangan yang bisa punya anak; Ayah/Ibu selalu terisi (anak orang tua tunggal tetap lahir dari pasangan)
+struct Couple {
+    int father;
+    int mother;
+    uint16_t family; // Nama keluarga yang diwariskan ke anak
+    uint16_t depth;  // Generasi pasangan ini (akar = 0)
+};
+
+class CsvGenerator {
+public:
+    CsvGenerator(std::ofstream& out, const GeneratorOptions& options)
+        : m_out(out), m_options(options), m_rng(options.seed), m_children(std::max(options.branching, 0.01)) {}
+
+    void Run(GeneratorStats& stats) {
+        for (int r = 0; r < m_options.roots && Room(2); ++r) AddRoot(stats);
+        while (m_nextId <= (int)m_options.people) {
+            if (m_queue.empty()) {
+                // Generasi habis (maxDepth/branching kecil): mulai keluarga akar baru
+                if (Room(2)) AddRoot(stats);
+                else WritePerson(m_nextId++, Given(Chance(0.5)), FamilyName(RandomFamily()), "Kerabat", Chance(0.5), 0, 0, "");
+                continue;
+            }
+            Couple c = m_queue.front();
+            m_queue.pop_front();
+            int kids = m_children(m_rng);
+            for (int k = 0; k < kids && Room(1); ++k) AddChild(c, stats);
+        }
+        Flush();
+        stats.people = (size_t)m_nextId - 1;
+    }
+
+private:
+    bool Room(int rows) const { return (size_t)m_nextId + rows - 1 <= m_options.people; }
+    bool Chance(double p) { return std::uniform_real_distribution<double>(0.0, 1.0)(m_rng) < p; }
+    uint16_t RandomFamily() {
+        size_t count = CountOf(FAMILY_NAMES) + (m_options.unicodeNames ? CountOf(FAMILY_NAMES_UNICODE) : 0);
+        return (uint16_t)(m_rng() % count);
+    }
+    const char* FamilyName(uint16_t family) const {
+        return family < CountOf(FAMILY_NAMES) ? FAMILY_NAMES[family] : FAMILY_NAMES_UNICODE[family - CountOf(FAMILY_NAMES)];
+    }
+    const char* Given(bool male) {
+        if (m_options.unicodeNames && Chance(0.3)) {
+            return GIVEN_NAMES_UNICODE[(m_rng() % (CountOf(GIVEN_NAMES_UNICODE) / 2)) * 2 + (male ? 0 : 1)];
+        }
+        return GIVEN_NAMES[(m_rng() % (CountOf(GIVEN_NAMES) / 2)) * 2 + (male ? 0 : 1)];
+    }
+
+    void AddRoot(GeneratorStats& stats) {
+        int a = m_nextId++, b = m_nextId++;
+        uint16_t family = RandomFamily();
+        WritePerson(a, Given(true), FamilyName(family), "Eyang", true, 0, 0, std::to_string(b));
+        WritePerson(b, Given(false), FamilyName(RandomFamily()), "Eyang", false, 0, 0, std::to_string(a));
+        m_queue.push_back({ a, b, family, 0 });
+        stats.roots++;
+        stats.marriages++;
+    }
+
+    void AddChild(const Couple& c, GeneratorStats& stats) {
+        int id = m_nextId++;
+        bool male = Chance(0.5);
+        int depth = c.depth + 1;
+        if (depth > stats.depth) stats.depth = depth;
+
+        int father = c.father, mother = c.mother;
+        if (Chance(m_options.singleParentRate)) {
+            (Chance(0.5) ? father : mother) = 0;
+            stats.singleParent++;
+        }
+
+        // Pasangan dari luar keluarga (tanpa orang tua di data); menikah lagi = dua pasangan,
+        // yang pertama ditandai 'x' di kedua sisi
+        int first = 0, second = 0;
+        const Couple* relative = nullptr;
+        if (Room(1) && Chance(m_options.marriageRate)) {
+            first = m_nextId++;
+            if (m_options.consanguinityRate > 0 && Chance(m_options.consanguinityRate)) relative = FindRelativeCouple(c);
+            if (Room(1) && Chance(m_options.remarriageRate)) second = m_nextId++;
+        }
+        std::string spouses;
+        if (first) spouses = std::to_string(first) + (second ? "x|" + std::to_string(second) : "");
+        WritePerson(id, Given(male), FamilyName(c.family), "Anak", male, father, mother, spouses);
+
+        for (int s : { first, second }) {
+            if (!s) continue;
+            bool ex = (s == first && second != 0);
+            std::string spouse = std::to_string(id) + (ex ? "x" : "");
+            if (s == first && relative) {
+                // Sepupu: anak tambahan pasangan kerabat, lahir di generasi yang sama
+                WritePerson(s, Given(!male), FamilyName(relative->family), "Anak", !male, relative->father, relative->mother, spouse);
+                stats.consanguineous++;
+            } else {
+                WritePerson(s, Given(!male), FamilyName(RandomFamily()), "Menantu", !male, 0, 0, spouse);
+            }
+            stats.marriages++;
+            if (ex) stats.divorces++;
+            if (depth < m_options.maxDepth) {
+                m_queue.push_back({ male ? id : s, male ? s : id, c.family, (uint16_t)depth });
+            }
+        }
+    }
+
+    // Pasangan lain dari keluarga yang sama dan generasi yang sama di antrian (anak-anaknya sepupu
+    // anak c), atau nullptr. Hanya melihat awal antrian: generasi c ada di depan (FIFO).
+    const Couple* FindRelativeCouple(const Couple& c) const {
+        size_t limit = std::min<size_t>(m_queue.size(), 64);
+        for (size_t k = 0; k < limit; ++k) {
+            const Couple& other = m_queue[k];
+            if (other.family == c.family && other.depth == c.depth) return &other;
+        }
+        return nullptr;
+    }
+
+    void WritePerson(int id, const char* given, const char* family, const char* role, bool male,
+                     int father, int mother, const std::string& spouses) {
+        m_buf += std::to_string(id);
+        m_buf += ',';
+        m_buf += given;
+        m_buf += ' ';
+        m_buf += family;
+        m_buf += ',';
+        m_buf += role;
+        m_buf += male ? ",M," : ",F,";
+        m_buf += std::to_string(father);
+        m_buf += ',';
+        m_buf += std::to_string(mother);
+        m_buf += ',';
+        m_buf += spouses.empty() ? "0" : spouses;
+        m_buf += '\n';
+        if (m_buf.size() >= (1u << 20)) Flush();
+    }
+
+    void Flush() {
+        m_out.write(m_buf.data(), (std::streamsize)m_buf.size());
+        m_buf.clear();
+    }
+
+    std::ofstream& m_out;
+    const GeneratorOptions& m_options;
+    std::mt19937 m_rng;
+    std::poisson_distribution<int> m_children;
+    std::deque<Couple> m_queue; // FIFO: generasi terisi merata sebelum turun ke generasi berikutnya
+    std::string m_buf;          // Baris yang belum ditulis (ditulis per ~1 MB)
+    int m_nextId = 1;
+};
+
+} // namespace
+
+bool GenerateFamilyCsv(const std::string& path, const GeneratorOptions& options, GeneratorStats* stats) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    out << "ID,Name,Role,Gender,FatherID,MotherID,SpouseID\n";
+
+    GeneratorStats local;
+    CsvGenerator(out, options).Run(local);
+    if (stats) *stats = local;
+    return (bool)out;
+}
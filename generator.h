@@ -0,0 +1,41 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// GENERATOR (Membuat Family.csv sintetis yang menyerupai silsilah sungguhan)
+// Pohon tumbuh per generasi dari pasangan akar: setiap pasangan punya sejumlah anak (rata-rata
+// `branching`), sebagian anak menikah dengan orang dari luar keluarga, sebagian bercerai dan
+// menikah lagi (pasangan pertama ditandai 'x'), sebagian hanya mencantumkan satu orang tua, dan
+// (jika diaktifkan) sebagian menikah dengan kerabat sehingga ada keturunan yang inbred.
+// Hasilnya deterministik untuk seed yang sama, dan ditulis bertahap (memori tidak sebesar file).
+// -----------------------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct GeneratorOptions {
+    size_t people = 100000;         // Jumlah baris orang yang ditulis
+    int roots = 4;                  // Pasangan akar awal (ditambah otomatis jika generasi habis sebelum `people` tercapai)
+    int maxDepth = 12;              // Jumlah generasi maksimum di bawah akar
+    double branching = 2.5;         // Rata-rata anak per pasangan (distribusi Poisson)
+    double marriageRate = 0.7;      // Peluang seorang anak menikah
+    double remarriageRate = 0.1;    // Peluang orang yang menikah bercerai lalu menikah lagi
+    double singleParentRate = 0.05; // Peluang anak hanya mencantumkan Ayah atau Ibu saja
+    double consanguinityRate = 0;   // Peluang anak menikah dengan sepupu (anak pasangan lain dari keluarga yang sama), bukan orang luar
+    bool unicodeNames = false;      // Campur nama beraksara non-ASCII (UTF-8)
+    uint32_t seed = 12345;          // Seed generator acak
+};
+
+// Ringkasan isi file yang dibuat
+struct GeneratorStats {
+    size_t people = 0;
+    size_t roots = 0;       // Pasangan akar (termasuk yang ditambah otomatis)
+    size_t marriages = 0;   // Jumlah pernikahan (termasuk yang sudah bercerai)
+    size_t divorces = 0;    // Pasangan yang ditandai 'x'
+    size_t singleParent = 0;
+    size_t consanguineous = 0; // Pernikahan antar kerabat
+    int depth = 0;          // Generasi terdalam yang terisi
+};
+
+// Menulis CSV berformat ID,Name,Role,Gender,FatherID,MotherID,SpouseID. Mengembalikan false
+// jika file tidak bisa ditulis.
+bool GenerateFamilyCsv(const std::string& path, const GeneratorOptions& options, GeneratorStats* stats = nullptr);
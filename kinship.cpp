@@ -0,0 +1,239 @@
+#include "kinship.h"
+#include "parallel.h"
+#include "stats.h"
+
+#include <algorithm>   // std::max/min untuk pembagian tugas
+#include <chrono>      // Untuk mengukur durasi Build
+
+static const uint32_t NONE = DataModel::NO_INDEX;
+static const size_t CHUNK_PEOPLE = 4096;       // Orang/pasangan per tugas thread
+static const size_t PARALLEL_MIN = 2 * CHUNK_PEOPLE; // Generasi yang lebih kecil dihitung satu thread saja
+static const size_t MEMO_LIMIT = 1 << 20;      // Slot maksimum tabel hasil antara per thread (16 byte per slot)
+
+namespace {
+
+// Tabel hash phi per thread dengan kunci (indeks kecil << 32 | indeks besar). Tumbuh sampai
+// MEMO_LIMIT slot; setelah itu dikosongkan saat penuh (hasil dihitung ulang bila diperlukan lagi).
+class KinshipMemo {
+public:
+    bool Find(uint64_t key, double& value) const {
+        if (m_slots.empty()) return false;
+        size_t mask = m_slots.size() - 1;
+        for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+            if (m_slots[i].key == key) { value = m_slots[i].value; return true; }
+            if (m_slots[i].key == EMPTY) return false;
+        }
+    }
+
+    void Put(uint64_t key, double value) {
+        if ((m_count + 1) * 4 > m_slots.size() * 3) {
+            if (m_slots.size() < MEMO_LIMIT) Rehash(std::max<size_t>(m_slots.size() * 2, 1 << 10));
+            else { std::fill(m_slots.begin(), m_slots.end(), Slot()); m_count = 0; m_clears++; }
+        }
+        size_t mask = m_slots.size() - 1;
+        size_t i = Hash(key) & mask;
+        while (m_slots[i].key != EMPTY && m_slots[i].key != key) i = (i + 1) & mask;
+        if (m_slots[i].key == EMPTY) m_count++;
+        m_slots[i] = { key, value };
+    }
+
+    size_t Clears() const { return m_clears; }
+
+private:
+    static constexpr uint64_t EMPTY = ~0ull; // Tidak mungkin kunci: indeks kecil selalu < indeks besar
+    struct Slot {
+        uint64_t key = EMPTY;
+        double value = 0;
+    };
+    static size_t Hash(uint64_t key) {
+        uint64_t h = key * 0x9E3779B97F4A7C15ull;
+        return (size_t)(h ^ (h >> 32));
+    }
+    void Rehash(size_t capacity) {
+        std::vector<Slot> old(capacity);
+        old.swap(m_slots);
+        size_t mask = capacity - 1;
+        for (const Slot& slot : old) {
+            if (slot.key == EMPTY) continue;
+            size_t i = Hash(slot.key) & mask;
+            while (m_slots[i].key != EMPTY) i = (i + 1) & mask;
+            m_slots[i] = slot;
+        }
+    }
+
+    std::vector<Slot> m_slots; // Ukuran selalu pangkat dua
+    size_t m_count = 0;
+    size_t m_clears = 0;
+};
+
+// Penghitung phi untuk satu thread. Hanya membaca F orang yang lebih tua dari pasangan yang
+// ditanyakan, jadi aman dipakai selagi F generasi yang sedang berjalan diisi thread lain.
+class KinshipSolver {
+public:
+    KinshipSolver(const PedigreeIndex& pedigree, const std::vector<double>& inbreeding)
+        : m_pedigree(pedigree), m_inbreeding(inbreeding) {}
+
+    double Kinship(uint32_t a, uint32_t b) {
+        double value;
+        if (Known(a, b, value)) return value;
+        Push(a, b);
+        for (;;) {
+            Frame& top = m_stack.back();
+            if (top.next < 2) {
+                uint32_t parent = (top.next++ == 0) ? m_pedigree.Father(top.young) : m_pedigree.Mother(top.young);
+                uint32_t other = top.other;
+                if (Known(parent, other, value)) top.sum += value;
+                else Push(parent, other); // top tidak dipakai lagi setelah ini (stack bisa pindah)
+                continue;
+            }
+            value = top.sum * 0.5;
+            m_memo.Put(Key(top.young, top.other), value);
+            m_computed++;
+            m_stack.pop_back();
+            if (m_stack.empty()) return value;
+            m_stack.back().sum += value;
+        }
+    }
+
+    size_t Computed() const { return m_computed; }
+    size_t Clears() const { return m_memo.Clears(); }
+
+private:
+    struct Frame {
+        uint32_t young; // Yang diganti orang tuanya (bukan leluhur other)
+        uint32_t other;
+        uint8_t next;   // 0 = Ayah berikutnya, 1 = Ibu, 2 = selesai
+        double sum;
+    };
+
+    static uint64_t Key(uint32_t a, uint32_t b) {
+        if (a > b) std::swap(a, b);
+        return ((uint64_t)a << 32) | b;
+    }
+    // Lebih muda: generasi lebih besar, atau generasi sama dan indeks lebih besar
+    bool Younger(uint32_t a, uint32_t b) const {
+        int ga = m_pedigree.Generation(a), gb = m_pedigree.Generation(b);
+        return ga > gb || (ga == gb && a > b);
+    }
+
+    // Nilai yang tidak perlu rekursi: orang tua yang tidak ada, diri sendiri, orang termuda tanpa
+    // orang tua, pasangan tanpa leluhur bersama, atau yang sudah ada di tabel
+    bool Known(uint32_t a, uint32_t b, double& value) {
+        value = 0;
+        if (a == NONE || b == NONE) return true;
+        if (a == b) { value = 0.5 * (1.0 + m_inbreeding[a]); return true; }
+        uint32_t young = Younger(a, b) ? a : b;
+        if (m_pedigree.Father(young) == NONE && m_pedigree.Mother(young) == NONE) return true;
+        if (m_pedigree.SimpleLine(a) && m_pedigree.SimpleLine(b) && !m_pedigree.Relate(a, b).related) return true;
+        return m_memo.Find(Key(a, b), value);
+    }
+
+    void Push(uint32_t a, uint32_t b) {
+        bool swap = Younger(b, a);
+        m_stack.push_back({ swap ? b : a, swap ? a : b, 0, 0.0 });
+    }
+
+    const PedigreeIndex& m_pedigree;
+    const std::vector<double>& m_inbreeding;
+    KinshipMemo m_memo;
+    std::vector<Frame> m_stack;
+    size_t m_computed = 0;
+};
+
+} // namespace
+
+void KinshipIndex::Clear() {
+    m_pedigree = nullptr;
+    m_inbreeding.clear();
+    m_stats = KinshipStats();
+}
+
+void KinshipIndex::Build(const PedigreeIndex& pedigree, unsigned threads) {
+    ScopedTimer timer(Stage::Kinship);
+    auto t0 = std::chrono::steady_clock::now();
+    Clear();
+    m_pedigree = &pedigree;
+    size_t n = pedigree.Size();
+    threads = ResolveThreads(threads);
+    m_inbreeding.assign(n, 0.0);
+    m_stats.people = n;
+
+    // Orang dengan Ayah dan Ibu dikelompokkan per generasi (CSR, urut indeks di tiap generasi)
+    int maxGeneration = 0;
+    for (size_t i = 0; i < n; ++i) maxGeneration = std::max(maxGeneration, pedigree.Generation(i));
+    std::vector<uint32_t> generationStart((size_t)maxGeneration + 2, 0), byGeneration;
+    auto bothParents = [&](size_t i) { return pedigree.Father(i) != NONE && pedigree.Mother(i) != NONE; };
+    for (size_t i = 0; i < n; ++i) {
+        if (bothParents(i)) generationStart[(size_t)pedigree.Generation(i) + 1]++;
+    }
+    for (size_t g = 0; g + 1 < generationStart.size(); ++g) generationStart[g + 1] += generationStart[g];
+    byGeneration.resize(generationStart.back());
+    {
+        std::vector<uint32_t> fill(generationStart.begin(), generationStart.end() - 1);
+        for (size_t i = 0; i < n; ++i) {
+            if (bothParents(i)) byGeneration[fill[(size_t)pedigree.Generation(i)]++] = (uint32_t)i;
+        }
+    }
+    m_stats.bothParents = byGeneration.size();
+
+    // Generasi demi generasi: F satu generasi hanya membaca F generasi sebelumnya
+    std::vector<KinshipSolver> solvers(threads, KinshipSolver(pedigree, m_inbreeding));
+    auto inbreeding = [&](uint32_t x, KinshipSolver& solver) {
+        m_inbreeding[x] = solver.Kinship(pedigree.Father(x), pedigree.Mother(x));
+    };
+    for (size_t g = 1; g + 1 < generationStart.size(); ++g) {
+        size_t begin = generationStart[g], count = generationStart[g + 1] - begin;
+        if (count < PARALLEL_MIN || threads == 1) {
+            for (size_t k = begin; k < begin + count; ++k) inbreeding(byGeneration[k], solvers[0]);
+            continue;
+        }
+        ParallelFor((count + CHUNK_PEOPLE - 1) / CHUNK_PEOPLE, threads, [&](size_t c, unsigned w) {
+            size_t end = begin + std::min(count, (c + 1) * CHUNK_PEOPLE);
+            for (size_t k = begin + c * CHUNK_PEOPLE; k < end; ++k) inbreeding(byGeneration[k], solvers[w]);
+        });
+    }
+
+    double total = 0;
+    for (double f : m_inbreeding) {
+        total += f;
+        if (f > 0) m_stats.inbred++;
+        m_stats.maxInbreeding = std::max(m_stats.maxInbreeding, f);
+    }
+    m_stats.meanInbreeding = n ? total / (double)n : 0;
+    for (const KinshipSolver& solver : solvers) {
+        m_stats.pairsComputed += solver.Computed();
+        m_stats.memoClears += solver.Clears();
+    }
+    m_stats.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+double KinshipIndex::Kinship(size_t a, size_t b) const {
+    KinshipSolver solver(*m_pedigree, m_inbreeding);
+    return solver.Kinship((uint32_t)a, (uint32_t)b);
+}
+
+void KinshipIndex::KinshipBatch(const std::vector<std::pair<uint32_t, uint32_t>>& pairs, std::vector<double>& out,
+                                unsigned threads) const {
+    threads = ResolveThreads(threads);
+    out.resize(pairs.size());
+    std::vector<KinshipSolver> solvers(threads, KinshipSolver(*m_pedigree, m_inbreeding));
+    ParallelFor((pairs.size() + CHUNK_PEOPLE - 1) / CHUNK_PEOPLE, threads, [&](size_t c, unsigned w) {
+        for (size_t k = c * CHUNK_PEOPLE; k < std::min(pairs.size(), (c + 1) * CHUNK_PEOPLE); ++k) {
+            out[k] = solvers[w].Kinship(pairs[k].first, pairs[k].second);
+        }
+    });
+}
+
+void KinshipIndex::KinshipMatrix(const std::vector<uint32_t>& people, std::vector<double>& out, unsigned threads) const {
+    threads = ResolveThreads(threads);
+    size_t k = people.size();
+    out.assign(k * k, 0.0);
+    std::vector<KinshipSolver> solvers(threads, KinshipSolver(*m_pedigree, m_inbreeding));
+    // Satu tugas per baris: bagian atas diagonal dihitung, lalu dicerminkan
+    ParallelFor(k, threads, [&](size_t i, unsigned w) {
+        for (size_t j = i; j < k; ++j) out[i * k + j] = solvers[w].Kinship(people[i], people[j]);
+    });
+    for (size_t i = 0; i < k; ++i) {
+        for (size_t j = 0; j < i; ++j) out[i * k + j] = out[j * k + i];
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// KINSHIP (Koefisien kekerabatan dan inbreeding untuk seluruh silsilah)
+// Koefisien kekerabatan phi(a, b) = peluang satu alel acak dari a dan satu dari b identik karena
+// keturunan; koefisien inbreeding F(x) = phi(Ayah x, Ibu x). Rumusnya rekursif: phi(a, a) =
+// (1 + F(a)) / 2, dan untuk a != b, orang yang lebih muda (generasi lalu indeks lebih besar, jadi
+// bukan leluhur yang lain) diganti kedua orang tuanya: phi(a, b) = (phi(Ayah a, b) + phi(Ibu a, b)) / 2.
+// Orang tua yang tidak ada di data dianggap tidak berkerabat dengan siapa pun (phi = 0).
+// - Rekursi dijalankan dengan stack sendiri (garis keturunan sepanjang apa pun aman).
+// - Pasangan yang tidak punya leluhur bersama langsung bernilai 0 lewat PedigreeIndex (O(log n)
+//   untuk garis sederhana), jadi menantu tanpa leluhur tidak pernah ditelusuri.
+// - Hasil antara disimpan di tabel hash per thread (hanya pasangan yang pernah dihitung). Tabel
+//   dikosongkan jika penuh, sehingga memori tetap terbatas berapa pun ukuran data.
+// - F dihitung per generasi: orang dalam satu generasi tidak saling bergantung (hanya membaca F
+//   leluhurnya), jadi generasi yang besar dibagi ke beberapa thread.
+// Hasilnya sama untuk berapa pun jumlah thread. Semua fungsi memakai indeks people (bukan ID).
+// -----------------------------------------------------------------------------
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "pedigree.h"
+
+struct KinshipStats {
+    size_t people = 0;
+    size_t bothParents = 0;    // Orang dengan Ayah dan Ibu di data (hanya mereka yang bisa inbred)
+    size_t inbred = 0;         // Orang dengan F > 0
+    double maxInbreeding = 0;
+    double meanInbreeding = 0; // Rata-rata F seluruh orang
+    size_t pairsComputed = 0;  // Pasangan yang dihitung lewat rekursi (bukan dari tabel/jalan pintas)
+    size_t memoClears = 0;     // Berapa kali tabel hasil antara penuh lalu dikosongkan
+    double ms = 0;
+};
+
+class KinshipIndex {
+public:
+    // Menghitung F semua orang. pedigree harus tetap ada (dan tidak dibangun ulang) selama
+    // index ini dipakai. threads: 0 = otomatis.
+    void Build(const PedigreeIndex& pedigree, unsigned threads = 0);
+    void Clear();
+    size_t Size() const { return m_inbreeding.size(); }
+    const KinshipStats& Stats() const { return m_stats; }
+
+    double Inbreeding(size_t index) const { return m_inbreeding[index]; }
+
+    // Satu pasangan (phi(a, a) = (1 + F(a)) / 2)
+    double Kinship(size_t a, size_t b) const;
+    // Banyak pasangan sekaligus, dibagi ke beberapa thread (0 = otomatis)
+    void KinshipBatch(const std::vector<std::pair<uint32_t, uint32_t>>& pairs, std::vector<double>& out,
+                      unsigned threads = 0) const;
+    // Matriks kekerabatan k x k untuk daftar orang (out[i * k + j], simetris), dibagi per baris
+    void KinshipMatrix(const std::vector<uint32_t>& people, std::vector<double>& out, unsigned threads = 0) const;
+
+private:
+    const PedigreeIndex* m_pedigree = nullptr;
+    std::vector<double> m_inbreeding;
+    KinshipStats m_stats;
+};
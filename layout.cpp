@@ -0,0 +1,838 @@
+#include "layout.h"
+#include "parallel.h"
+#include "stats.h"
+
+#include <algorithm>   // Untuk fungsi matematika seperti std::max
+#include <atomic>      // Penghitung statistik yang dijumlahkan dari thread layout
+#include <chrono>      // Waktu per tahap untuk LayoutStats
+#include <iostream>    // Untuk output ke console (debugging)
+#include <sstream>     // Pesan siklus disusun dulu agar tidak bercampur antar thread
+
+// -----------------------------------------------------------------------------
+// LAYOUT ENGINE (Logika Penempatan Pohon)
+// -----------------------------------------------------------------------------
+
+ChildRange GetChildren(const DataModel& model, int fatherId, int motherId) {
+    return model.Children(fatherId, motherId);
+}
+
+bool IsCollapsed(const DataModel& model, int personId) {
+    size_t index = model.IndexOf(personId);
+    return index != IdIndex::NPOS && model.collapsed[index];
+}
+
+bool HasChildren(const DataModel& model, size_t index) {
+    const Person& p = model.people[index];
+    bool male = (p.gender == Gender::Male);
+    for (const SpouseLink& sp : model.Spouses(p)) {
+        if (!GetChildren(model, male ? p.id : sp.id, male ? sp.id : p.id).empty()) return true;
+    }
+    return !GetChildren(model, male ? p.id : 0, (p.gender == Gender::Female) ? p.id : 0).empty();
+}
+
+const char* LayoutModeName(LayoutMode mode) {
+    return (mode == LayoutMode::Compact) ? "compact" : "classic";
+}
+
+bool ParseLayoutMode(std::string_view text, LayoutMode& mode) {
+    if (text == "classic") mode = LayoutMode::Classic;
+    else if (text == "compact") mode = LayoutMode::Compact;
+    else return false;
+    return true;
+}
+
+// Semua buffer kerja dan penghitung di bawah ini per thread (thread_local), sehingga layout
+// paralel per keluarga akar tidak saling berbagi state.
+static thread_local size_t s_widthsComputed = 0; // Jumlah lebar sub-pohon yang benar-benar dihitung (untuk statistik)
+static thread_local size_t s_cyclesFound = 0;    // Jumlah siklus orang tua yang dilewati (data rusak)
+static thread_local double s_widthsMs = 0;        // Waktu CalculateSubtreeWidth / kontur kompak (untuk statistik)
+static thread_local double s_positionMs = 0;      // Waktu PositionSubtree / penempatan kompak (untuk statistik)
+
+using Clock = std::chrono::steady_clock;
+static double ElapsedMs(Clock::time_point start, Clock::time_point end = Clock::now()) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Buffer kerja yang dipakai ulang antar pemanggilan: traversal memakai stack eksplisit
+// (bukan rekursi) agar silsilah sepanjang apa pun tidak membuat stack overflow
+struct WidthFrame {
+    size_t index;          // Indeks orang di model.people
+    size_t kidBegin;       // Daftar anak orang ini ada di s_kids[kidBegin .. kidEnd)
+    size_t kidEnd;
+    size_t cursor;         // Anak berikutnya yang akan diproses
+    int childrenTotal;     // Akumulasi lebar anak-anak yang sudah selesai
+};
+struct PlaceFrame {
+    size_t kidBegin;
+    size_t kidEnd;
+    size_t cursor;
+    int childStartX;       // Posisi X anak berikutnya
+    int childY;            // Posisi Y seluruh anak (satu generasi di bawah)
+};
+static thread_local std::vector<uint32_t> s_kids;         // Indeks anak dari semua frame aktif, bertumpuk seperti stack
+static thread_local std::vector<WidthFrame> s_widthStack;
+static thread_local std::vector<PlaceFrame> s_placeStack;
+static thread_local std::vector<unsigned char> s_inProgress; // 1 = lebar orang ini sedang dihitung (untuk deteksi siklus)
+
+// Menambahkan indeks anak seseorang ke s_kids dengan urutan yang sama seperti urutan penempatan:
+// anak per pasangan (sesuai urutan pasangan), lalu anak tanpa pasangan terdaftar.
+// Anak yang ID-nya tidak ada di data dicatat sebagai NO_INDEX. Anak dari orang yang diciutkan
+// (atau dari pasangan yang diciutkan) dilewati: keturunan yang tersembunyi tidak dihitung
+// lebarnya dan tidak ditempatkan sama sekali.
+static void PushChildren(const DataModel& model, size_t index) {
+    if (model.collapsed[index]) return;
+    const Person& p = model.people[index];
+    auto push = [&](ChildRange children) {
+        for (int childId : children) {
+            size_t c = model.IndexOf(childId);
+            s_kids.push_back(c == IdIndex::NPOS ? DataModel::NO_INDEX : (uint32_t)c);
+        }
+    };
+    bool male = (p.gender == Gender::Male);
+    for (const SpouseLink& sp : model.Spouses(p)) {
+        if (IsCollapsed(model, sp.id)) continue;
+        push(GetChildren(model, male ? p.id : sp.id, male ? sp.id : p.id));
+    }
+    push(GetChildren(model, male ? p.id : 0, (p.gender == Gender::Female) ? p.id : 0));
+}
+
+// Lebar blok orang tua: Lebar kotak + (Jumlah pasangan * lebar kotak mereka)
+static int ParentsBlockWidth(const Person& p) {
+    return BOX_WIDTH + ((int)p.spouseCount * (BOX_WIDTH + SPOUSE_GAP));
+}
+
+int CalculateSubtreeWidth(DataModel& model, int personId) {
+    size_t rootIndex = model.IndexOf(personId);
+    if (rootIndex == IdIndex::NPOS) return 0;
+    if (model.widthValid[rootIndex]) return model.subtreeWidth[rootIndex]; // Masih berlaku
+    if (s_inProgress.size() != model.people.size()) s_inProgress.assign(model.people.size(), 0);
+
+    auto enter = [&](size_t index) {
+        s_widthsComputed++;
+        s_inProgress[index] = 1;
+        size_t kidBegin = s_kids.size();
+        PushChildren(model, index);
+        s_widthStack.push_back({ index, kidBegin, s_kids.size(), kidBegin, 0 });
+    };
+
+    // Post-order: lebar seseorang baru dihitung setelah lebar semua anaknya selesai
+    int result = 0;
+    enter(rootIndex);
+    while (!s_widthStack.empty()) {
+        WidthFrame& top = s_widthStack.back();
+        if (top.cursor < top.kidEnd) {
+            uint32_t c = s_kids[top.cursor++];
+            if (c == DataModel::NO_INDEX) { top.childrenTotal += H_GAP; continue; } // Anak tak dikenal: lebar 0
+            if (model.widthValid[c]) { top.childrenTotal += model.subtreeWidth[c] + H_GAP; continue; }
+            if (s_inProgress[c]) {
+                // Keturunan yang juga leluhur: lewati agar tidak berputar selamanya
+                s_cyclesFound++;
+                std::ostringstream msg;
+                msg << "[LAYOUT] Cycle detected: ID " << model.people[c].id << " is its own ancestor, link ignored\n";
+                if (LogEnabled(LogLevel::Info)) std::cout << msg.str();
+                continue;
+            }
+            enter(c); // top tidak boleh dipakai lagi setelah ini (vector bisa berpindah)
+            continue;
+        }
+
+        size_t index = top.index;
+        int childrenTotalWidth = top.childrenTotal;
+        if (childrenTotalWidth > 0) childrenTotalWidth -= H_GAP;
+        // Lebar pohon adalah yang terbesar antara lebar barisan orang tua vs barisan anak
+        result = std::max(ParentsBlockWidth(model.people[index]), childrenTotalWidth);
+        model.subtreeWidth[index] = result;
+        model.widthValid[index] = 1;
+        s_inProgress[index] = 0;
+        s_kids.resize(top.kidBegin); // Frame ini selalu yang teratas, jadi daftar anaknya ada di ujung
+        s_widthStack.pop_back();
+        if (!s_widthStack.empty()) s_widthStack.back().childrenTotal += result + H_GAP;
+    }
+    return result;
+}
+
+// owner (opsional): setiap orang yang ditempatkan dicatat milik akar ownerRoot (dipakai layout paralel)
+static void PositionFrom(DataModel& model, size_t rootIndex, int x, int y, uint32_t* owner, uint32_t ownerRoot) {
+    // Pre-order: orang (dan pasangannya) ditempatkan dulu, lalu anak-anak dari kiri ke kanan
+    auto enter = [&](size_t index, int px, int py) {
+        if (model.placed[index]) return; // Sudah ditempatkan (juga memutus siklus)
+        const Person& p = model.people[index];
+
+        model.posY[index] = py;
+        model.placed[index] = 1;
+        if (owner) owner[index] = ownerRoot;
+        // Menengahkan posisi orang tua terhadap lebar total sub-pohon mereka
+        int personX = px + (model.subtreeWidth[index] / 2) - (ParentsBlockWidth(p) / 2);
+        model.posX[index] = personX;
+
+        // Mengatur posisi pasangan di sebelah kanan orang pertama
+        int spouseStartX = personX + BOX_WIDTH + SPOUSE_GAP;
+        for (const SpouseLink& link : model.Spouses(p)) {
+            size_t sp = model.IndexOf(link.id);
+            if (sp != IdIndex::NPOS) {
+                model.posX[sp] = spouseStartX;
+                model.posY[sp] = py;
+                model.placed[sp] = 1;
+                if (owner) owner[sp] = ownerRoot;
+                spouseStartX += BOX_WIDTH + SPOUSE_GAP;
+            }
+        }
+
+        size_t kidBegin = s_kids.size();
+        PushChildren(model, index);
+        s_placeStack.push_back({ kidBegin, s_kids.size(), kidBegin, px, py + V_GAP });
+    };
+
+    enter(rootIndex, x, y);
+    while (!s_placeStack.empty()) {
+        PlaceFrame& top = s_placeStack.back();
+        if (top.cursor == top.kidEnd) {
+            s_kids.resize(top.kidBegin);
+            s_placeStack.pop_back();
+            continue;
+        }
+        uint32_t c = s_kids[top.cursor++];
+        if (c == DataModel::NO_INDEX) continue;
+        // Lebar anak tidak berubah selama penempatan, jadi posisi saudara berikutnya bisa dimajukan dulu
+        int childX = top.childStartX, childY = top.childY;
+        top.childStartX += model.subtreeWidth[c] + H_GAP;
+        enter(c, childX, childY); // top tidak boleh dipakai lagi setelah ini
+    }
+}
+
+void PositionSubtree(DataModel& model, int personId, int x, int y) {
+    size_t rootIndex = model.IndexOf(personId);
+    if (rootIndex == IdIndex::NPOS) return;
+    PositionFrom(model, rootIndex, x, y, nullptr, 0);
+}
+
+// -----------------------------------------------------------------------------
+// LAYOUT KOMPAK (Kontur sub-pohon per generasi, gaya Reingold-Tilford)
+// Urutan kunjungan dan aturan "sudah ditempatkan" sama persis dengan PositionFrom, jadi orang
+// yang ditempatkan (dan pasangan yang dipindah ke samping pasangan berikutnya) sama. Bedanya,
+// sub-pohon tidak memesan kotak selebar generasi terlebarnya: setiap anak hanya didorong ke
+// kanan sejauh yang diperlukan agar di setiap generasi yang sama-sama dimiliki berjarak H_GAP
+// dari kontur kanan saudara-saudara sebelumnya, lalu blok orang tua (beserta pasangannya)
+// ditengahkan di atas barisan anaknya.
+// Kontur disimpan per generasi dengan satu offset per kontur, generasi terdalam di depan
+// vector sehingga menambah orang tua cukup push_back. Menggabungkan dua kontur hanya menyentuh
+// generasi yang dimiliki keduanya dan mengambil alih vector yang lebih dalam, jadi seperti
+// pada Reingold-Tilford total biayanya O(N).
+// -----------------------------------------------------------------------------
+
+// Batas kiri dan kanan satu generasi sebuah sub-pohon (ditambah Contour::offset)
+struct Extent {
+    int left;
+    int right;
+};
+struct Contour {
+    std::vector<Extent> levels; // levels.back() = generasi teratas (blok orang tua sub-pohon)
+    int offset = 0;
+};
+// Satu blok orang tua yang ditempatkan, urut pre-order
+struct CompactUnit {
+    uint32_t index;  // Orang yang memimpin blok (pasangannya di sebelah kanan)
+    uint32_t parent; // Posisi unit orang tuanya di s_units (NO_INDEX untuk akar)
+    int shift;       // X unit ini di barisan saudaranya (saudara pertama = 0)
+    int center;      // X unit ini di barisan anaknya sendiri (anak pertama = 0)
+    int x;           // X akhir
+};
+struct CompactFrame {
+    uint32_t unit;
+    size_t kidBegin;
+    size_t kidEnd;
+    size_t cursor;
+    int childY;
+    int forest;      // Kontur gabungan anak-anak yang sudah selesai (-1 = belum ada)
+};
+static thread_local std::vector<CompactUnit> s_units;
+static thread_local std::vector<CompactFrame> s_compactStack;
+static thread_local std::vector<Contour> s_contours;  // Dipakai ulang antar pemanggilan (kapasitas tetap)
+static thread_local std::vector<int> s_freeContours;
+
+static int NewContour() {
+    if (s_freeContours.empty()) {
+        s_contours.emplace_back();
+        return (int)s_contours.size() - 1;
+    }
+    int h = s_freeContours.back();
+    s_freeContours.pop_back();
+    s_contours[h].levels.clear();
+    s_contours[h].offset = 0;
+    return h;
+}
+
+// Meletakkan kontur sub-pohon `tree` di kanan kontur `forest` sedekat mungkin. shift = X
+// sub-pohon itu di barisan. Mengembalikan kontur gabungan; kontur lainnya kembali ke pool.
+static int MergeContours(int forest, int tree, int& shift) {
+    Contour& f = s_contours[forest];
+    Contour& t = s_contours[tree];
+    size_t hf = f.levels.size(), ht = t.levels.size(), common = std::min(hf, ht);
+    Extent* fl = f.levels.data() + hf - 1; // fl[-d] = generasi d
+    Extent* tl = t.levels.data() + ht - 1;
+    shift = fl[0].right + f.offset + H_GAP - (tl[0].left + t.offset);
+    for (size_t d = 1; d < common; ++d) {
+        shift = std::max(shift, fl[-(ptrdiff_t)d].right + f.offset + H_GAP - (tl[-(ptrdiff_t)d].left + t.offset));
+    }
+    if (ht > hf) {
+        // Sub-pohon baru lebih dalam: vector-nya dipakai, sisi kiri generasi bersama dari forest
+        t.offset += shift;
+        for (size_t d = 0; d < common; ++d) tl[-(ptrdiff_t)d].left = fl[-(ptrdiff_t)d].left + f.offset - t.offset;
+        s_freeContours.push_back(forest);
+        return tree;
+    }
+    for (size_t d = 0; d < common; ++d) fl[-(ptrdiff_t)d].right = tl[-(ptrdiff_t)d].right + t.offset + shift - f.offset;
+    s_freeContours.push_back(tree);
+    return forest;
+}
+
+// Menempatkan keluarga akar rootIndex dengan tepi kiri kontur di X = x. Mengembalikan lebarnya.
+static int PositionCompact(DataModel& model, size_t rootIndex, int x, int y, uint32_t* owner, uint32_t ownerRoot) {
+    if (model.placed[rootIndex]) return 0;
+    if (s_inProgress.size() != model.people.size()) s_inProgress.assign(model.people.size(), 0);
+    auto t0 = Clock::now();
+    s_units.clear();
+
+    // 1. Pre-order: tandai yang ditempatkan (seperti PositionFrom); post-order: kontur
+    auto enter = [&](size_t index, uint32_t parentUnit, int py) {
+        const Person& p = model.people[index];
+        model.posY[index] = py;
+        model.placed[index] = 1;
+        s_inProgress[index]++;
+        // Pasangan ikut "sedang diproses": keturunan yang ternyata pasangan leluhurnya adalah siklus
+        for (const SpouseLink& link : model.Spouses(p)) {
+            size_t sp = model.IndexOf(link.id);
+            if (sp != IdIndex::NPOS) { model.placed[sp] = 1; s_inProgress[sp]++; }
+        }
+        s_units.push_back({ (uint32_t)index, parentUnit, 0, 0, 0 });
+        size_t kidBegin = s_kids.size();
+        PushChildren(model, index);
+        s_compactStack.push_back({ (uint32_t)(s_units.size() - 1), kidBegin, s_kids.size(), kidBegin, py + V_GAP, -1 });
+    };
+
+    int rootContour = -1;
+    enter(rootIndex, DataModel::NO_INDEX, y);
+    while (!s_compactStack.empty()) {
+        CompactFrame& top = s_compactStack.back();
+        if (top.cursor < top.kidEnd) {
+            uint32_t c = s_kids[top.cursor++];
+            if (c == DataModel::NO_INDEX) continue;
+            if (model.placed[c]) {
+                if (s_inProgress[c]) {
+                    s_cyclesFound++;
+                    std::ostringstream msg;
+                    msg << "[LAYOUT] Cycle detected: ID " << model.people[c].id << " is its own ancestor, link ignored\n";
+                    if (LogEnabled(LogLevel::Info)) std::cout << msg.str();
+                }
+                continue; // Sudah ditempatkan di tempat lain (atau siklus)
+            }
+            enter(c, top.unit, top.childY); // top tidak boleh dipakai lagi setelah ini
+            continue;
+        }
+
+        // Semua anak selesai: blok orang tua ditengahkan di atas barisan anak langsungnya
+        CompactUnit& unit = s_units[top.unit];
+        int width = ParentsBlockWidth(model.people[unit.index]);
+        int h = top.forest;
+        if (h < 0) {
+            h = NewContour();
+        } else {
+            Contour& kids = s_contours[h];
+            const Extent& row = kids.levels.back();
+            unit.center = (row.left + row.right) / 2 + kids.offset - width / 2;
+            kids.offset -= unit.center;
+        }
+        Contour& own = s_contours[h];
+        own.levels.push_back({ -own.offset, width - own.offset });
+        s_inProgress[unit.index]--;
+        for (const SpouseLink& link : model.Spouses(model.people[unit.index])) {
+            size_t sp = model.IndexOf(link.id);
+            if (sp != IdIndex::NPOS) s_inProgress[sp]--;
+        }
+        s_kids.resize(top.kidBegin);
+        s_compactStack.pop_back();
+        if (s_compactStack.empty()) { rootContour = h; break; }
+
+        CompactFrame& parent = s_compactStack.back();
+        if (parent.forest < 0) parent.forest = h; // Anak pertama di X = 0
+        else parent.forest = MergeContours(parent.forest, h, unit.shift);
+    }
+    s_widthsComputed += s_units.size();
+
+    // Lebar keluarga = batas kiri/kanan terjauh di semua generasi (relatif terhadap blok akar)
+    const Contour& root = s_contours[rootContour];
+    int minLeft = root.levels[0].left, maxRight = root.levels[0].right;
+    for (const Extent& e : root.levels) {
+        minLeft = std::min(minLeft, e.left);
+        maxRight = std::max(maxRight, e.right);
+    }
+    minLeft += root.offset;
+    maxRight += root.offset;
+    s_freeContours.push_back(rootContour);
+    auto t1 = Clock::now();
+    s_widthsMs += ElapsedMs(t0, t1);
+
+    // 2. Pre-order: X akhir dari X orang tua, pasangan di kanan (sama seperti PositionFrom)
+    for (CompactUnit& unit : s_units) {
+        if (unit.parent == DataModel::NO_INDEX) unit.x = x - minLeft;
+        else unit.x = s_units[unit.parent].x - s_units[unit.parent].center + unit.shift;
+        size_t index = unit.index;
+        model.posX[index] = unit.x;
+        if (owner) owner[index] = ownerRoot;
+        int spouseStartX = unit.x + BOX_WIDTH + SPOUSE_GAP;
+        for (const SpouseLink& link : model.Spouses(model.people[index])) {
+            size_t sp = model.IndexOf(link.id);
+            if (sp != IdIndex::NPOS) {
+                model.posX[sp] = spouseStartX;
+                model.posY[sp] = model.posY[index];
+                if (owner) owner[sp] = ownerRoot;
+                spouseStartX += BOX_WIDTH + SPOUSE_GAP;
+            }
+        }
+    }
+    s_positionMs += ElapsedMs(t1);
+    return maxRight - minLeft;
+}
+
+// Menempatkan satu keluarga akar dengan tepi kiri di X = x sesuai model.layoutMode; mengembalikan lebarnya
+static int LayoutRoot(DataModel& model, size_t rootIndex, int x, int y, uint32_t* owner, uint32_t ownerRoot) {
+    if (model.layoutMode == LayoutMode::Compact) return PositionCompact(model, rootIndex, x, y, owner, ownerRoot);
+    auto t0 = Clock::now();
+    int w = CalculateSubtreeWidth(model, model.people[rootIndex].id);
+    auto t1 = Clock::now();
+    PositionFrom(model, rootIndex, x, y, owner, ownerRoot);
+    s_widthsMs += ElapsedMs(t0, t1);
+    s_positionMs += ElapsedMs(t1);
+    return w;
+}
+
+// Garis milik satu orang, geometrinya sama persis dengan cara lama menggambar per MoveToEx/LineTo.
+// Setiap garis diserahkan ke add(x1, y1, x2, y2, dotted): ditambahkan ke vector, atau hanya dihitung.
+template <typename Add> static void EmitPersonConnectors(const DataModel& model, size_t index, Add&& add) {
+    if (!model.placed[index]) return;
+    const Person& p = model.people[index];
+    // Indeks orang yang sudah ditempatkan, atau NPOS
+    auto placedIndex = [&](int id) {
+        size_t k = model.IndexOf(id);
+        return (k != IdIndex::NPOS && model.placed[k]) ? k : IdIndex::NPOS;
+    };
+
+    int pcx = model.posX[index] + BOX_WIDTH/2, pcy = model.posY[index] + BOX_HEIGHT/2;
+    int pBottomY = model.posY[index] + BOX_HEIGHT;
+    int forkY = pcy + BOX_HEIGHT/2 + 15;
+    bool male = (p.gender == Gender::Male);
+
+    // 1. Garis ke pasangan (sekali per pasangan, dari ID yang lebih kecil) dan ke anak-anak mereka
+    for (const SpouseLink& link : model.Spouses(p)) {
+        if (link.id <= p.id) continue;
+        size_t sp = placedIndex(link.id);
+        if (sp == IdIndex::NPOS) continue;
+        int scx = model.posX[sp] + BOX_WIDTH/2, scy = model.posY[sp] + BOX_HEIGHT/2;
+        add(pcx, pcy, scx, scy, link.ex);
+        if (model.collapsed[index] || model.collapsed[sp]) continue; // Anak-anak mereka disembunyikan
+
+        auto kids = GetChildren(model, male ? p.id : link.id, male ? link.id : p.id);
+        if (kids.empty()) continue;
+
+        // Garis turun dari tengah-tengah pasangan
+        int midX = (pcx + scx) / 2;
+        add(midX, pcy, midX, forkY, false);
+        if (kids.size() == 1) {
+            add(midX, forkY, midX, pBottomY + V_GAP, false);
+            continue;
+        }
+
+        // Fork horizontal selebar anak-anak, lalu garis vertikal ke tiap anak
+        int minKidX = 0, maxKidX = 0;
+        bool anyKid = false;
+        for (int kId : kids) {
+            size_t k = placedIndex(kId);
+            if (k == IdIndex::NPOS) continue;
+            int kcx = model.posX[k] + BOX_WIDTH/2;
+            minKidX = anyKid ? std::min(minKidX, kcx) : kcx;
+            maxKidX = anyKid ? std::max(maxKidX, kcx) : kcx;
+            anyKid = true;
+        }
+        if (!anyKid) continue;
+        add(minKidX, forkY, maxKidX, forkY, false);
+        for (int kId : kids) {
+            size_t k = placedIndex(kId);
+            if (k != IdIndex::NPOS) add(model.posX[k] + BOX_WIDTH/2, forkY, model.posX[k] + BOX_WIDTH/2, model.posY[k], false);
+        }
+    }
+
+    // 2. Garis untuk anak dari orang tua tunggal
+    auto singleKids = GetChildren(model, male ? p.id : 0, (p.gender == Gender::Female) ? p.id : 0);
+    if (!singleKids.empty() && !model.collapsed[index]) {
+        add(pcx, pBottomY, pcx, pBottomY + 15, false);
+        for (int kId : singleKids) {
+            size_t k = placedIndex(kId);
+            if (k != IdIndex::NPOS) add(pcx, pBottomY + 15, model.posX[k] + BOX_WIDTH/2, model.posY[k], false);
+        }
+    }
+}
+
+// Di bawah jumlah orang ini layout selalu serial (membuat thread lebih mahal dari hasilnya)
+static const size_t PARALLEL_MIN_PEOPLE = 20000;
+
+static unsigned ResolveThreads(const DataModel& model, unsigned threads) {
+    return model.people.size() < PARALLEL_MIN_PEOPLE ? 1 : ResolveThreads(threads);
+}
+
+static void BuildConnectors(DataModel& model, unsigned threads) {
+    ScopedTimer timer(Stage::Connectors);
+    model.segments.clear();
+    model.segmentStart.assign(model.people.size() + 1, 0);
+    if (threads <= 1) {
+        for (size_t i = 0; i < model.people.size(); ++i) {
+            EmitPersonConnectors(model, i, [&](int x1, int y1, int x2, int y2, bool dotted) {
+                model.segments.push_back({ x1, y1, x2, y2, dotted });
+            });
+            model.segmentStart[i + 1] = (uint32_t)model.segments.size();
+        }
+        return;
+    }
+
+    // Paralel dua tahap: hitung jumlah garis per orang, prefix sum, lalu tiap orang menulis
+    // langsung ke tempatnya. Tidak ada buffer sementara dan vector garis dialokasikan sekali.
+    size_t n = model.people.size();
+    size_t chunks = (size_t)threads * 8;
+    size_t per = (n + chunks - 1) / chunks;
+    ParallelFor(chunks, threads, [&](size_t c) {
+        for (size_t i = std::min(n, c * per); i < std::min(n, (c + 1) * per); ++i) {
+            uint32_t count = 0;
+            EmitPersonConnectors(model, i, [&](int, int, int, int, bool) { count++; });
+            model.segmentStart[i + 1] = count;
+        }
+    });
+    for (size_t i = 0; i < n; ++i) model.segmentStart[i + 1] += model.segmentStart[i];
+    model.segments.resize(model.segmentStart[n]);
+    ParallelFor(chunks, threads, [&](size_t c) {
+        for (size_t i = std::min(n, c * per); i < std::min(n, (c + 1) * per); ++i) {
+            LineSegment* out = model.segments.data() + model.segmentStart[i];
+            EmitPersonConnectors(model, i, [&](int x1, int y1, int x2, int y2, bool dotted) {
+                *out++ = { x1, y1, x2, y2, dotted };
+            });
+        }
+    });
+}
+
+void BuildConnectors(DataModel& model) {
+    BuildConnectors(model, 1);
+    AddCounter(Counter::Segments, model.segments.size());
+}
+
+// Akar yang menjadi titik awal sebuah keluarga: tanpa Ayah & Ibu di data, dan jika punya
+// pasangan, hanya orang dengan ID terkecil (pasangannya ikut ditempatkan di sebelahnya).
+// Baris ID ganda yang tertimpa baris lain (IndexOf menunjuk baris terakhir) tidak pernah jadi akar.
+static bool IsRootLeader(const DataModel& model, size_t index) {
+    const Person& p = model.people[index];
+    if (p.fatherId != 0 || p.motherId != 0 || model.IndexOf(p.id) != index) return false;
+    for (const SpouseLink& sp : model.Spouses(p)) {
+        if (sp.id < p.id) return false;
+    }
+    return true;
+}
+
+// Satu akar yang ditempatkan: indeks orangnya dan lebar sub-pohonnya
+struct RootRun {
+    uint32_t index;
+    int width;
+};
+
+// Mengelompokkan orang menjadi komponen terhubung (lewat Ayah, Ibu, dan pasangan) dengan
+// union-find. Layout satu akar hanya menyentuh orang di komponennya sendiri, jadi komponen
+// yang berbeda bisa di-layout bersamaan tanpa saling memengaruhi.
+static std::vector<uint32_t> ConnectedComponents(const DataModel& model) {
+    size_t n = model.people.size();
+    std::vector<uint32_t> parent(n);
+    for (size_t i = 0; i < n; ++i) parent[i] = (uint32_t)i;
+    auto find = [&](uint32_t x) {
+        while (parent[x] != x) { parent[x] = parent[parent[x]]; x = parent[x]; }
+        return x;
+    };
+    auto unite = [&](uint32_t a, uint32_t b) {
+        a = find(a); b = find(b);
+        if (a != b) parent[std::max(a, b)] = std::min(a, b);
+    };
+    for (size_t i = 0; i < n; ++i) {
+        if (model.fatherIndex[i] != DataModel::NO_INDEX) unite((uint32_t)i, model.fatherIndex[i]);
+        if (model.motherIndex[i] != DataModel::NO_INDEX) unite((uint32_t)i, model.motherIndex[i]);
+        for (const SpouseLink& sp : model.Spouses(model.people[i])) {
+            size_t k = model.IndexOf(sp.id);
+            if (k != IdIndex::NPOS) unite((uint32_t)i, (uint32_t)k);
+        }
+    }
+    for (size_t i = 0; i < n; ++i) parent[i] = find((uint32_t)i);
+    return parent;
+}
+
+// Layout paralel: setiap komponen menempatkan akar-akarnya (berurutan, seperti versi serial)
+// mulai dari X = 0. Setelah lebar semua akar diketahui, posisi X akhir tiap akar dihitung
+// dengan prefix sum sesuai urutan data, lalu setiap orang digeser sejauh posisi akarnya.
+// Hasilnya identik dengan versi serial. Mengembalikan false jika hanya ada satu komponen.
+static bool LayoutRootsParallel(DataModel& model, unsigned threads, int startX, int startY, std::vector<RootRun>& runs) {
+    auto setupStart = Clock::now();
+    size_t n = model.people.size();
+    std::vector<uint32_t> component = ConnectedComponents(model);
+
+    // Kandidat akar per komponen (urutan data tetap terjaga di dalam komponen)
+    std::vector<uint32_t> leaders;
+    for (uint32_t i : model.rootCandidates) {
+        if (IsRootLeader(model, i)) leaders.push_back(i);
+    }
+    std::stable_sort(leaders.begin(), leaders.end(), [&](uint32_t a, uint32_t b) { return component[a] < component[b]; });
+    std::vector<std::pair<size_t, size_t>> groups; // Rentang [begin, end) di leaders
+    for (size_t k = 0; k < leaders.size(); ++k) {
+        if (k == 0 || component[leaders[k]] != component[leaders[k - 1]]) groups.push_back({ k, k });
+        groups.back().second = k + 1;
+    }
+    if (groups.size() < 2) return false;
+
+    // Komponen terbesar dikerjakan lebih dulu agar beban antar thread seimbang
+    std::vector<uint32_t> sizes(n, 0);
+    for (size_t i = 0; i < n; ++i) sizes[component[i]]++;
+    std::sort(groups.begin(), groups.end(), [&](const auto& a, const auto& b) {
+        return sizes[component[leaders[a.first]]] > sizes[component[leaders[b.first]]];
+    });
+    std::vector<uint32_t>().swap(sizes);
+    std::vector<uint32_t>().swap(component);
+
+    std::vector<uint32_t> owner(n, DataModel::NO_INDEX); // Akar yang menempatkan tiap orang
+    std::vector<std::vector<RootRun>> groupRuns(groups.size());
+    std::vector<std::pair<double, double>> groupMs(groups.size()); // Waktu lebar & posisi per komponen
+    std::atomic<size_t> widthsComputed(0), cyclesFound(0);
+    double setupMs = ElapsedMs(setupStart);
+    ParallelFor(groups.size(), threads, [&](size_t g) {
+        s_widthsComputed = 0;
+        s_cyclesFound = 0;
+        s_widthsMs = 0;
+        s_positionMs = 0;
+        for (size_t k = groups[g].first; k < groups[g].second; ++k) {
+            uint32_t i = leaders[k];
+            if (model.placed[i]) continue; // Sudah ditempatkan oleh akar lain di komponen ini
+            groupRuns[g].push_back({ i, LayoutRoot(model, i, 0, startY, owner.data(), i) });
+        }
+        widthsComputed += s_widthsComputed;
+        cyclesFound += s_cyclesFound;
+        groupMs[g] = { s_widthsMs, s_positionMs };
+    });
+    s_widthsComputed = widthsComputed;
+    s_cyclesFound = cyclesFound;
+    s_widthsMs = 0;
+    s_positionMs = 0;
+    for (const auto& ms : groupMs) { s_widthsMs += ms.first; s_positionMs += ms.second; }
+
+    // Prefix sum posisi X akar, sesuai urutan akar di data (sama seperti currentRootX serial)
+    auto shiftStart = Clock::now();
+    for (auto& r : groupRuns) runs.insert(runs.end(), r.begin(), r.end());
+    std::sort(runs.begin(), runs.end(), [](const RootRun& a, const RootRun& b) { return a.index < b.index; });
+    std::vector<int> shift(n, 0);
+    int currentRootX = startX;
+    for (const RootRun& r : runs) {
+        shift[r.index] = currentRootX;
+        currentRootX += r.width + H_GAP + 50;
+    }
+    size_t chunk = (n + threads * 8 - 1) / (threads * 8);
+    ParallelFor(threads * 8, threads, [&](size_t c) {
+        for (size_t i = c * chunk; i < std::min(n, (c + 1) * chunk); ++i) {
+            if (owner[i] != DataModel::NO_INDEX) model.posX[i] += shift[owner[i]];
+        }
+    });
+    s_positionMs += setupMs + ElapsedMs(shiftStart); // Pengelompokan komponen & penggeseran akar
+    return true;
+}
+
+static LayoutStats LayoutRoots(DataModel& model, unsigned threads) {
+    ScopedTimer layoutTimer(Stage::Layout); // Dihentikan sebelum garis penghubung (tahap sendiri)
+    LayoutStats stats;
+    s_widthsComputed = 0;
+    s_cyclesFound = 0;
+    s_widthsMs = 0;
+    s_positionMs = 0;
+    std::fill(model.placed.begin(), model.placed.end(), 0);
+    model.maxX = 0;
+    model.maxY = 0;
+
+    int currentRootX = 50; // Titik awal penggambaran
+    int startY = 50;
+
+    threads = ResolveThreads(model, threads);
+    const bool verbose = LogEnabled(LogLevel::Verbose); // Satu baris per akar
+    std::vector<RootRun> runs;
+    if (threads > 1 && LayoutRootsParallel(model, threads, currentRootX, startY, runs)) {
+        if (verbose) {
+            for (const RootRun& r : runs) std::cout << "[LAYOUT] Positioning Root: " << model.people[r.index].id << "\n";
+        }
+        stats.rootsPositioned = runs.size();
+    } else {
+        threads = 1;
+        for (uint32_t i : model.rootCandidates) {
+            const Person& p = model.people[i];
+            // Mencari Akar (Orang yang tidak punya Ayah & Ibu di data)
+            if (!model.placed[i] && IsRootLeader(model, i)) {
+                if (verbose) std::cout << "[LAYOUT] Positioning Root: " << p.id << "\n";
+                stats.rootsPositioned++;
+                currentRootX += LayoutRoot(model, i, currentRootX, startY, nullptr, 0) + H_GAP + 50;
+            }
+        }
+    }
+
+    // Update dimensi maksimum untuk area scrollbar
+    auto boundsStart = Clock::now();
+    for (size_t i = 0; i < model.people.size(); ++i) {
+        if (model.placed[i]) {
+            model.maxX = std::max(model.maxX, model.posX[i] + BOX_WIDTH);
+            model.maxY = std::max(model.maxY, model.posY[i] + BOX_HEIGHT);
+        }
+    }
+    model.maxX += 50;
+    model.maxY += 50;
+    s_positionMs += ElapsedMs(boundsStart);
+    layoutTimer.Stop();
+
+    auto connectorsStart = Clock::now();
+    BuildConnectors(model, threads);
+    stats.connectorsMs = ElapsedMs(connectorsStart);
+    AddCounter(Counter::Segments, model.segments.size());
+    AddCounter(Counter::WidthsComputed, s_widthsComputed);
+
+    stats.widthsComputed = s_widthsComputed;
+    stats.cyclesIgnored = s_cyclesFound;
+    stats.widthsMs = s_widthsMs;
+    stats.positionMs = s_positionMs;
+    return stats;
+}
+
+LayoutStats RecalculateLayout(DataModel& model, unsigned threads) {
+    std::fill(model.subtreeWidth.begin(), model.subtreeWidth.end(), 0);
+    std::fill(model.widthValid.begin(), model.widthValid.end(), 0);
+    return LayoutRoots(model, threads);
+}
+
+LayoutStats UpdateLayout(DataModel& model, const std::vector<int>& dirtyIds, unsigned threads) {
+    // Batalkan lebar orang yang berubah beserta seluruh rantai leluhurnya (Ayah & Ibu, ke atas)
+    std::vector<uint32_t> stack;
+    for (int id : dirtyIds) {
+        size_t index = model.IndexOf(id);
+        if (index != IdIndex::NPOS) stack.push_back((uint32_t)index);
+    }
+    std::vector<unsigned char> visited(model.people.size(), 0); // Mencegah kunjungan ganda (dan loop jika data bersiklus)
+    size_t invalidated = 0;
+    while (!stack.empty()) {
+        uint32_t index = stack.back();
+        stack.pop_back();
+        if (visited[index]) continue;
+        visited[index] = 1;
+        if (model.widthValid[index]) {
+            model.widthValid[index] = 0;
+            invalidated++;
+        }
+        if (model.fatherIndex[index] != DataModel::NO_INDEX) stack.push_back(model.fatherIndex[index]);
+        if (model.motherIndex[index] != DataModel::NO_INDEX) stack.push_back(model.motherIndex[index]);
+    }
+
+    LayoutStats stats = LayoutRoots(model, threads);
+    stats.widthsInvalidated = invalidated;
+    return stats;
+}
+
+LayoutStats ApplyReload(DataModel& model, const ReloadResult& reload, unsigned threads) {
+    if (reload.fullReload) return RecalculateLayout(model, threads);
+    if (reload.needsLayout) return UpdateLayout(model, reload.dirtyIds, threads);
+    LayoutStats stats;
+    if (!reload.changed) return stats;
+    auto connectorsStart = Clock::now();
+    BuildConnectors(model, ResolveThreads(model, threads));
+    stats.connectorsMs = ElapsedMs(connectorsStart);
+    return stats;
+}
+
+// Orang yang lebarnya bergantung pada status ciut people[index]: orang itu dan pasangannya
+// (anak bersama dilewati jika salah satu dari mereka diciutkan)
+static void AddCollapseDirty(const DataModel& model, size_t index, std::vector<int>& dirtyIds) {
+    dirtyIds.push_back(model.people[index].id);
+    for (const SpouseLink& sp : model.Spouses(model.people[index])) dirtyIds.push_back(sp.id);
+}
+
+LayoutStats SetCollapsed(DataModel& model, int personId, bool collapsed, unsigned threads) {
+    size_t index = model.IndexOf(personId);
+    if (index == IdIndex::NPOS) return LayoutStats();
+    std::vector<int> dirtyIds;
+    auto set = [&](size_t k) {
+        if (model.collapsed[k] == (collapsed ? 1 : 0)) return;
+        model.collapsed[k] = collapsed ? 1 : 0;
+        AddCollapseDirty(model, k, dirtyIds);
+    };
+    set(index);
+    // Anak bersama tetap tersembunyi selama salah satu orang tuanya diciutkan, jadi membuka
+    // seseorang ikut membuka pasangannya
+    if (!collapsed) {
+        for (const SpouseLink& sp : model.Spouses(model.people[index])) {
+            size_t k = model.IndexOf(sp.id);
+            if (k != IdIndex::NPOS) set(k);
+        }
+    }
+    if (dirtyIds.empty()) return LayoutStats();
+    return UpdateLayout(model, dirtyIds, threads);
+}
+
+LayoutStats RevealPerson(DataModel& model, int personId, unsigned threads) {
+    size_t index = model.IndexOf(personId);
+    if (index == IdIndex::NPOS) return LayoutStats();
+    // Semua leluhur (lewat Ayah dan Ibu) yang diciutkan dibuka bersama pasangannya, lalu satu
+    // layout inkremental untuk semuanya
+    std::vector<int> dirtyIds;
+    std::vector<uint8_t> seen(model.people.size(), 0);
+    std::vector<uint32_t> stack = { (uint32_t)index };
+    seen[index] = 1;
+    auto expand = [&](size_t k) {
+        if (!model.collapsed[k]) return;
+        model.collapsed[k] = 0;
+        AddCollapseDirty(model, k, dirtyIds);
+    };
+    while (!stack.empty()) {
+        uint32_t k = stack.back();
+        stack.pop_back();
+        for (uint32_t parent : { model.fatherIndex[k], model.motherIndex[k] }) {
+            if (parent == DataModel::NO_INDEX || seen[parent]) continue;
+            seen[parent] = 1;
+            expand(parent);
+            for (const SpouseLink& sp : model.Spouses(model.people[parent])) {
+                size_t s = model.IndexOf(sp.id);
+                if (s != IdIndex::NPOS) expand(s);
+            }
+            stack.push_back(parent);
+        }
+    }
+    if (dirtyIds.empty()) return LayoutStats();
+    return UpdateLayout(model, dirtyIds, threads);
+}
+
+LayoutStats SetAllCollapsed(DataModel& model, bool collapsed, unsigned threads) {
+    std::fill(model.collapsed.begin(), model.collapsed.end(), collapsed ? 1 : 0);
+    return RecalculateLayout(model, threads);
+}
+
+std::vector<int> CollapsedIds(const DataModel& model) {
+    std::vector<int> ids;
+    for (size_t i = 0; i < model.people.size(); ++i) {
+        if (model.collapsed[i]) ids.push_back(model.people[i].id);
+    }
+    return ids;
+}
+
+std::vector<int> ApplyCollapsedIds(DataModel& model, const std::vector<int>& ids) {
+    std::vector<uint8_t> wanted(model.people.size(), 0);
+    for (int id : ids) {
+        size_t index = model.IndexOf(id);
+        if (index != IdIndex::NPOS) wanted[index] = 1; // ID yang sudah tidak ada diabaikan
+    }
+    std::vector<int> dirtyIds;
+    for (size_t i = 0; i < model.people.size(); ++i) {
+        if (model.collapsed[i] == wanted[i]) continue;
+        model.collapsed[i] = wanted[i];
+        AddCollapseDirty(model, i, dirtyIds);
+    }
+    return dirtyIds;
+}
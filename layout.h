@@ -0,0 +1,91 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// LAYOUT (Penempatan Pohon) - bagian inti yang tidak bergantung pada Win32
+// -----------------------------------------------------------------------------
+#include <string_view>
+
+#include "model.h"
+
+// Pengaturan Dimensi Visual
+const int BOX_WIDTH = 120;     // Lebar kotak tiap anggota keluarga
+const int BOX_HEIGHT = 60;     // Tinggi kotak tiap anggota keluarga
+const int V_GAP = 80;          // Jarak vertikal antar generasi (Ayah -> Anak)
+const int H_GAP = 15;          // Jarak horizontal antar kotak saudara kandung
+const int SPOUSE_GAP = 10;     // Jarak horizontal antara suami dan istri
+
+// Mengambil daftar anak berdasarkan ID Ayah dan Ibu (lookup ke indeks anak, bukan scan seluruh data)
+ChildRange GetChildren(const DataModel& model, int fatherId, int motherId);
+
+// Status ciut: anak seseorang (bersama pasangan mana pun) disembunyikan dan orang itu cukup
+// selebar kotaknya bersama pasangan. Keturunan yang tersembunyi tidak dihitung lebarnya dan
+// tidak ditempatkan (placed = 0) sampai dibuka lagi, jadi biaya layout mengikuti bagian pohon
+// yang terlihat saja.
+bool IsCollapsed(const DataModel& model, int personId);
+// Punya anak di data (untuk menampilkan tanda ciut/buka di kotaknya)
+bool HasChildren(const DataModel& model, size_t index);
+
+// Menghitung lebar total yang dibutuhkan sebuah keluarga (sub-pohon). Iteratif dengan stack
+// eksplisit; anak yang ternyata juga leluhurnya (data bersiklus) dilewati dengan peringatan.
+int CalculateSubtreeWidth(DataModel& model, int personId);
+
+// Menentukan koordinat X dan Y untuk setiap orang di sub-pohon (iteratif, urutan sama seperti rekursi)
+void PositionSubtree(DataModel& model, int personId, int x, int y);
+
+// Mengisi model.segments dari posisi saat ini: garis ke pasangan, garis turun ke anak, dan
+// fork antar saudara. Dipanggil otomatis oleh RecalculateLayout/UpdateLayout/ApplyReload; panggil
+// manual jika hanya gaya garis yang berubah (mis. tanda cerai diedit tanpa perubahan posisi).
+void BuildConnectors(DataModel& model);
+
+// Statistik satu kali proses layout
+struct LayoutStats {
+    size_t widthsComputed = 0;     // Jumlah orang yang lebar sub-pohonnya (mode kompak: konturnya) dihitung ulang
+    size_t widthsInvalidated = 0;  // Jumlah orang yang lebarnya dibatalkan oleh perubahan data
+    size_t rootsPositioned = 0;    // Jumlah keluarga akar yang ditempatkan
+    size_t cyclesIgnored = 0;      // Jumlah hubungan anak yang dilewati karena membentuk siklus
+    // Waktu per tahap (ms). Pada layout paralel, widthsMs/positionMs adalah jumlah dari semua thread.
+    double widthsMs = 0;           // CalculateSubtreeWidth
+    double positionMs = 0;         // PositionSubtree, penggeseran akar, dan ukuran canvas
+    double connectorsMs = 0;       // BuildConnectors
+};
+
+// Nama mode untuk log dan argumen ("classic" / "compact"), dan kebalikannya (false jika tidak dikenal)
+const char* LayoutModeName(LayoutMode mode);
+bool ParseLayoutMode(std::string_view text, LayoutMode& mode);
+
+// Fungsi utama untuk mengatur ulang seluruh tata letak pohon sesuai model.layoutMode.
+// Classic: setiap sub-pohon selebar generasi terlebarnya (lebar disimpan di subtreeWidth dan
+// dipakai ulang oleh layout inkremental). Compact: sub-pohon saudara didekatkan menurut kontur
+// per generasi (gaya Reingold-Tilford, O(N)); canvas jauh lebih sempit untuk cabang yang
+// jarang, tetapi kontur selalu dihitung ulang seluruhnya (subtreeWidth tidak dipakai).
+// threads: jumlah thread (0 = otomatis sesuai jumlah core; pohon kecil selalu serial). Keluarga
+// akar yang tidak terhubung satu sama lain di-layout bersamaan; hasilnya identik dengan serial.
+LayoutStats RecalculateLayout(DataModel& model, unsigned threads = 0);
+
+// Layout inkremental setelah ReloadData: hanya lebar milik dirtyIds dan leluhurnya yang
+// dihitung ulang, sisanya memakai lebar lama. Posisi akhir sama dengan RecalculateLayout.
+LayoutStats UpdateLayout(DataModel& model, const std::vector<int>& dirtyIds, unsigned threads = 0);
+
+// Menerapkan hasil ReloadData: layout penuh (load pertama), inkremental (struktur berubah), atau
+// hanya garis penghubung (teks/tanda cerai berubah, garis putus-putus bisa ikut berubah). Semua
+// pemanggil ReloadData memakai ini agar model.segments tidak tertinggal dari data.
+LayoutStats ApplyReload(DataModel& model, const ReloadResult& reload, unsigned threads = 0);
+
+// Menciutkan/membuka keturunan satu orang lalu layout inkremental: hanya lebar orang itu,
+// pasangannya, dan leluhur mereka yang dihitung ulang; keturunan yang baru dibuka dihitung
+// saat itu juga. Membuka seseorang ikut membuka pasangannya (anak bersama tersembunyi selama
+// salah satu orang tua diciutkan). Mengembalikan statistik kosong jika status tidak berubah.
+LayoutStats SetCollapsed(DataModel& model, int personId, bool collapsed, unsigned threads = 0);
+
+// Membuka semua leluhur orang itu yang diciutkan (beserta pasangannya) agar kotaknya tampil,
+// mis. sebelum melompat ke hasil pencarian. Statistik kosong jika tidak ada yang diciutkan.
+LayoutStats RevealPerson(DataModel& model, int personId, unsigned threads = 0);
+
+// Menciutkan (atau membuka) semua orang sekaligus, lalu layout ulang penuh
+LayoutStats SetAllCollapsed(DataModel& model, bool collapsed, unsigned threads = 0);
+
+// ID semua orang yang diciutkan, dan kebalikannya: menyamakan status ciut model dengan daftar
+// tersebut (mis. ke buffer lain milik ModelLoader). ApplyCollapsedIds mengembalikan dirtyIds
+// untuk UpdateLayout (kosong jika tidak ada yang berubah).
+std::vector<int> CollapsedIds(const DataModel& model);
+std::vector<int> ApplyCollapsedIds(DataModel& model, const std::vector<int>& ids);
@@ -10,80 +10,48 @@
 
 // Include library yang dibutuhkan
 #include <windows.h>   // Library utama untuk GUI Windows (Win32 API)
-#include <vector>      // Kontainer array dinamis
-#include <string>      // Manipulasi teks (std::wstring untuk Unicode)
-#include <map>         // Untuk mapping ID orang ke indeks array secara cepat
-#include <set>         // Untuk menyimpan data unik (misal: ID mantan pasangan)
-#include <fstream>     // Untuk operasi pembacaan file eksternal (CSV)
-#include <sstream>     // Untuk memproses string per baris atau per kolom
-#include <algorithm>   // Untuk fungsi matematika seperti std::max
+#include <windowsx.h>  // GET_X_LPARAM/GET_Y_LPARAM untuk posisi klik
+#include <algorithm>   // std::min/std::max untuk batas scroll dan zoom
+#include <chrono>      // Waktu ciut/buka untuk log
+#include <cmath>       // Skala zoom (pangkat 2) dan pembulatan koordinat tile
+#include <cwchar>      // swprintf untuk teks overlay statistik
+#include <fstream>     // Untuk membuat file CSV contoh
 #include <iostream>    // Untuk output ke console (debugging)
+#include <memory>      // Buffer model depan/belakang
+#include <vector>      // Cache teks per orang
+
+#include "model.h"     // Struktur data Person/DataModel dan pembacaan CSV (portabel)
+#include "layout.h"    // Algoritma layout pohon dan konstanta dimensi kotak (portabel)
+#include "file_watcher.h" // Notifikasi perubahan Family.csv untuk live reload
+#include "spatial_index.h" // Grid untuk menggambar hanya kotak/garis yang terlihat
+#include "snapshot.h"  // Cache biner Family.csv.snap untuk startup cepat
+#include "model_loader.h" // Load & layout di thread latar, UI menggambar versi lama sampai versi baru siap
+#include "stats.h"     // Timer per tahap, penghitung, alokasi, dan tingkat log
+#include "search.h"    // Indeks pencarian nama/peran untuk kotak cari (Ctrl+F)
+#include "tile_cache.h" // Cache LRU tile yang sudah digambar per level zoom
 
 // -----------------------------------------------------------------------------
-// CONFIGURATION (Pengaturan Dimensi Visual)
+// CONFIGURATION (Pengaturan Visual)
 // -----------------------------------------------------------------------------
-const int BOX_WIDTH = 120;     // Lebar kotak tiap anggota keluarga
-const int BOX_HEIGHT = 60;     // Tinggi kotak tiap anggota keluarga
-const int V_GAP = 80;          // Jarak vertikal antar generasi (Ayah -> Anak)
-const int H_GAP = 15;          // Jarak horizontal antar kotak saudara kandung
-const int SPOUSE_GAP = 10;     // Jarak horizontal antara suami dan istri
-
 // Definisi warna menggunakan format RGB
 const COLORREF COL_CANVAS = RGB(242, 242, 235);   // Warna background (putih tulang)
 const COLORREF COL_BOX_FEM = RGB(245, 144, 144);  // Warna kotak Perempuan (pink)
 const COLORREF COL_BOX_MALE = RGB(123, 157, 201); // Warna kotak Laki-laki (biru)
 const COLORREF COL_LINE = RGB(0, 0, 0);           // Warna garis hubungan (hitam)
 const COLORREF COL_LINE_EX = RGB(0, 0, 0);        // Warna garis mantan pasangan
+const COLORREF COL_HIGHLIGHT = RGB(255, 170, 0);  // Warna bingkai orang hasil pencarian (oranye)
+const int BLOCK_SHADES = 9; // Warna blok ringkasan: campuran biru..pink menurut jumlah perempuan
 
 const std::string DATA_FILE_A = "Family.csv"; // Nama file sumber data CSV
 
-// -----------------------------------------------------------------------------
-// DATA STRUCTURES (Struktur Data)
-// -----------------------------------------------------------------------------
-struct Person {
-    int id = 0;               // ID Unik setiap orang
-    std::wstring name;        // Nama (Wide string untuk Unicode)
-    std::wstring role;        // Peran/Jabatan (misal: Kakek, Ayah)
-    std::wstring gender;      // Jenis Kelamin ("M" atau "F")
-    int fatherId = 0;         // Referensi ID Ayah
-    int motherId = 0;         // Referensi ID Ibu
-    std::vector<int> spouses; // Daftar ID pasangan (suami/istri)
-    std::set<int> exSpouses;  // Daftar ID mantan pasangan
-
-    // Variabel untuk Layouting (Posisi di layar)
-    int x = 0;                // Koordinat X di canvas
-    int y = 0;                // Koordinat Y di canvas
-    bool placed = false;      // Flag apakah orang ini sudah diatur posisinya
-    int subtreeWidth = 0;     // Total lebar area yang dibutuhkan orang ini dan keturunannya
-};
-
-class DataModel {
-public:
-    std::vector<Person> people;       // List utama seluruh orang di database
-    std::map<int, size_t> idToIndex;  // Kamus untuk mencari indeks berdasarkan ID
-    FILETIME lastWriteTime = {0, 0};  // Menyimpan waktu terakhir file diubah (untuk auto-reload)
-    int maxX = 0;                     // Batas terjauh koordinat X (untuk scrollbar)
-    int maxY = 0;                     // Batas terjauh koordinat Y (untuk scrollbar)
-
-    // Menghapus data lama saat akan memuat ulang file
-    void Clear() {
-        people.clear();
-        idToIndex.clear();
-        maxX = 0;
-        maxY = 0;
-    }
-
-    // Mengambil pointer data orang berdasarkan ID
-    Person* Get(int id) {
-        auto it = idToIndex.find(id);
-        if (it != idToIndex.end()) {
-            return &people[it->second];
-        }
-        return nullptr;
-    }
-};
+const UINT WM_FILE_CHANGED = WM_APP + 1; // Dikirim FileWatcher (dari thread lain) saat Family.csv berubah
+const UINT WM_MODEL_READY = WM_APP + 2;  // Dikirim ModelLoader (dari thread lain) saat versi baru siap
 
-DataModel g_Model; // Instansiasi global model data
+// Versi data yang sedang digambar (buffer depan). Hanya disentuh thread UI; versi baru dibangun
+// ModelLoader di buffer lain lalu ditukar di WM_MODEL_READY. Awalnya kosong sampai load pertama selesai.
+std::unique_ptr<LoadedScene> g_Front = std::make_unique<LoadedScene>();
+ModelLoader g_Loader;    // Thread latar yang membaca CSV dan menghitung layout
+FileWatcher g_Watcher;   // Pemantau file untuk live reload
 
 // -----------------------------------------------------------------------------
 // HELPERS (Fungsi Pembantu)
@@ -98,438 +66,744 @@ public:
     ~GdiObj() { SelectObject(m_hDC, m_hOld); }
 };
 
-// Mengonversi string standar (ANSI/UTF-8) ke wstring (Unicode Windows)
-std::wstring ToWString(const std::string& str) {
-    if (str.empty()) return L"";
-    int size_needed = MultiByteToWideChar(CP_ACP, 0, &str[0], (int)str.size(), NULL, 0);
-    std::wstring wstrTo(size_needed, 0);
-    MultiByteToWideChar(CP_ACP, 0, &str[0], (int)str.size(), &wstrTo[0], size_needed);
-    return wstrTo;
-}
-
-// Mengonversi teks angka ke tipe data integer secara aman (mencegah crash jika data bukan angka)
-int SafeToInt(const std::string& s) {
-    if (s.empty()) return 0;
-    try { return std::stoi(s); } catch (...) { return 0; }
-}
-
 // -----------------------------------------------------------------------------
-// ROBUST DATA LOADING (Proses Membaca CSV)
+// RENDERING (Proses Menggambar ke Layar)
 // -----------------------------------------------------------------------------
-void LoadData() {
-    // Mengecek atribut file (apakah ada perubahan waktu modifikasi)
-    WIN32_FILE_ATTRIBUTE_DATA fileInfo;
-    if (GetFileAttributesExA(DATA_FILE_A.c_str(), GetFileExInfoStandard, &fileInfo)) {
-        // Jika file belum berubah sejak load terakhir, batalkan load (efisiensi)
-        if (CompareFileTime(&g_Model.lastWriteTime, &fileInfo.ftLastWriteTime) == 0) return;
-        g_Model.lastWriteTime = fileInfo.ftLastWriteTime;
-    } else {
-        std::cout << "[ERROR] File not found: " << DATA_FILE_A << "\n";
-        return;
+
+// Objek GDI yang dipakai setiap frame: dibuat sekali saat jendela dibuat, dihapus saat jendela ditutup
+struct RenderResources {
+    HFONT fontBold = NULL;    // Font nama (tebal)
+    HFONT fontNorm = NULL;    // Font peran (normal)
+    HBRUSH brShadow = NULL;   // Bayangan kotak
+    HBRUSH brFemale = NULL;   // Kotak perempuan
+    HBRUSH brMale = NULL;     // Kotak laki-laki
+    HBRUSH brCanvas = NULL;   // Latar belakang canvas
+    HBRUSH brHighlight = NULL; // Bingkai orang hasil pencarian
+    HBRUSH brBlock[BLOCK_SHADES] = {}; // Blok ringkasan saat zoom jauh (0 = semua laki-laki)
+    HPEN penStd = NULL;       // Garis solid
+    HPEN penEx = NULL;        // Garis putus-putus (mantan pasangan)
+
+    void Create() {
+        fontBold = CreateFont(16, 0, 0, 0, FW_BOLD, 0, 0, 0, DEFAULT_CHARSET, 0, 0, DEFAULT_QUALITY, 0, L"Segoe UI");
+        fontNorm = CreateFont(14, 0, 0, 0, FW_NORMAL, 0, 0, 0, DEFAULT_CHARSET, 0, 0, DEFAULT_QUALITY, 0, L"Segoe UI");
+        brShadow = CreateSolidBrush(RGB(220, 220, 220));
+        brFemale = CreateSolidBrush(COL_BOX_FEM);
+        brMale = CreateSolidBrush(COL_BOX_MALE);
+        brCanvas = CreateSolidBrush(COL_CANVAS);
+        brHighlight = CreateSolidBrush(COL_HIGHLIGHT);
+        for (int k = 0; k < BLOCK_SHADES; ++k) {
+            auto mix = [k](int m, int f) { return m + (f - m) * k / (BLOCK_SHADES - 1); };
+            brBlock[k] = CreateSolidBrush(RGB(mix(GetRValue(COL_BOX_MALE), GetRValue(COL_BOX_FEM)),
+                                              mix(GetGValue(COL_BOX_MALE), GetGValue(COL_BOX_FEM)),
+                                              mix(GetBValue(COL_BOX_MALE), GetBValue(COL_BOX_FEM))));
+        }
+        penStd = CreatePen(PS_SOLID, 1, COL_LINE);
+        penEx = CreatePen(PS_DOT, 1, COL_LINE_EX);
     }
 
-    g_Model.Clear(); // Bersihkan memori sebelum memuat data baru
+    void Destroy() {
+        HGDIOBJ objs[] = { fontBold, fontNorm, brShadow, brFemale, brMale, brCanvas, brHighlight, penStd, penEx };
+        for (HGDIOBJ o : objs) if (o) DeleteObject(o);
+        for (HBRUSH b : brBlock) if (b) DeleteObject(b);
+        *this = RenderResources();
+    }
+};
 
-    // Membuka file menggunakan stream byte standar
-    std::ifstream file(DATA_FILE_A);
+// Teks yang sudah dikonversi ke Unicode dan diukur, per orang (indeks sama dengan g_Front->model.people)
+struct CachedLabel {
+    bool ready = false;
+    std::wstring name;
+    std::wstring role;
+    SIZE nameSize = {0, 0};
+    SIZE roleSize = {0, 0};
+};
 
-    if (!file.is_open()) {
-        std::cout << "[ERROR] Could not open file stream!\n";
-        return;
-    }
+RenderResources g_Res;               // Font/brush/pena yang dipakai ulang tiap frame
+std::vector<CachedLabel> g_Labels;   // Cache teks per orang, dikosongkan setiap kali data berubah
+std::vector<uint32_t> g_Visible;     // Hasil query grid (dipakai ulang tiap frame)
+int g_Highlight = 0;                 // ID orang hasil pencarian yang diberi bingkai sorot (0 = tidak ada)
 
-    std::cout << "[INFO] File opened. Reading lines...\n";
+// Membuang cache teks (dipanggil setiap kali isi model berubah)
+void InvalidateLabels() {
+    g_Labels.clear();
+}
 
-    std::string line;
-    int lineNum = 0;
-    // Membaca file baris demi baris
-    while (std::getline(file, line)) {
-        lineNum++;
-        // Menghapus karakter '\r' tersembunyi jika file dibuat di Windows
-        if (!line.empty() && line.back() == '\r') line.pop_back();
+// Menyiapkan teks sebuah kotak: konversi UTF-8 -> Unicode dan ukur lebar/tingginya sekali saja
+CachedLabel& GetLabel(HDC hdc, size_t index) {
+    if (g_Labels.size() != g_Front->model.people.size()) g_Labels.assign(g_Front->model.people.size(), CachedLabel());
+    CachedLabel& label = g_Labels[index];
+    if (!label.ready) {
+        const Person& p = g_Front->model.people[index];
+        label.name = ToWString(g_Front->model.Text(p.name));
+        label.role = ToWString(g_Front->model.Text(p.role));
+        {
+            GdiObj font(hdc, g_Res.fontBold);
+            GetTextExtentPoint32(hdc, label.name.c_str(), (int)label.name.size(), &label.nameSize);
+        }
+        {
+            GdiObj font(hdc, g_Res.fontNorm);
+            GetTextExtentPoint32(hdc, label.role.c_str(), (int)label.role.size(), &label.roleSize);
+        }
+        label.ready = true;
+    }
+    return label;
+}
 
-        if (line.empty()) continue;
+// Menulis teks di tengah rect (horizontal & vertikal), terpotong di tepi rect
+void DrawCenteredText(HDC hdc, const RECT& rc, const std::wstring& text, SIZE size) {
+    int x = rc.left + ((rc.right - rc.left) - size.cx) / 2;
+    int y = rc.top + ((rc.bottom - rc.top) - size.cy) / 2;
+    ExtTextOut(hdc, x, y, ETO_CLIPPED, &rc, text.c_str(), (UINT)text.size(), NULL);
+}
 
-        std::stringstream ss(line);
-        std::string item;
-        Person p;
+// Menggambar kotak informasi per orang. (ox, oy): titik canvas yang menjadi (0,0) di hdc, agar
+// koordinat yang dikirim ke GDI tetap kecil walaupun canvas sangat lebar
+void DrawBox(HDC hdc, size_t index, const CachedLabel& label, int ox, int oy) {
+    if(!g_Front->model.placed[index]) return;
 
-        // Proses parsing kolom berdasarkan tanda koma (CSV)
-        // 1. Ambil ID
-        std::getline(ss, item, ',');
-        p.id = SafeToInt(item);
+    int x = g_Front->model.posX[index] - ox, y = g_Front->model.posY[index] - oy;
+    RECT rc = { x, y, x + BOX_WIDTH, y + BOX_HEIGHT };
 
-        // Abaikan baris Header (biasanya baris pertama yang berisi teks bukan angka)
-        if (p.id == 0) {
-            std::cout << "[SKIP] Line " << lineNum << ": '" << line << "' (Not an ID)\n";
-            continue;
-        }
+    // Gambar Bayangan (Shadow)
+    RECT rcShadow = rc; OffsetRect(&rcShadow, 4, 4);
+    FillRect(hdc, &rcShadow, g_Res.brShadow);
 
-        // 2. Ambil Nama
-        std::getline(ss, item, ','); p.name = ToWString(item);
-        // 3. Ambil Role/Peran
-        std::getline(ss, item, ','); p.role = ToWString(item);
-        // 4. Ambil Gender
-        std::getline(ss, item, ','); p.gender = ToWString(item);
-        // 5. Ambil ID Ayah
-        std::getline(ss, item, ','); p.fatherId = SafeToInt(item);
-        // 6. Ambil ID Ibu
-        std::getline(ss, item, ','); p.motherId = SafeToInt(item);
-
-        // 7. Ambil Kolom Pasangan (Bisa lebih dari satu, dipisah karakter '|')
-        if (std::getline(ss, item, ',')) {
-            std::stringstream ssSpouse(item);
-            std::string token;
-            while (std::getline(ssSpouse, token, '|')) {
-                if (token.empty()) continue;
-                // Cek jika ada tanda 'x' (menandakan mantan pasangan/cerai)
-                bool isEx = (token.back() == 'x' || token.back() == 'X');
-                if (isEx) token.pop_back();
-
-                int spId = SafeToInt(token);
-                if (spId != 0) {
-                    p.spouses.push_back(spId);
-                    if (isEx) p.exSpouses.insert(spId);
-                }
-            }
-        }
+    // Tentukan warna berdasarkan jenis kelamin
+    bool female = (g_Front->model.people[index].gender == Gender::Female);
+    FillRect(hdc, &rc, female ? g_Res.brFemale : g_Res.brMale);
 
-        // Masukkan objek orang ke dalam model data global
-        g_Model.people.push_back(p);
-        g_Model.idToIndex[p.id] = g_Model.people.size() - 1;
+    // Gambar bingkai hitam
+    FrameRect(hdc, &rc, (HBRUSH)GetStockObject(BLACK_BRUSH));
 
-        std::cout << "[LOAD] OK - ID:" << p.id << "\n";
+    // Gambar Nama (Font Tebal/Bold)
+    {
+        GdiObj font(hdc, g_Res.fontBold);
+        RECT rcText = rc; rcText.bottom -= BOX_HEIGHT/2;
+        DrawCenteredText(hdc, rcText, label.name, label.nameSize);
+    }
+
+    // Gambar Peran/Role (Font Normal)
+    {
+        GdiObj font(hdc, g_Res.fontNorm);
+        RECT rcText = rc; rcText.top += BOX_HEIGHT/2;
+        DrawCenteredText(hdc, rcText, label.role, label.roleSize);
     }
 
-    std::cout << "[STATUS] Finished. Loaded " << g_Model.people.size() << " people.\n";
+    // Tanda ciut/buka di pojok kanan bawah untuk orang yang punya anak ("+" = keturunan disembunyikan)
+    if (HasChildren(g_Front->model, index)) {
+        GdiObj font(hdc, g_Res.fontNorm);
+        RECT rcMark = { rc.right - 14, rc.bottom - 16, rc.right - 2, rc.bottom - 2 };
+        DrawText(hdc, g_Front->model.collapsed[index] ? L"+" : L"-", 1, &rcMark, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
+    }
 }
 
-// -----------------------------------------------------------------------------
-// LAYOUT ENGINE (Logika Penempatan Pohon)
-// -----------------------------------------------------------------------------
+// Kotak polos saat zoom sedang (DetailLevel::Plain): isi warna saja, tanpa bayangan/bingkai/teks
+void DrawPlainBox(HDC hdc, size_t index, int ox, int oy) {
+    if(!g_Front->model.placed[index]) return;
+    int x = g_Front->model.posX[index] - ox, y = g_Front->model.posY[index] - oy;
+    RECT rc = { x, y, x + BOX_WIDTH, y + BOX_HEIGHT };
+    bool female = (g_Front->model.people[index].gender == Gender::Female);
+    FillRect(hdc, &rc, female ? g_Res.brFemale : g_Res.brMale);
+}
 
-// Mengambil daftar anak berdasarkan ID Ayah dan Ibu
-std::vector<int> GetChildren(int fatherId, int motherId) {
-    std::vector<int> children;
-    for (const auto& p : g_Model.people) {
-        if (fatherId != 0 && motherId != 0) {
-            // Anak dari pasangan resmi
-            if (p.fatherId == fatherId && p.motherId == motherId) children.push_back(p.id);
-        }
-        else if (fatherId != 0) {
-            // Hanya diketahui Ayahnya
-            if (p.fatherId == fatherId && (p.motherId == 0)) children.push_back(p.id);
-        }
-        else if (motherId != 0) {
-            // Hanya diketahui Ibunya
-            if (p.motherId == motherId && (p.fatherId == 0)) children.push_back(p.id);
+// Buffer titik untuk PolyPolyline (dipakai ulang tiap frame): solid dan putus-putus terpisah
+struct SegmentBatch {
+    std::vector<POINT> points;
+    std::vector<DWORD> counts;
+    void Clear() { points.clear(); counts.clear(); }
+    // Garis lurus dipotong ke area (garis ke anak-anak bisa sepanjang jutaan piksel), lalu
+    // digeser ke titik asal (ox, oy)
+    void Add(LineSegment s, const Rect& area, int ox, int oy) {
+        if (s.y1 == s.y2) {
+            s.x1 = std::max(area.left - 1, std::min(area.right + 1, s.x1));
+            s.x2 = std::max(area.left - 1, std::min(area.right + 1, s.x2));
+        } else if (s.x1 == s.x2) {
+            s.y1 = std::max(area.top - 1, std::min(area.bottom + 1, s.y1));
+            s.y2 = std::max(area.top - 1, std::min(area.bottom + 1, s.y2));
         }
+        points.push_back({ s.x1 - ox, s.y1 - oy });
+        points.push_back({ s.x2 - ox, s.y2 - oy });
+        counts.push_back(2);
     }
-    return children;
-}
-
-// Rekursi untuk menghitung lebar total yang dibutuhkan sebuah keluarga (sub-pohon)
-int CalculateSubtreeWidth(int personId) {
-    Person* p = g_Model.Get(personId);
-    if (!p) return 0;
-
-    int spouseCount = (int)p->spouses.size();
-    // Lebar blok orang tua: Lebar kotak + (Jumlah pasangan * lebar kotak mereka)
-    int parentsBlockWidth = BOX_WIDTH + (spouseCount * (BOX_WIDTH + SPOUSE_GAP));
-    int childrenTotalWidth = 0;
-
-    // Hitung lebar yang dibutuhkan oleh semua anak-anaknya (secara rekursif)
-    for (int spId : p->spouses) {
-        int f = (p->gender == L"M") ? p->id : spId;
-        int m = (p->gender == L"M") ? spId : p->id;
-        auto children = GetChildren(f, m);
-        for (int childId : children) {
-            childrenTotalWidth += CalculateSubtreeWidth(childId) + H_GAP;
+    void Draw(HDC hdc, HPEN pen) const {
+        if (counts.empty()) return;
+        GdiObj sel(hdc, pen);
+        PolyPolyline(hdc, points.data(), counts.data(), (DWORD)counts.size());
+    }
+};
+SegmentBatch g_SolidLines, g_DottedLines;
+
+// Menggambar garis penghubung milik orang-orang di owners (garis sudah dihitung oleh layout)
+void DrawConnectors(HDC hdc, const std::vector<uint32_t>& owners, const Rect& area, int ox, int oy) {
+    g_SolidLines.Clear();
+    g_DottedLines.Clear();
+    if (g_Front->model.segmentStart.size() != g_Front->model.people.size() + 1) return;
+    for (uint32_t i : owners) {
+        for (uint32_t k = g_Front->model.segmentStart[i]; k < g_Front->model.segmentStart[i + 1]; ++k) {
+            const LineSegment& s = g_Front->model.segments[k];
+            (s.dotted ? g_DottedLines : g_SolidLines).Add(s, area, ox, oy);
         }
     }
+    g_SolidLines.Draw(hdc, g_Res.penStd);
+    g_DottedLines.Draw(hdc, g_Res.penEx);
+}
 
-    // Hitung juga anak dari hubungan tanpa pasangan terdaftar
-    int f = (p->gender == L"M") ? p->id : 0;
-    int m = (p->gender == L"F") ? p->id : 0;
-    if (f != 0 || m != 0) {
-         auto singleChildren = GetChildren(f, m);
-         for (int childId : singleChildren) {
-             childrenTotalWidth += CalculateSubtreeWidth(childId) + H_GAP;
-         }
-    }
+// -----------------------------------------------------------------------------
+// ZOOM & TILES (Canvas digambar per tile 256x256 per level zoom, lalu tile hanya disalin)
+// Level zoom z berarti skala 2^(z/2) piksel layar per piksel canvas. Tile (x, y) di level z menutupi
+// piksel layar [x*256, (x+1)*256) pada skala itu, jadi menggeser tampilan hanya menyalin tile yang
+// sudah ada dan menggambar tile yang baru masuk. Tingkat detail mengikuti ChooseDetail(skala).
+// -----------------------------------------------------------------------------
+const int TILE_SIZE = 256;
+const int ZOOM_MIN_LEVEL = -60;  // 2^-30: cukup untuk melihat canvas selebar 2^31 piksel
+const int ZOOM_MAX_LEVEL = 4;    // 400%
+const size_t TILE_CACHE_SIZE = 160; // Sekitar 40 MB bitmap (32 bit per piksel)
 
-    if (childrenTotalWidth > 0) childrenTotalWidth -= H_GAP;
-    // Lebar pohon adalah yang terbesar antara lebar barisan orang tua vs barisan anak
-    p->subtreeWidth = std::max(parentsBlockWidth, childrenTotalWidth);
-    return p->subtreeWidth;
-}
+struct TileBitmap {
+    HBITMAP bmp = NULL; // Dibuat sekali, dipakai ulang saat tile dikeluarkan dari cache
+};
 
-// Menentukan koordinat X dan Y untuk setiap orang secara rekursif
-void PositionSubtree(int personId, int x, int y) {
-    Person* p = g_Model.Get(personId);
-    if (!p || p->placed) return;
-
-    p->y = y;
-    p->placed = true;
-
-    int spouseCount = (int)p->spouses.size();
-    int parentsBlockWidth = BOX_WIDTH + (spouseCount * (BOX_WIDTH + SPOUSE_GAP));
-    // Menengahkan posisi orang tua terhadap lebar total sub-pohon mereka
-    int currentX = x + (p->subtreeWidth / 2) - (parentsBlockWidth / 2);
-
-    p->x = currentX;
-
-    // Mengatur posisi pasangan di sebelah kanan orang pertama
-    int spouseStartX = currentX + BOX_WIDTH + SPOUSE_GAP;
-    for (int spId : p->spouses) {
-        Person* sp = g_Model.Get(spId);
-        if (sp) {
-            sp->x = spouseStartX;
-            sp->y = y;
-            sp->placed = true;
-            spouseStartX += BOX_WIDTH + SPOUSE_GAP;
-        }
-    }
+int g_ZoomLevel = 0;                      // 0 = 100%
+TileCache<TileBitmap> g_Tiles(TILE_CACHE_SIZE);
+HDC g_TileDC = NULL;                      // DC memori untuk menggambar/menyalin tile
+HDC g_BackDC = NULL;                      // Buffer belakang seukuran jendela (dibuat ulang hanya saat ukuran berubah)
+HBITMAP g_BackBM = NULL, g_BackOldBM = NULL;
+int g_BackW = 0, g_BackH = 0;
+std::vector<OverviewBlock> g_Blocks;      // Hasil query blok ringkasan (dipakai ulang)
+size_t g_TilesRendered = 0;               // Tile yang digambar pada frame terakhir
 
-    // Mengatur posisi anak-anak di level berikutnya (bawah)
-    int childStartX = x;
-    auto LayoutBatch = [&](const std::vector<int>& kids) {
-        for (int childId : kids) {
-            Person* child = g_Model.Get(childId);
-            if(child) {
-                // Rekursi untuk anak
-                PositionSubtree(childId, childStartX, y + V_GAP);
-                childStartX += child->subtreeWidth + H_GAP;
-            }
-        }
-    };
+double ZoomScale(int level) { return std::pow(2.0, level / 2.0); }
 
-    // Panggil fungsi penempatan untuk tiap kelompok anak
-    for (int spId : p->spouses) {
-        int f = (p->gender == L"M") ? p->id : spId;
-        int m = (p->gender == L"M") ? spId : p->id;
-        LayoutBatch(GetChildren(f, m));
-    }
+// Pembagian yang membulatkan ke bawah juga untuk bilangan negatif
+long long FloorDiv(long long a, long long b) { return (a >= 0 ? a : a - b + 1) / b; }
 
-    int f = (p->gender == L"M") ? p->id : 0;
-    int m = (p->gender == L"F") ? p->id : 0;
-    LayoutBatch(GetChildren(f, m));
+int ClampToInt(double v) {
+    return (int)std::max(-2147483647.0, std::min(2147483647.0, v));
 }
 
-// Fungsi utama untuk mengatur ulang seluruh tata letak pohon
-void RecalculateLayout() {
-    for (auto& p : g_Model.people) {
-        p.placed = false;
-        p.subtreeWidth = 0;
-    }
-    g_Model.maxX = 0;
-    g_Model.maxY = 0;
-
-    int currentRootX = 50; // Titik awal penggambaran
-    int startY = 50;
-
-    for (auto& p : g_Model.people) {
-        // Mencari Akar (Orang yang tidak punya Ayah & Ibu di data)
-        if (p.fatherId == 0 && p.motherId == 0 && !p.placed) {
-            bool isLeader = true;
-            // Jika punya pasangan, hanya proses orang dengan ID terkecil sebagai titik awal
-            for(int spId : p.spouses) {
-                if(spId < p.id) { isLeader = false; break; }
-            }
+// Data/layout/status ciut berubah: semua tile digambar ulang (bitmapnya tetap dipakai)
+void InvalidateTiles() {
+    g_Tiles.Invalidate();
+}
 
-            if (isLeader) {
-                std::cout << "[LAYOUT] Positioning Root: " << p.id << "\n";
-                int w = CalculateSubtreeWidth(p.id);
-                PositionSubtree(p.id, currentRootX, startY);
-                currentRootX += w + H_GAP + 50;
-            }
+// Menggambar satu tile ke dc (bitmap TILE_SIZE x TILE_SIZE sudah terpilih)
+void RenderTile(HDC dc, const TileKey& key) {
+    RECT full = { 0, 0, TILE_SIZE, TILE_SIZE };
+    FillRect(dc, &full, g_Res.brCanvas);
+
+    double scale = ZoomScale(key.level);
+    double left = key.x * (double)TILE_SIZE / scale, top = key.y * (double)TILE_SIZE / scale;
+    // Area canvas tile ini, sedikit diperlebar untuk pembulatan skala
+    Rect area = { ClampToInt(std::floor(left)) - 8, ClampToInt(std::floor(top)) - 8,
+                  ClampToInt(std::ceil(left + TILE_SIZE / scale)) + 1, ClampToInt(std::ceil(top + TILE_SIZE / scale)) + 1 };
+    DetailLevel detail = ChooseDetail(scale);
+
+    if (detail == DetailLevel::Blocks) { // Blok ringkasan langsung dalam koordinat tile
+        const OverviewPyramid& overview = g_Front->scene.overview;
+        overview.Query(overview.LevelForScale(scale), area, g_Blocks);
+        for (const OverviewBlock& b : g_Blocks) {
+            int l = (int)std::floor((b.rect.left - left) * scale), t = (int)std::floor((b.rect.top - top) * scale);
+            RECT rc = { l, t, std::max(l + 1, (int)std::floor((b.rect.right - left) * scale)),
+                        std::max(t + 1, (int)std::floor((b.rect.bottom - top) * scale)) };
+            int shade = b.people ? (int)(((uint64_t)b.females * (BLOCK_SHADES - 1) * 2 + b.people) / (2 * (uint64_t)b.people)) : 0;
+            FillRect(dc, &rc, g_Res.brBlock[shade]);
         }
+        AddCounter(Counter::BoxesDrawn, g_Blocks.size());
+        return;
     }
 
-    // Update dimensi maksimum untuk area scrollbar
-    for (const auto& p : g_Model.people) {
-        if (p.placed) {
-            g_Model.maxX = std::max(g_Model.maxX, p.x + BOX_WIDTH);
-            g_Model.maxY = std::max(g_Model.maxY, p.y + BOX_HEIGHT);
-        }
+    // Kotak dan garis: koordinat relatif terhadap titik canvas bulat (ox, oy), sisa pecahannya
+    // dan skala lewat world transform (tetap kecil sehingga presisi float cukup)
+    int ox = (int)std::floor(left), oy = (int)std::floor(top);
+    int savedDC = SaveDC(dc);
+    SetGraphicsMode(dc, GM_ADVANCED);
+    XFORM xform = { (float)scale, 0, 0, (float)scale, (float)(-(left - ox) * scale), (float)(-(top - oy) * scale) };
+    SetWorldTransform(dc, &xform);
+    SetBkMode(dc, TRANSPARENT);
+
+    // Garis dulu baru kotak agar kotak menimpa garis
+    g_Front->scene.connectors.Query(area, g_Visible);
+    DrawConnectors(dc, g_Visible, area, ox, oy);
+    g_Front->scene.boxes.Query(area, g_Visible);
+    if (detail == DetailLevel::Full) {
+        for (uint32_t i : g_Visible) DrawBox(dc, i, GetLabel(dc, i), ox, oy);
+    } else {
+        for (uint32_t i : g_Visible) DrawPlainBox(dc, i, ox, oy);
     }
-    g_Model.maxX += 50;
-    g_Model.maxY += 50;
+    AddCounter(Counter::BoxesDrawn, g_Visible.size());
+    RestoreDC(dc, savedDC);
+}
+
+// Buffer belakang dan DC tile; dibuat ulang hanya jika ukuran jendela berubah
+void EnsureBackBuffer(HDC hdc, int width, int height) {
+    if (!g_TileDC) g_TileDC = CreateCompatibleDC(hdc);
+    if (g_BackDC && g_BackW == width && g_BackH == height) return;
+    if (!g_BackDC) g_BackDC = CreateCompatibleDC(hdc);
+    if (g_BackBM) { SelectObject(g_BackDC, g_BackOldBM); DeleteObject(g_BackBM); }
+    g_BackBM = CreateCompatibleBitmap(hdc, std::max(width, 1), std::max(height, 1));
+    g_BackOldBM = (HBITMAP)SelectObject(g_BackDC, g_BackBM);
+    g_BackW = width; g_BackH = height;
+}
+
+void DestroyTileResources() {
+    g_Tiles.ForEach([](TileBitmap& t) { if (t.bmp) DeleteObject(t.bmp); t.bmp = NULL; });
+    g_Tiles.Invalidate();
+    if (g_BackDC) { SelectObject(g_BackDC, g_BackOldBM); DeleteDC(g_BackDC); g_BackDC = NULL; }
+    if (g_BackBM) { DeleteObject(g_BackBM); g_BackBM = NULL; }
+    if (g_TileDC) { DeleteDC(g_TileDC); g_TileDC = NULL; }
+    g_BackW = g_BackH = 0;
 }
 
 // -----------------------------------------------------------------------------
-// RENDERING (Proses Menggambar ke Layar)
+// STATS OVERLAY (F3: tampilkan/sembunyikan, F4: simpan statistik ke JSON)
 // -----------------------------------------------------------------------------
+const char* STATS_FILE = "silsilah_stats.json"; // Tujuan dump statistik (F4)
+bool g_ShowStats = false;  // Overlay statistik di pojok kiri atas jendela
+int g_RelateFrom = 0;      // ID orang pertama yang dipilih dengan klik kanan (0 = belum ada)
+double g_LastFrameMs = 0;  // Durasi frame sebelumnya (frame yang sedang digambar belum selesai)
+
+// Menggambar ringkasan statistik dalam koordinat jendela (bukan canvas)
+void DrawStatsOverlay(HDC hdc) {
+    StageStats paint = GetStageStats(Stage::Paint);
+    StageStats layout = GetStageStats(Stage::Layout);
+    StageStats connectors = GetStageStats(Stage::Connectors);
+    AllocStats alloc = GetAllocStats();
+
+    const int LINES = 6, LINE_H = 16;
+    static const wchar_t* DETAIL_NAMES[] = { L"full", L"plain", L"blocks" };
+    double scale = ZoomScale(g_ZoomLevel);
+    wchar_t text[LINES][128];
+    swprintf(text[0], 128, L"frame %.2f ms (max %.2f ms)", g_LastFrameMs, paint.maxMs);
+    swprintf(text[1], 128, L"last reload %.1f ms (generation %llu)", g_Front->buildMs, (unsigned long long)g_Front->generation);
+    swprintf(text[2], 128, L"layout %ls %.1f ms, connectors %.1f ms",
+             g_Front->model.layoutMode == LayoutMode::Compact ? L"compact" : L"classic", layout.lastMs, connectors.lastMs);
+    swprintf(text[3], 128, L"people %llu, zoom %.3g%% (%ls)", (unsigned long long)g_Front->model.people.size(), scale * 100,
+             DETAIL_NAMES[(int)ChooseDetail(scale)]);
+    swprintf(text[4], 128, L"tiles drawn %llu, cached %llu/%llu", (unsigned long long)g_TilesRendered,
+             (unsigned long long)g_Tiles.Size(), (unsigned long long)g_Tiles.Capacity());
+    if (AllocTrackingEnabled()) swprintf(text[5], 128, L"allocations %llu (%.1f MB)", (unsigned long long)alloc.count, alloc.bytes / (1024.0 * 1024.0));
+    else swprintf(text[5], 128, L"allocations not tracked");
+
+    RECT box = { 8, 8, 288, 8 + LINES * LINE_H + 8 };
+    FillRect(hdc, &box, (HBRUSH)GetStockObject(WHITE_BRUSH));
+    FrameRect(hdc, &box, (HBRUSH)GetStockObject(BLACK_BRUSH));
+    GdiObj font(hdc, g_Res.fontNorm);
+    for (int i = 0; i < LINES; ++i) TextOut(hdc, box.left + 6, box.top + 4 + i * LINE_H, text[i], (int)wcslen(text[i]));
+}
 
-// Menggambar kotak informasi per orang
-void DrawBox(HDC hdc, Person* p) {
-    if(!p->placed) return;
+// -----------------------------------------------------------------------------
+// WINDOW PROCEDURE (Logika Interaksi Jendela)
+// -----------------------------------------------------------------------------
+// Posisi scroll saat ini: titik canvas di pojok kiri atas jendela. Scrollbar juga memakai satuan
+// piksel canvas (32 bit, posisi geser dibaca dari nTrackPos), jadi canvas selebar apa pun terjangkau.
+int xScroll = 0, yScroll = 0;
 
-    RECT rc = { p->x, p->y, p->x + BOX_WIDTH, p->y + BOX_HEIGHT };
+// Update status dan range scrollbar berdasarkan luas pohon (halaman = luas jendela pada zoom saat ini)
+void UpdateScrollBars(HWND hwnd) {
+    RECT rc; GetClientRect(hwnd, &rc);
+    double scale = ZoomScale(g_ZoomLevel);
+    SCROLLINFO si = { sizeof(SCROLLINFO), SIF_ALL };
 
-    // Gambar Bayangan (Shadow)
-    RECT rcShadow = rc; OffsetRect(&rcShadow, 4, 4);
-    HBRUSH hShadow = CreateSolidBrush(RGB(220, 220, 220));
-    FillRect(hdc, &rcShadow, hShadow);
-    DeleteObject(hShadow);
+    si.nMax = g_Front->model.maxY; si.nPos = yScroll;
+    si.nPage = (UINT)std::min(rc.bottom / scale, g_Front->model.maxY + 1.0);
+    SetScrollInfo(hwnd, SB_VERT, &si, TRUE);
 
-    // Tentukan warna berdasarkan jenis kelamin
-    COLORREF bgCol = (p->gender == L"F" || p->gender == L"f") ? COL_BOX_FEM : COL_BOX_MALE;
-    HBRUSH hBg = CreateSolidBrush(bgCol);
-    FillRect(hdc, &rc, hBg);
-    DeleteObject(hBg);
+    si.nMax = g_Front->model.maxX; si.nPos = xScroll;
+    si.nPage = (UINT)std::min(rc.right / scale, g_Front->model.maxX + 1.0);
+    SetScrollInfo(hwnd, SB_HORZ, &si, TRUE);
+}
 
-    // Gambar bingkai hitam
-    FrameRect(hdc, &rc, (HBRUSH)GetStockObject(BLACK_BRUSH));
-    SetBkMode(hdc, TRANSPARENT);
+// Scroll dijaga tetap di dalam canvas
+void ClampScroll() {
+    xScroll = std::max(0, std::min(xScroll, g_Front->model.maxX));
+    yScroll = std::max(0, std::min(yScroll, g_Front->model.maxY));
+}
 
-    // Gambar Nama (Font Tebal/Bold)
-    HFONT hFontBold = CreateFont(16, 0, 0, 0, FW_BOLD, 0, 0, 0, DEFAULT_CHARSET, 0, 0, DEFAULT_QUALITY, 0, L"Segoe UI");
-    {
-        GdiObj font(hdc, hFontBold);
-        RECT rcText = rc; rcText.bottom -= BOX_HEIGHT/2;
-        DrawText(hdc, p->name.c_str(), -1, &rcText, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
+// Satu langkah panah scrollbar: 10 piksel layar
+int LineStep() {
+    return std::max(1, (int)(10 / ZoomScale(g_ZoomLevel)));
+}
+
+// Posisi layar (piksel) pojok kiri atas jendela pada skala zoom saat ini
+long long ViewX(double scale) { return (long long)std::floor(xScroll * scale); }
+long long ViewY(double scale) { return (long long)std::floor(yScroll * scale); }
+
+// Titik canvas di bawah posisi mouse; false jika zoom terlalu jauh untuk memilih satu kotak
+bool CanvasPoint(LPARAM lParam, int& x, int& y) {
+    double scale = ZoomScale(g_ZoomLevel);
+    x = ClampToInt(std::floor((GET_X_LPARAM(lParam) + ViewX(scale)) / scale));
+    y = ClampToInt(std::floor((GET_Y_LPARAM(lParam) + ViewY(scale)) / scale));
+    return ChooseDetail(scale) != DetailLevel::Blocks;
+}
+
+// Level zoom saat seluruh pohon muat di jendela (batas zoom keluar, tidak lebih dari 100%)
+int FitZoomLevel(HWND hwnd) {
+    RECT rc; GetClientRect(hwnd, &rc);
+    double fit = std::min(rc.right / (double)std::max(1, g_Front->model.maxX), rc.bottom / (double)std::max(1, g_Front->model.maxY));
+    int level = fit > 0 ? (int)std::floor(2 * std::log2(fit)) : 0;
+    return std::max(ZOOM_MIN_LEVEL, std::min(0, level));
+}
+
+// Ganti level zoom; titik canvas di bawah (ax, ay) (koordinat jendela) tetap di tempatnya
+void SetZoom(HWND hwnd, int level, int ax, int ay) {
+    level = std::max(FitZoomLevel(hwnd), std::min(ZOOM_MAX_LEVEL, level));
+    if (level == g_ZoomLevel) return;
+    double oldScale = ZoomScale(g_ZoomLevel), newScale = ZoomScale(level);
+    double cx = (ax + ViewX(oldScale)) / oldScale, cy = (ay + ViewY(oldScale)) / oldScale;
+    g_ZoomLevel = level;
+    xScroll = ClampToInt(std::floor(cx - ax / newScale));
+    yScroll = ClampToInt(std::floor(cy - ay / newScale));
+    ClampScroll();
+    UpdateScrollBars(hwnd);
+    InvalidateRect(hwnd, NULL, TRUE);
+    if (LogEnabled(LogLevel::Verbose)) {
+        std::cout << "[ZOOM] scale=" << newScale << " detail=" << (int)ChooseDetail(newScale) << "\n";
     }
-    DeleteObject(hFontBold);
+}
 
-    // Gambar Peran/Role (Font Normal)
-    HFONT hFontNorm = CreateFont(14, 0, 0, 0, FW_NORMAL, 0, 0, 0, DEFAULT_CHARSET, 0, 0, DEFAULT_QUALITY, 0, L"Segoe UI");
-    {
-        GdiObj font(hdc, hFontNorm);
-        RECT rcText = rc; rcText.top += BOX_HEIGHT/2;
-        DrawText(hdc, p->role.c_str(), -1, &rcText, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
+// Bingkai sorot tebal di luar kotak orang hasil pencarian (digambar di atas tile, bukan di dalamnya,
+// agar tile tidak perlu digambar ulang saat sorotan pindah)
+void DrawHighlight(HDC dc) {
+    size_t index = g_Front->model.IndexOf(g_Highlight);
+    if (index == IdIndex::NPOS || !g_Front->model.placed[index]) return;
+    double scale = ZoomScale(g_ZoomLevel);
+    double x = g_Front->model.posX[index] * scale - ViewX(scale), y = g_Front->model.posY[index] * scale - ViewY(scale);
+    int left = ClampToInt(std::floor(x)), top = ClampToInt(std::floor(y));
+    RECT rc = { left, top, std::max(left + 1, ClampToInt(std::floor(x + BOX_WIDTH * scale))),
+                std::max(top + 1, ClampToInt(std::floor(y + BOX_HEIGHT * scale))) };
+    for (int k = 0; k < 3; ++k) {
+        InflateRect(&rc, 1, 1);
+        FrameRect(dc, &rc, g_Res.brHighlight);
     }
-    DeleteObject(hFontNorm);
 }
 
-// Menggambar garis penghubung antar anggota keluarga
-void DrawConnectors(HDC hdc) {
-    HPEN hPenStd = CreatePen(PS_SOLID, 1, COL_LINE);       // Pena untuk garis solid
-    HPEN hPenEx = CreatePen(PS_DOT, 1, COL_LINE_EX);      // Pena untuk garis putus-putus (mantan)
-    GdiObj pen(hdc, hPenStd);
-
-    for (auto& p : g_Model.people) {
-        if (!p.placed) continue;
-
-        POINT pCenter = { p.x + BOX_WIDTH/2, p.y + BOX_HEIGHT/2 };
-        POINT pBottom = { p.x + BOX_WIDTH/2, p.y + BOX_HEIGHT };
-
-        // 1. Gambar garis ke pasangan
-        for (int spId : p.spouses) {
-            if (spId > p.id) { // Gambar sekali saja (mencegah double line)
-                Person* sp = g_Model.Get(spId);
-                if (sp && sp->placed) {
-                    bool isEx = (p.exSpouses.count(spId) > 0);
-                    POINT spCenter = { sp->x + BOX_WIDTH/2, sp->y + BOX_HEIGHT/2 };
-
-                    HGDIOBJ oldPen = SelectObject(hdc, isEx ? hPenEx : hPenStd);
-                    MoveToEx(hdc, pCenter.x, pCenter.y, NULL);
-                    LineTo(hdc, spCenter.x, spCenter.y); // Garis horizontal antar pasangan
-                    SelectObject(hdc, oldPen);
-
-                    // Ambil daftar anak dari pasangan ini
-                    int f = (p.gender == L"M") ? p.id : spId;
-                    int m = (p.gender == L"M") ? spId : p.id;
-                    auto kids = GetChildren(f, m);
-
-                    if (!kids.empty()) {
-                        // Tarik garis turun dari tengah-tengah pasangan
-                        int midX = (pCenter.x + spCenter.x) / 2;
-                        MoveToEx(hdc, midX, pCenter.y, NULL);
-                        LineTo(hdc, midX, pCenter.y + BOX_HEIGHT/2 + 15);
-
-                        int minKidX = 100000, maxKidX = -100000;
-                        for(int kId : kids) {
-                             Person* k = g_Model.Get(kId);
-                             if(k && k->placed) {
-                                 int kCx = k->x + BOX_WIDTH/2;
-                                 if(kCx < minKidX) minKidX = kCx;
-                                 if(kCx > maxKidX) maxKidX = kCx;
-                             }
-                        }
+// Setelah status ciut atau mode layout berubah di UI: grid gambar dibangun ulang, loader diberi
+// status terbaru (versi berikutnya ikut status ini), lalu scroll dijaga tetap di dalam canvas
+void OnLayoutChanged(HWND hwnd) {
+    BuildSceneIndex(g_Front->model, g_Front->scene);
+    InvalidateTiles();
+    g_Front->snapshotDirty = true; // Status ciut dan layoutnya ikut tersimpan di snapshot saat jendela ditutup
+    g_Loader.SetCollapsedIds(CollapsedIds(g_Front->model));
+    g_Loader.SetLayoutMode(g_Front->model.layoutMode);
+    ClampScroll();
+    UpdateScrollBars(hwnd);
+    InvalidateRect(hwnd, NULL, TRUE);
+}
 
-                        // Jika anak > 1, buat garis horizontal (fork) untuk menghubungkan semua anak
-                        if (kids.size() == 1) {
-                             LineTo(hdc, midX, pBottom.y + V_GAP);
-                        } else {
-                             MoveToEx(hdc, minKidX, pCenter.y + BOX_HEIGHT/2 + 15, NULL);
-                             LineTo(hdc, maxKidX, pCenter.y + BOX_HEIGHT/2 + 15);
-
-                             // Tarik garis vertikal ke masing-masing anak
-                             for(int kId : kids) {
-                                 Person* k = g_Model.Get(kId);
-                                 if(k && k->placed) {
-                                     MoveToEx(hdc, k->x + BOX_WIDTH/2, pCenter.y + BOX_HEIGHT/2 + 15, NULL);
-                                     LineTo(hdc, k->x + BOX_WIDTH/2, k->y);
-                                 }
-                             }
-                        }
-                    }
-                }
-            }
-        }
+// Orang yang kotaknya paling dekat dengan tengah jendela (NPOS jika tidak ada yang terlihat)
+size_t CenterPerson(HWND hwnd) {
+    RECT rc; GetClientRect(hwnd, &rc);
+    double scale = ZoomScale(g_ZoomLevel);
+    Rect view = { xScroll, yScroll, ClampToInt(xScroll + rc.right / scale), ClampToInt(yScroll + rc.bottom / scale) };
+    g_Front->scene.boxes.Query(view, g_Visible);
+    const DataModel& model = g_Front->model;
+    double cx = (view.left + view.right) / 2.0, cy = (view.top + view.bottom) / 2.0, best = 0;
+    size_t found = IdIndex::NPOS;
+    for (uint32_t i : g_Visible) {
+        double dx = model.posX[i] + BOX_WIDTH / 2 - cx, dy = model.posY[i] + BOX_HEIGHT / 2 - cy;
+        if (found == IdIndex::NPOS || dx * dx + dy * dy < best) { found = i; best = dx * dx + dy * dy; }
+    }
+    return found;
+}
 
-        // 2. Garis untuk anak dari orang tua tunggal
-        int f = (p.gender == L"M") ? p.id : 0;
-        int m = (p.gender == L"F") ? p.id : 0;
-        auto singleKids = GetChildren(f, m);
-        if(!singleKids.empty()) {
-             MoveToEx(hdc, pBottom.x, pBottom.y, NULL);
-             LineTo(hdc, pBottom.x, pBottom.y + 15);
-             for(int kId : singleKids) {
-                 Person* k = g_Model.Get(kId);
-                 if(k && k->placed) {
-                     MoveToEx(hdc, pBottom.x, pBottom.y + 15, NULL);
-                     LineTo(hdc, k->x + BOX_WIDTH/2, k->y);
-                 }
-             }
-        }
+// Tombol L: layout ulang seluruh pohon dengan mode lain. Orang di tengah jendela tetap di
+// tempat yang sama di layar agar pengguna tidak kehilangan posisinya.
+void SwitchLayoutMode(HWND hwnd) {
+    DataModel& model = g_Front->model;
+    if (model.people.empty()) return;
+    size_t anchor = CenterPerson(hwnd);
+    int anchorId = (anchor != IdIndex::NPOS) ? model.people[anchor].id : 0;
+    int screenX = (anchor != IdIndex::NPOS) ? model.posX[anchor] - xScroll : 0;
+    int screenY = (anchor != IdIndex::NPOS) ? model.posY[anchor] - yScroll : 0;
+
+    model.layoutMode = (model.layoutMode == LayoutMode::Compact) ? LayoutMode::Classic : LayoutMode::Compact;
+    auto start = std::chrono::steady_clock::now();
+    UpdateLayout(model, std::vector<int>()); // Lebar classic yang masih berlaku dipakai ulang
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (LogEnabled(LogLevel::Info)) {
+        std::cout << "[LAYOUT] Mode " << LayoutModeName(model.layoutMode) << ": canvas " << model.maxX << "x" << model.maxY
+                  << " in " << ms << " ms\n";
+    }
+
+    anchor = model.IndexOf(anchorId);
+    if (anchorId != 0 && anchor != IdIndex::NPOS && model.placed[anchor]) {
+        xScroll = model.posX[anchor] - screenX;
+        yScroll = model.posY[anchor] - screenY;
     }
-    DeleteObject(hPenStd);
-    DeleteObject(hPenEx);
+    OnLayoutChanged(hwnd);
 }
 
 // -----------------------------------------------------------------------------
-// WINDOW PROCEDURE (Logika Interaksi Jendela)
+// FIND (Ctrl+F: kotak cari nama/peran, Enter = hasil berikutnya, Shift+Enter = sebelumnya, Esc = tutup)
 // -----------------------------------------------------------------------------
-int xScroll = 0, yScroll = 0; // Posisi scroll saat ini
+const int FIND_WIDTH = 260, FIND_HEIGHT = 24; // Ukuran kotak cari di pojok kanan atas
+HWND g_FindBox = NULL;              // Kontrol EDIT, dibuat saat Ctrl+F pertama kali
+std::string g_FindQuery;            // Teks kotak cari (UTF-8)
+std::vector<SearchHit> g_FindHits;  // Hasil terbaik untuk g_FindQuery (indeks g_Front->model)
+size_t g_FindTotal = 0;             // Jumlah seluruh orang yang cocok
+size_t g_FindPos = 0;               // Hasil yang sedang disorot
+
+// Unicode -> UTF-8 (kebalikan ToWString) untuk teks dari kontrol EDIT
+std::string ToUtf8(const std::wstring& text) {
+    if (text.empty()) return std::string();
+    int len = WideCharToMultiByte(CP_UTF8, 0, text.c_str(), (int)text.size(), NULL, 0, NULL, NULL);
+    std::string out(len > 0 ? len : 0, '\0');
+    if (len > 0) WideCharToMultiByte(CP_UTF8, 0, text.c_str(), (int)text.size(), &out[0], len, NULL, NULL);
+    return out;
+}
 
-// Update status dan range scrollbar berdasarkan luas pohon
-void UpdateScrollBars(HWND hwnd) {
+// Kotak cari menempel di pojok kanan atas area client
+void PlaceFindBox(HWND hwnd) {
+    if (!g_FindBox) return;
     RECT rc; GetClientRect(hwnd, &rc);
-    SCROLLINFO si = { sizeof(SCROLLINFO), SIF_ALL };
+    MoveWindow(g_FindBox, rc.right - FIND_WIDTH - 8, 8, FIND_WIDTH, FIND_HEIGHT, TRUE);
+}
 
-    si.nMax = g_Model.maxY; si.nPage = rc.bottom; si.nPos = yScroll;
-    SetScrollInfo(hwnd, SB_VERT, &si, TRUE);
+// Gulir agar orang dengan ID ini berada di tengah jendela dan beri bingkai sorot. Leluhur yang
+// diciutkan dibuka dulu (layout inkremental) agar kotaknya terlihat.
+void JumpToPerson(HWND hwnd, int id) {
+    DataModel& model = g_Front->model;
+    size_t index = model.IndexOf(id);
+    if (index == IdIndex::NPOS) return;
+    LayoutStats st = RevealPerson(model, id, 1);
+    if (st.widthsComputed > 0) OnLayoutChanged(hwnd);
+    if (!model.placed[index]) return;
+
+    // Zoom jauh: kembali ke 100% agar nama orang itu terbaca
+    if (ChooseDetail(ZoomScale(g_ZoomLevel)) != DetailLevel::Full) g_ZoomLevel = 0;
+    double scale = ZoomScale(g_ZoomLevel);
+    RECT rc; GetClientRect(hwnd, &rc);
+    xScroll = ClampToInt(model.posX[index] + BOX_WIDTH / 2 - rc.right / 2 / scale);
+    yScroll = ClampToInt(model.posY[index] + BOX_HEIGHT / 2 - rc.bottom / 2 / scale);
+    ClampScroll();
+    g_Highlight = id;
+    UpdateScrollBars(hwnd);
+    InvalidateRect(hwnd, NULL, TRUE);
+}
 
-    si.nMax = g_Model.maxX; si.nPage = rc.right; si.nPos = xScroll;
-    SetScrollInfo(hwnd, SB_HORZ, &si, TRUE);
+// Cari ulang g_FindQuery di versi data yang sedang digambar. jump: langsung lompat ke hasil pertama.
+void RunFind(HWND hwnd, bool jump) {
+    g_FindHits.clear();
+    g_FindTotal = 0;
+    g_FindPos = 0;
+    if (g_FindQuery.empty()) {
+        if (g_Highlight) { g_Highlight = 0; InvalidateRect(hwnd, NULL, TRUE); }
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    SearchOptions options;
+    options.limit = 200;
+    g_FindTotal = g_Front->search.Find(g_Front->model, g_FindQuery, options, g_FindHits);
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    if (LogEnabled(LogLevel::Info)) {
+        std::cout << "[SEARCH] \"" << g_FindQuery << "\" matches=" << g_FindTotal << " find_us=" << us << "\n";
+    }
+    if (jump && !g_FindHits.empty()) JumpToPerson(hwnd, g_Front->model.people[g_FindHits[0].index].id);
+}
+
+// Enter/Shift+Enter: pindah ke hasil berikutnya/sebelumnya (memutar)
+void StepFind(HWND hwnd, bool backward) {
+    if (g_FindHits.empty()) return;
+    size_t n = g_FindHits.size();
+    g_FindPos = backward ? (g_FindPos + n - 1) % n : (g_FindPos + 1) % n;
+    const Person& p = g_Front->model.people[g_FindHits[g_FindPos].index];
+    JumpToPerson(hwnd, p.id);
+    if (LogEnabled(LogLevel::Info)) {
+        std::cout << "[SEARCH] " << (g_FindPos + 1) << "/" << n << (g_FindTotal > n ? "+" : "") << " "
+                  << g_Front->model.Text(p.name) << " (ID " << p.id << ")\n";
+    }
+}
+
+// Ctrl+F: tampilkan kotak cari (dibuat sekali) dan pilih seluruh teksnya
+void ShowFindBox(HWND hwnd) {
+    if (!g_FindBox) {
+        g_FindBox = CreateWindowEx(0, L"EDIT", L"", WS_CHILD | WS_BORDER | ES_AUTOHSCROLL,
+                                   0, 0, FIND_WIDTH, FIND_HEIGHT, hwnd, NULL, GetModuleHandle(NULL), NULL);
+        if (!g_FindBox) return;
+        SendMessage(g_FindBox, WM_SETFONT, (WPARAM)g_Res.fontNorm, TRUE);
+    }
+    PlaceFindBox(hwnd);
+    ShowWindow(g_FindBox, SW_SHOW);
+    SendMessage(g_FindBox, EM_SETSEL, 0, -1);
+    SetFocus(g_FindBox);
+}
+
+// Tombol di dalam kotak cari (dipanggil dari message loop karena kontrol EDIT tidak meneruskannya).
+// true jika tombol sudah ditangani.
+bool OnFindKey(WPARAM key) {
+    HWND hwnd = GetParent(g_FindBox);
+    if (key == VK_RETURN) {
+        StepFind(hwnd, GetKeyState(VK_SHIFT) < 0);
+        return true;
+    }
+    if (key == VK_ESCAPE) { // Tutup kotak; sorotan tetap sampai teks cari dikosongkan
+        ShowWindow(g_FindBox, SW_HIDE);
+        SetFocus(hwnd);
+        return true;
+    }
+    return false;
 }
 
 // Fungsi pengolah pesan dari sistem operasi Windows
 LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     switch(msg) {
         case WM_CREATE: // Saat jendela baru dibuat
-            LoadData();
-            RecalculateLayout();
-            SetTimer(hwnd, 1, 1000, NULL); // Timer 1 detik untuk cek update file otomatis
+            g_Res.Create(); // Font, brush, dan pena dibuat sekali untuk seumur jendela
+            // Load pertama (snapshot atau CSV) dan layout berjalan di thread latar; jendela langsung
+            // tampil kosong dan digambar ulang begitu WM_MODEL_READY datang
+            g_Loader.Start(DATA_FILE_A, [hwnd]() { PostMessage(hwnd, WM_MODEL_READY, 0, 0); });
+            // Pantau file: notifikasi dari sistem (fallback polling), beberapa simpanan beruntun digabung jadi satu
+            g_Watcher.Start(DATA_FILE_A, [hwnd]() { PostMessage(hwnd, WM_FILE_CHANGED, 0, 0); });
+            std::cout << "[WATCH] Live reload backend: " << g_Watcher.BackendName() << "\n";
+            break;
+
+        case WM_FILE_CHANGED: // File CSV disimpan ulang
+            // Reload inkremental di thread latar; versi yang sedang dibangun (jika ada) dibatalkan
+            g_Loader.Request();
+            break;
+
+        case WM_MODEL_READY: // Versi baru selesai dibangun di thread latar
+            {
+                std::unique_ptr<LoadedScene> next = g_Loader.TakeResult();
+                if (!next) break; // Sudah diambil oleh pesan sebelumnya
+                const ReloadResult& r = next->reload;
+                if (next->generation > 1) { // Load pertama tidak dilaporkan sebagai reload
+                    std::cout << "[RELOAD] added=" << r.added << " removed=" << r.removed << " modified=" << r.modified
+                              << " widths_recomputed=" << next->layout.widthsComputed
+                              << " roots_repositioned=" << next->layout.rootsPositioned << "\n";
+                }
+
+                // Klik ciut/buka atau ganti mode layout yang terjadi saat versi ini dibangun belum ikut: samakan dulu
+                if (!g_Front->model.people.empty()) {
+                    std::vector<int> dirtyIds = ApplyCollapsedIds(next->model, CollapsedIds(g_Front->model));
+                    bool modeChanged = (next->model.layoutMode != g_Front->model.layoutMode);
+                    next->model.layoutMode = g_Front->model.layoutMode;
+                    if (!dirtyIds.empty() || modeChanged) {
+                        UpdateLayout(next->model, dirtyIds, 1);
+                        BuildSceneIndex(next->model, next->scene);
+                    }
+                }
+
+                // Tukar buffer: versi lama dikembalikan ke loader sebagai basis reload berikutnya
+                std::swap(g_Front, next);
+                g_Loader.Recycle(std::move(next));
+
+                InvalidateLabels(); // Teks/urutan orang bisa berubah, ukur ulang saat digambar
+                InvalidateTiles();
+                RunFind(hwnd, false); // Indeks hasil cari lama menunjuk versi sebelumnya; sorotan tetap per ID
+                ClampScroll();
+                UpdateScrollBars(hwnd);
+                InvalidateRect(hwnd, NULL, TRUE); // Memicu WM_PAINT
+            }
+            break;
+
+        case WM_LBUTTONDOWN: // Klik kotak: ciutkan/buka keturunan orang itu
+            {
+                int x, y;
+                if (!CanvasPoint(lParam, x, y)) break;
+                g_Front->scene.boxes.Query({ x, y, x + 1, y + 1 }, g_Visible);
+                DataModel& model = g_Front->model;
+                for (uint32_t i : g_Visible) {
+                    if (!HasChildren(model, i)) continue;
+                    // Serial: layout paralel mengelompokkan seluruh data dulu, terlalu mahal untuk satu klik
+                    auto start = std::chrono::steady_clock::now();
+                    LayoutStats st = SetCollapsed(model, model.people[i].id, !model.collapsed[i], 1);
+                    OnLayoutChanged(hwnd);
+                    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                    if (LogEnabled(LogLevel::Info)) {
+                        std::cout << "[COLLAPSE] ID " << model.people[i].id << (model.collapsed[i] ? " collapsed" : " expanded")
+                                  << " widths_recomputed=" << st.widthsComputed << " ms=" << ms << "\n";
+                    }
+                    break;
+                }
+            }
             break;
 
-        case WM_TIMER: // Kejadian setiap detik (cek file)
+        case WM_RBUTTONDOWN: // Klik kanan dua orang: cetak hubungan orang pertama terhadap orang kedua
             {
-                FILETIME oldT = g_Model.lastWriteTime;
-                LoadData();
-                // Jika file berubah, refresh tampilan
-                if (CompareFileTime(&oldT, &g_Model.lastWriteTime) != 0) {
-                    RecalculateLayout();
-                    UpdateScrollBars(hwnd);
-                    InvalidateRect(hwnd, NULL, TRUE); // Memicu WM_PAINT
+                int x, y;
+                if (!CanvasPoint(lParam, x, y)) break;
+                g_Front->scene.boxes.Query({ x, y, x + 1, y + 1 }, g_Visible);
+                if (g_Visible.empty()) break;
+                const DataModel& model = g_Front->model;
+                const Person& picked = model.people[g_Visible.front()];
+                // Simpan ID, bukan indeks: buffer bisa ditukar live reload di antara dua klik
+                size_t from = model.IndexOf(g_RelateFrom);
+                if (from == IdIndex::NPOS || g_RelateFrom == picked.id) {
+                    g_RelateFrom = picked.id;
+                    std::cout << "[RELATION] " << model.Text(picked.name) << " (ID " << picked.id << ") selected, right-click another person\n";
+                    break;
                 }
+                const Person& first = model.people[from];
+                std::cout << "[RELATION] " << model.Text(first.name) << " (ID " << first.id << ") is the "
+                          << DescribeRelationship(model, g_Front->pedigree, from, g_Visible.front()) << " of "
+                          << model.Text(picked.name) << " (ID " << picked.id << ")\n";
+                g_RelateFrom = 0;
+            }
+            break;
+
+        case WM_KEYDOWN:
+            if (wParam == VK_F3) { // Tampilkan/sembunyikan overlay statistik
+                g_ShowStats = !g_ShowStats;
+                InvalidateRect(hwnd, NULL, TRUE);
+            } else if (wParam == VK_F4) { // Simpan statistik ke file JSON
+                if (WriteStatsJson(STATS_FILE)) std::cout << "[STATS] Written to " << STATS_FILE << "\n";
+                else std::cout << "[ERROR] Could not write " << STATS_FILE << "\n";
+            } else if (wParam == 'F' && GetKeyState(VK_CONTROL) < 0) { // Kotak cari nama/peran
+                ShowFindBox(hwnd);
+            } else if (wParam == 'C' || wParam == 'E') { // Ciutkan semua (hanya keluarga akar) / buka semua
+                SetAllCollapsed(g_Front->model, wParam == 'C');
+                OnLayoutChanged(hwnd);
+            } else if (wParam == 'L') { // Ganti layout classic <-> compact
+                SwitchLayoutMode(hwnd);
+            } else if (wParam == VK_ADD || wParam == VK_OEM_PLUS || wParam == VK_SUBTRACT || wParam == VK_OEM_MINUS || wParam == '0') {
+                // Zoom masuk/keluar satu langkah (atau kembali ke 100%) di tengah jendela
+                RECT rc; GetClientRect(hwnd, &rc);
+                int level = (wParam == '0') ? 0 : g_ZoomLevel + ((wParam == VK_ADD || wParam == VK_OEM_PLUS) ? 1 : -1);
+                SetZoom(hwnd, level, rc.right / 2, rc.bottom / 2);
+            } else if (wParam == VK_HOME) { // Seluruh pohon dalam satu layar
+                g_ZoomLevel = FitZoomLevel(hwnd);
+                xScroll = yScroll = 0;
+                UpdateScrollBars(hwnd);
+                InvalidateRect(hwnd, NULL, TRUE);
+            }
+            break;
+
+        case WM_MOUSEWHEEL: // Ctrl+roda: zoom di posisi kursor, roda saja: gulir vertikal
+            {
+                int notches = GET_WHEEL_DELTA_WPARAM(wParam) / WHEEL_DELTA;
+                if (GetKeyState(VK_CONTROL) < 0) {
+                    POINT pt = { GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) }; // Koordinat layar
+                    ScreenToClient(hwnd, &pt);
+                    SetZoom(hwnd, g_ZoomLevel + notches, pt.x, pt.y);
+                } else {
+                    int oldY = yScroll;
+                    yScroll -= notches * 3 * LineStep();
+                    ClampScroll();
+                    if (yScroll != oldY) {
+                        SetScrollPos(hwnd, SB_VERT, yScroll, TRUE);
+                        InvalidateRect(hwnd, NULL, TRUE);
+                    }
+                }
+            }
+            break;
+
+        case WM_ERASEBKGND: // Seluruh jendela tertutup tile di WM_PAINT: tidak perlu dihapus dulu (mencegah kedip)
+            return 1;
+
+        case WM_COMMAND: // Teks kotak cari berubah: cari ulang dan lompat ke hasil terbaik
+            if ((HWND)lParam == g_FindBox && g_FindBox && HIWORD(wParam) == EN_CHANGE) {
+                int len = GetWindowTextLength(g_FindBox);
+                std::wstring text(len + 1, L'\0');
+                text.resize(GetWindowText(g_FindBox, &text[0], len + 1));
+                g_FindQuery = ToUtf8(text);
+                RunFind(hwnd, true);
             }
             break;
 
         case WM_SIZE: // Saat jendela di-resize oleh user
             UpdateScrollBars(hwnd);
+            PlaceFindBox(hwnd);
             break;
 
         case WM_VSCROLL: // Saat scrollbar vertikal digeser
@@ -538,14 +812,13 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
                 GetScrollInfo(hwnd, SB_VERT, &si);
                 int oldY = yScroll;
                 switch(LOWORD(wParam)) {
-                    case SB_LINEUP: yScroll -= 10; break;
-                    case SB_LINEDOWN: yScroll += 10; break;
+                    case SB_LINEUP: yScroll -= LineStep(); break;
+                    case SB_LINEDOWN: yScroll += LineStep(); break;
                     case SB_PAGEUP: yScroll -= si.nPage; break;
                     case SB_PAGEDOWN: yScroll += si.nPage; break;
-                    case SB_THUMBTRACK: yScroll = HIWORD(wParam); break;
+                    case SB_THUMBTRACK: yScroll = si.nTrackPos; break; // 32 bit (HIWORD(wParam) hanya sampai 65535)
                 }
-                if (yScroll < 0) yScroll = 0;
-                if (yScroll > g_Model.maxY) yScroll = g_Model.maxY;
+                ClampScroll();
                 if (yScroll != oldY) {
                     SetScrollPos(hwnd, SB_VERT, yScroll, TRUE);
                     InvalidateRect(hwnd, NULL, TRUE);
@@ -559,14 +832,13 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
                 GetScrollInfo(hwnd, SB_HORZ, &si);
                 int oldX = xScroll;
                 switch(LOWORD(wParam)) {
-                    case SB_LINELEFT: xScroll -= 10; break;
-                    case SB_LINERIGHT: xScroll += 10; break;
+                    case SB_LINELEFT: xScroll -= LineStep(); break;
+                    case SB_LINERIGHT: xScroll += LineStep(); break;
                     case SB_PAGELEFT: xScroll -= si.nPage; break;
                     case SB_PAGERIGHT: xScroll += si.nPage; break;
-                    case SB_THUMBTRACK: xScroll = HIWORD(wParam); break;
+                    case SB_THUMBTRACK: xScroll = si.nTrackPos; break; // 32 bit (HIWORD(wParam) hanya sampai 65535)
                 }
-                if (xScroll < 0) xScroll = 0;
-                if (xScroll > g_Model.maxX) xScroll = g_Model.maxX;
+                ClampScroll();
                 if (xScroll != oldX) {
                     SetScrollPos(hwnd, SB_HORZ, xScroll, TRUE);
                     InvalidateRect(hwnd, NULL, TRUE);
@@ -576,40 +848,59 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
 
         case WM_PAINT: // Proses menggambar ke jendela
             {
+                ScopedTimer frameTimer(Stage::Paint);
                 PAINTSTRUCT ps;
                 HDC hdc = BeginPaint(hwnd, &ps); // Mulai proses gambar
                 RECT rc; GetClientRect(hwnd, &rc);
 
-                // DOUBLE BUFFERING: Gambar ke memori dulu baru ke layar agar tidak berkedip (flicker)
-                HDC memDC = CreateCompatibleDC(hdc);
-                HBITMAP memBM = CreateCompatibleBitmap(hdc, rc.right, rc.bottom);
-                HBITMAP oldBM = (HBITMAP)SelectObject(memDC, memBM);
-
-                // Gambar latar belakang canvas
-                HBRUSH bg = CreateSolidBrush(COL_CANVAS);
-                FillRect(memDC, &rc, bg);
-                DeleteObject(bg);
-
-                // Terapkan Transformasi Scroll (geser posisi gambar)
-                int savedDC = SaveDC(memDC);
-                SetGraphicsMode(memDC, GM_ADVANCED);
-                XFORM xform = { 1.0f, 0, 0, 1.0f, (float)-xScroll, (float)-yScroll };
-                SetWorldTransform(memDC, &xform);
-
-                // Gambar seluruh elemen (Garis dulu baru kotak agar kotak menimpa garis)
-                DrawConnectors(memDC);
-                for (auto& p : g_Model.people) DrawBox(memDC, &p);
+                // DOUBLE BUFFERING: Gambar ke buffer belakang dulu baru ke layar agar tidak berkedip (flicker).
+                // Buffer dibuat sekali per ukuran jendela, bukan setiap frame.
+                EnsureBackBuffer(hdc, rc.right, rc.bottom);
+
+                // Tile yang menyentuh area invalid: tile di cache cukup disalin, sisanya digambar sekali
+                double scale = ZoomScale(g_ZoomLevel);
+                long long viewX = ViewX(scale), viewY = ViewY(scale);
+                long long tx0 = FloorDiv(viewX + ps.rcPaint.left, TILE_SIZE), tx1 = FloorDiv(viewX + ps.rcPaint.right - 1, TILE_SIZE);
+                long long ty0 = FloorDiv(viewY + ps.rcPaint.top, TILE_SIZE), ty1 = FloorDiv(viewY + ps.rcPaint.bottom - 1, TILE_SIZE);
+                g_TilesRendered = 0;
+                for (long long ty = ty0; ty <= ty1; ++ty) {
+                    for (long long tx = tx0; tx <= tx1; ++tx) {
+                        TileKey key = { g_ZoomLevel, (int)tx, (int)ty };
+                        bool fresh;
+                        TileBitmap& tile = g_Tiles.Acquire(key, fresh);
+                        if (!tile.bmp) tile.bmp = CreateCompatibleBitmap(hdc, TILE_SIZE, TILE_SIZE);
+                        HGDIOBJ oldBM = SelectObject(g_TileDC, tile.bmp);
+                        if (fresh) {
+                            RenderTile(g_TileDC, key);
+                            g_TilesRendered++;
+                        }
+                        BitBlt(g_BackDC, (int)(tx * TILE_SIZE - viewX), (int)(ty * TILE_SIZE - viewY), TILE_SIZE, TILE_SIZE,
+                               g_TileDC, 0, 0, SRCCOPY);
+                        SelectObject(g_TileDC, oldBM);
+                    }
+                }
 
-                RestoreDC(memDC, savedDC);
+                DrawHighlight(g_BackDC);
+                if (g_ShowStats) DrawStatsOverlay(g_BackDC);
                 // Salin dari memori ke layar utama
-                BitBlt(hdc, 0, 0, rc.right, rc.bottom, memDC, 0, 0, SRCCOPY);
-
-                SelectObject(memDC, oldBM); DeleteObject(memBM); DeleteDC(memDC);
+                BitBlt(hdc, ps.rcPaint.left, ps.rcPaint.top, ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+                       g_BackDC, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
                 EndPaint(hwnd, &ps); // Selesai proses gambar
+
+                g_LastFrameMs = frameTimer.Stop();
+                if (LogEnabled(LogLevel::Verbose)) std::cout << "[PAINT] frame_ms=" << g_LastFrameMs << " tiles_drawn=" << g_TilesRendered << "\n";
             }
             break;
 
-        case WM_DESTROY: PostQuitMessage(0); break; // Tutup aplikasi
+        case WM_DESTROY: // Tutup aplikasi
+            g_Watcher.Stop();
+            g_Loader.Stop(); // Pembangunan yang belum selesai dibatalkan
+            // Ditulis ulang saat jendela ditutup, bukan setiap simpan
+            if (g_Front->snapshotDirty) SaveSnapshot(g_Front->model, DATA_FILE_A);
+            DestroyTileResources();
+            g_Res.Destroy();
+            PostQuitMessage(0);
+            break;
         default: return DefWindowProc(hwnd, msg, wParam, lParam);
     }
     return 0;
@@ -637,7 +928,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int nCmdShow) {
     // Membuat Jendela Utama
     HWND hwnd = CreateWindowEx(
         0, CLASS_NAME, L"Family Tree Viewer",
-        WS_OVERLAPPEDWINDOW | WS_VSCROLL | WS_HSCROLL,
+        WS_OVERLAPPEDWINDOW | WS_VSCROLL | WS_HSCROLL | WS_CLIPCHILDREN, // Kotak cari tidak tertimpa canvas
         CW_USEDEFAULT, CW_USEDEFAULT, 1024, 768,
         NULL, NULL, hInstance, NULL
     );
@@ -664,6 +955,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int nCmdShow) {
     // Message Loop: Menunggu input dari pengguna (klik, ketik, dll)
     MSG msg = { };
     while (GetMessage(&msg, NULL, 0, 0)) {
+        if (msg.message == WM_KEYDOWN && g_FindBox && msg.hwnd == g_FindBox && OnFindKey(msg.wParam)) continue;
         TranslateMessage(&msg);
         DispatchMessage(&msg);
     }
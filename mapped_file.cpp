@@ -0,0 +1,74 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+    // FILE_SHARE_* agar editor tetap bisa menyimpan file selama kita membacanya
+    HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) return false;
+    m_hFile = hFile;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(hFile, &size)) { Close(); return false; }
+    if (size.QuadPart == 0) return true;
+
+    m_hMap = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!m_hMap) { Close(); return false; }
+    m_data = (const char*)MapViewOfFile(m_hMap, FILE_MAP_READ, 0, 0, 0);
+    if (!m_data) { Close(); return false; }
+    m_size = (size_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_hMap) CloseHandle(m_hMap);
+    if (m_hFile) CloseHandle(m_hFile);
+    m_data = nullptr;
+    m_size = 0;
+    m_hMap = nullptr;
+    m_hFile = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+    m_fd = open(path.c_str(), O_RDONLY);
+    if (m_fd < 0) return false;
+
+    struct stat st;
+    if (fstat(m_fd, &st) != 0) { Close(); return false; }
+    if (st.st_size == 0) return true;
+
+    void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (p == MAP_FAILED) { Close(); return false; }
+    madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL); // Dibaca sekali dari awal ke akhir
+    m_data = (const char*)p;
+    m_size = (size_t)st.st_size;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) munmap((void*)m_data, m_size);
+    if (m_fd >= 0) close(m_fd);
+    m_data = nullptr;
+    m_size = 0;
+    m_fd = -1;
+}
+
+#endif
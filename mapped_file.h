@@ -0,0 +1,32 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// MAPPED FILE (Memetakan file ke memori, hanya-baca) - POSIX mmap / Win32 file mapping
+// -----------------------------------------------------------------------------
+#include <string>
+#include <cstddef>
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Membuka dan memetakan seluruh isi file. File kosong tetap dianggap berhasil (size() == 0).
+    bool Open(const std::string& path);
+    void Close();
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void* m_hFile = nullptr;
+    void* m_hMap = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
@@ -0,0 +1,657 @@
+#include "model.h"
+
+#include "gedcom.h"
+#include "mapped_file.h"
+#include "parallel.h"
+#include "stats.h"
+
+#include <algorithm>   // std::min/std::max untuk pembagian potongan
+#include <charconv>    // std::from_chars untuk parsing angka tanpa alokasi
+#include <cstring>     // std::memchr untuk mencari pemisah kolom/baris
+#include <iostream>    // Untuk output ke console (debugging)
+#include <thread>      // Parsing paralel per potongan file
+
+// -----------------------------------------------------------------------------
+// STORAGE (String pool, indeks ID, dan indeks keluarga)
+// -----------------------------------------------------------------------------
+
+Gender ParseGender(std::string_view s) {
+    if (s == "M" || s == "m") return Gender::Male;
+    if (s == "F" || s == "f") return Gender::Female;
+    return Gender::Unknown;
+}
+
+void StringPool::Clear() {
+    m_blocks.clear();
+    m_active = nullptr;
+    m_activeUsed = 0;
+    m_strings.assign(1, std::string_view()); // Nomor 0 selalu teks kosong
+    m_lookup.clear();
+}
+
+uint32_t StringPool::Add(std::string_view text) {
+    if (text.empty()) return 0;
+    char* dst;
+    if (text.size() > BLOCK_SIZE / 4) {
+        // Teks panjang mendapat blok sendiri agar sisa blok aktif tidak terbuang
+        m_blocks.push_back(std::make_unique<char[]>(text.size()));
+        dst = m_blocks.back().get();
+    } else {
+        if (!m_active || m_activeUsed + text.size() > BLOCK_SIZE) {
+            m_blocks.push_back(std::make_unique<char[]>(BLOCK_SIZE));
+            m_active = m_blocks.back().get();
+            m_activeUsed = 0;
+        }
+        dst = m_active + m_activeUsed;
+        m_activeUsed += text.size();
+    }
+    std::memcpy(dst, text.data(), text.size());
+    m_strings.emplace_back(dst, text.size());
+    return (uint32_t)(m_strings.size() - 1);
+}
+
+uint32_t StringPool::Intern(std::string_view text) {
+    if (text.empty()) return 0;
+    auto it = m_lookup.find(text);
+    if (it != m_lookup.end()) return it->second;
+    uint32_t handle = Add(text);
+    m_lookup.emplace(m_strings[handle], handle); // Kunci menunjuk ke salinan di pool, bukan ke input
+    return handle;
+}
+
+std::vector<uint32_t> StringPool::InternedHandles() const {
+    std::vector<uint32_t> handles;
+    handles.reserve(m_lookup.size());
+    for (const auto& kv : m_lookup) handles.push_back(kv.second);
+    return handles;
+}
+
+void StringPool::Assign(const char* chars, const uint64_t* offsets, size_t count, const uint32_t* interned, size_t internedCount) {
+    Clear();
+    size_t bytes = (count > 0) ? (size_t)offsets[count] : 0;
+    m_blocks.push_back(std::make_unique<char[]>(std::max<size_t>(bytes, 1)));
+    char* base = m_blocks.back().get();
+    std::memcpy(base, chars, bytes);
+    m_strings.resize(count);
+    for (size_t h = 0; h < count; ++h) m_strings[h] = std::string_view(base + offsets[h], (size_t)(offsets[h + 1] - offsets[h]));
+    if (count == 0) m_strings.assign(1, std::string_view());
+    for (size_t k = 0; k < internedCount; ++k) m_lookup.emplace(m_strings[interned[k]], interned[k]);
+}
+
+void IdIndex::Clear() {
+    m_dense = true;
+    m_minId = 0;
+    m_table.clear();
+    m_sparse.clear();
+    m_count = 0;
+}
+
+void IdIndex::Build(const std::vector<Person>& people) {
+    Clear();
+    if (people.empty()) return;
+    long long minId = people[0].id, maxId = people[0].id;
+    for (const Person& p : people) {
+        minId = std::min<long long>(minId, p.id);
+        maxId = std::max<long long>(maxId, p.id);
+    }
+
+    // Tabel langsung hanya jika rentang ID tidak jauh lebih besar dari jumlah orang
+    m_dense = (maxId - minId + 1) <= (long long)people.size() * 4 + 1024;
+    if (m_dense) {
+        m_minId = minId;
+        m_table.assign((size_t)(maxId - minId + 1), EMPTY);
+        for (size_t i = 0; i < people.size(); ++i) {
+            uint32_t& slot = m_table[(size_t)(people[i].id - minId)];
+            if (slot == EMPTY) m_count++;
+            slot = (uint32_t)i; // ID ganda: baris terakhir yang menang
+        }
+    } else {
+        m_sparse.reserve(people.size());
+        for (size_t i = 0; i < people.size(); ++i) m_sparse[people[i].id] = (uint32_t)i;
+        m_count = m_sparse.size();
+    }
+}
+
+void ParentGroupTable::Rehash(size_t capacity) {
+    std::vector<Slot> old;
+    old.swap(m_slots);
+    m_slots.assign(capacity, Slot());
+    size_t mask = capacity - 1;
+    for (const Slot& s : old) {
+        if (s.key == 0) continue;
+        size_t i = Hash(s.key) & mask;
+        while (m_slots[i].key != 0) i = (i + 1) & mask;
+        m_slots[i] = s;
+    }
+}
+
+uint32_t ParentGroupTable::Insert(long long key, uint32_t group) {
+    if ((m_count + 1) * 2 > m_slots.size()) Rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+    size_t mask = m_slots.size() - 1;
+    for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+        if (m_slots[i].key == key) return m_slots[i].group;
+        if (m_slots[i].key == 0) {
+            m_slots[i].key = key;
+            m_slots[i].group = group;
+            m_count++;
+            return group;
+        }
+    }
+}
+
+void DataModel::Clear() {
+    people.clear();
+    strings.Clear();
+    spouseLinks.clear();
+    idToIndex.Clear();
+    posX.clear();
+    posY.clear();
+    subtreeWidth.clear();
+    placed.clear();
+    widthValid.clear();
+    collapsed.clear();
+    fatherIndex.clear();
+    motherIndex.clear();
+    rootCandidates.clear();
+    childGroup.Clear();
+    childOffsets.clear();
+    childIds.clear();
+    segments.clear();
+    segmentStart.clear();
+    maxX = 0;
+    maxY = 0;
+}
+
+void DataModel::BuildLookup() {
+    idToIndex.Build(people);
+
+    size_t n = people.size();
+    fatherIndex.resize(n);
+    motherIndex.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t f = people[i].fatherId ? idToIndex.Find(people[i].fatherId) : IdIndex::NPOS;
+        size_t m = people[i].motherId ? idToIndex.Find(people[i].motherId) : IdIndex::NPOS;
+        fatherIndex[i] = (f == IdIndex::NPOS) ? NO_INDEX : (uint32_t)f;
+        motherIndex[i] = (m == IdIndex::NPOS) ? NO_INDEX : (uint32_t)m;
+    }
+    // Layout mencari akar dari daftar ini, bukan dari seluruh orang (penting saat sebagian
+    // besar pohon diciutkan dan layout ulang harus selesai dalam satu frame)
+    rootCandidates.clear();
+    for (size_t i = 0; i < n; ++i) {
+        if (people[i].fatherId == 0 && people[i].motherId == 0) rootCandidates.push_back((uint32_t)i);
+    }
+}
+
+void DataModel::ResetLayout() {
+    size_t n = people.size();
+    posX.assign(n, 0);
+    posY.assign(n, 0);
+    subtreeWidth.assign(n, 0);
+    placed.assign(n, 0);
+    widthValid.assign(n, 0);
+    collapsed.assign(n, 0);
+    segments.clear();
+    segmentStart.clear();
+    maxX = 0;
+    maxY = 0;
+}
+
+void DataModel::BuildIndexes() {
+    BuildLookup();
+    BuildChildIndex();
+    ResetLayout();
+}
+
+void DataModel::BuildChildIndex() {
+    childGroup.Clear();
+    childOffsets.clear();
+    childIds.clear();
+
+    std::vector<size_t> groupOf(people.size(), (size_t)-1);
+    std::vector<size_t> counts;
+    for (size_t i = 0; i < people.size(); ++i) {
+        const Person& p = people[i];
+        if (p.fatherId == 0 && p.motherId == 0) continue; // Akar tidak punya grup orang tua
+        uint32_t g = childGroup.Insert(ParentKey(p.fatherId, p.motherId), (uint32_t)counts.size());
+        if (g == counts.size()) counts.push_back(0);
+        groupOf[i] = g;
+        counts[g]++;
+    }
+
+    childOffsets.assign(counts.size() + 1, 0);
+    for (size_t g = 0; g < counts.size(); ++g) childOffsets[g + 1] = childOffsets[g] + counts[g];
+
+    childIds.resize(childOffsets.back());
+    std::vector<size_t> cursor(childOffsets.begin(), childOffsets.end() - 1);
+    for (size_t i = 0; i < people.size(); ++i) {
+        if (groupOf[i] != (size_t)-1) childIds[cursor[groupOf[i]]++] = people[i].id;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// HELPERS (Fungsi Pembantu)
+// -----------------------------------------------------------------------------
+
+// Decoder UTF-8 sederhana. Byte yang tidak valid dianggap Latin-1 agar file lama
+// (hasil ekspor Excel dengan code page Windows) tetap terbaca tanpa kehilangan huruf.
+std::wstring ToWString(std::string_view str) {
+    std::wstring out;
+    out.reserve(str.size());
+    size_t i = 0;
+    while (i < str.size()) {
+        unsigned char c = (unsigned char)str[i];
+        unsigned int cp = c;
+        size_t len = 1;
+        if (c >= 0xC0 && c < 0xE0) { len = 2; cp = c & 0x1F; }
+        else if (c >= 0xE0 && c < 0xF0) { len = 3; cp = c & 0x0F; }
+        else if (c >= 0xF0 && c < 0xF8) { len = 4; cp = c & 0x07; }
+
+        bool valid = (c < 0x80 || len > 1) && i + len <= str.size();
+        for (size_t k = 1; valid && k < len; ++k) {
+            unsigned char cc = (unsigned char)str[i + k];
+            if ((cc & 0xC0) != 0x80) valid = false;
+            else cp = (cp << 6) | (cc & 0x3F);
+        }
+        if (!valid) { cp = c; len = 1; }
+
+        if (sizeof(wchar_t) == 2 && cp >= 0x10000) {
+            cp -= 0x10000;
+            out.push_back((wchar_t)(0xD800 + (cp >> 10)));
+            out.push_back((wchar_t)(0xDC00 + (cp & 0x3FF)));
+        } else {
+            out.push_back((wchar_t)cp);
+        }
+        i += len;
+    }
+    return out;
+}
+
+int SafeToInt(std::string_view s) {
+    // Meniru std::stoi: lewati spasi di depan, terima tanda '+'/'-', abaikan sisa teks setelah angka.
+    // Teks tanpa angka atau di luar jangkauan int menghasilkan 0.
+    const char* b = s.data();
+    const char* e = b + s.size();
+    while (b < e && (*b == ' ' || (*b >= '\t' && *b <= '\r'))) ++b;
+    if (b < e && *b == '+') {
+        ++b;
+        if (b < e && *b == '-') return 0;
+    }
+    int value = 0;
+    auto res = std::from_chars(b, e, value);
+    if (res.ec != std::errc()) return 0;
+    return value;
+}
+
+// Mengambil satu kolom dari posisi cur sampai pemisah berikutnya (atau akhir baris).
+// Kolom yang sudah habis menghasilkan teks kosong, sama seperti std::getline pada stream yang habis.
+static std::string_view NextField(const char*& cur, const char* end, char sep) {
+    const char* start = cur;
+    const char* stop = (const char*)std::memchr(cur, sep, (size_t)(end - cur));
+    if (!stop) stop = end;
+    cur = (stop < end) ? stop + 1 : end;
+    return std::string_view(start, (size_t)(stop - start));
+}
+
+// -----------------------------------------------------------------------------
+// ROBUST DATA LOADING (Proses Membaca CSV)
+// -----------------------------------------------------------------------------
+
+// Hasil parsing satu potongan (chunk) file. Nomor baris di sini masih lokal terhadap potongan.
+struct ParsedChunk {
+    std::vector<Person> people;
+    StringPool strings;                                     // Teks milik potongan ini (digabung saat merge)
+    std::vector<SpouseLink> spouseLinks;                    // spouseBegin di people relatif ke vector ini
+    std::vector<std::pair<int, std::string_view>> skipped; // Baris yang dilewati (nomor baris, isi)
+    int lineCount = 0;                                      // Jumlah baris di potongan ini
+};
+
+// Mem-parsing satu potongan CSV langsung di tempat (tanpa stringstream/salinan per baris).
+// Tidak menyentuh DataModel sehingga aman dijalankan paralel oleh beberapa thread.
+static void ParseCsvChunk(const char* data, size_t size, ParsedChunk& out) {
+    const char* pos = data;
+    const char* end = data + size;
+    int lineNum = 0;
+
+    // Hitung jumlah baris dulu (memchr sangat cepat) agar vector tidak perlu realokasi berulang
+    size_t lineCount = 0;
+    for (const char* c = data; c < end; ++lineCount) {
+        const char* nl = (const char*)std::memchr(c, '\n', (size_t)(end - c));
+        c = nl ? nl + 1 : end;
+    }
+    out.people.reserve(lineCount);
+
+    // Membaca buffer baris demi baris
+    while (pos < end) {
+        const char* nl = (const char*)std::memchr(pos, '\n', (size_t)(end - pos));
+        const char* lineEnd = nl ? nl : end;
+        const char* lineStart = pos;
+        pos = nl ? nl + 1 : end;
+        lineNum++;
+
+        // Menghapus karakter '\r' tersembunyi jika file dibuat di Windows
+        if (lineEnd > lineStart && lineEnd[-1] == '\r') --lineEnd;
+
+        if (lineEnd == lineStart) continue;
+
+        const char* cur = lineStart;
+        Person p;
+        p.line = lineNum;
+
+        // Proses parsing kolom berdasarkan tanda koma (CSV)
+        // 1. Ambil ID
+        p.id = SafeToInt(NextField(cur, lineEnd, ','));
+
+        // Abaikan baris Header (biasanya baris pertama yang berisi teks bukan angka)
+        if (p.id == 0) {
+            out.skipped.emplace_back(lineNum, std::string_view(lineStart, (size_t)(lineEnd - lineStart)));
+            continue;
+        }
+
+        // 2. Ambil Nama, 3. Role/Peran (disimpan apa adanya dalam UTF-8), 4. Gender
+        // Peran sangat berulang (Anak, Menantu, ...) sehingga di-intern; nama hampir selalu unik
+        p.name = out.strings.Add(NextField(cur, lineEnd, ','));
+        p.role = out.strings.Intern(NextField(cur, lineEnd, ','));
+        p.gender = ParseGender(NextField(cur, lineEnd, ','));
+        // 5. Ambil ID Ayah
+        p.fatherId = SafeToInt(NextField(cur, lineEnd, ','));
+        // 6. Ambil ID Ibu
+        p.motherId = SafeToInt(NextField(cur, lineEnd, ','));
+
+        // 7. Ambil Kolom Pasangan (Bisa lebih dari satu, dipisah karakter '|')
+        std::string_view spouseField = NextField(cur, lineEnd, ',');
+        const char* sp = spouseField.data();
+        const char* spEnd = sp + spouseField.size();
+        p.spouseBegin = (uint32_t)out.spouseLinks.size();
+        bool anyEx = false;
+        while (sp < spEnd) {
+            std::string_view token = NextField(sp, spEnd, '|');
+            if (token.empty()) continue;
+            // Cek jika ada tanda 'x' (menandakan mantan pasangan/cerai)
+            bool isEx = (token.back() == 'x' || token.back() == 'X');
+            if (isEx) token.remove_suffix(1);
+
+            int spId = SafeToInt(token);
+            if (spId != 0) {
+                out.spouseLinks.push_back({ spId, isEx });
+                anyEx = anyEx || isEx;
+            }
+        }
+        p.spouseCount = (uint32_t)out.spouseLinks.size() - p.spouseBegin;
+        if (anyEx) {
+            // Tanda cerai berlaku untuk ID itu, meskipun ID yang sama tertulis lagi tanpa 'x'
+            SpouseLink* links = out.spouseLinks.data() + p.spouseBegin;
+            for (uint32_t a = 0; a < p.spouseCount; ++a) {
+                for (uint32_t b = 0; b < p.spouseCount && !links[a].ex; ++b) {
+                    if (links[b].ex && links[b].id == links[a].id) links[a].ex = true;
+                }
+            }
+        }
+
+        out.people.push_back(std::move(p));
+    }
+    out.lineCount = lineNum;
+}
+
+// Memecah buffer menjadi beberapa potongan yang selalu dimulai di awal baris
+static std::vector<std::pair<const char*, const char*>> SplitAtLines(const char* data, size_t size, unsigned parts) {
+    std::vector<std::pair<const char*, const char*>> ranges;
+    const char* end = data + size;
+    const char* start = data;
+    for (unsigned i = 1; i <= parts && start < end; ++i) {
+        const char* stop = end;
+        if (i < parts) {
+            const char* guess = data + (size / parts) * i;
+            if (guess < start) guess = start;
+            const char* nl = (const char*)std::memchr(guess, '\n', (size_t)(end - guess));
+            stop = nl ? nl + 1 : end;
+        }
+        ranges.emplace_back(start, stop);
+        start = stop;
+    }
+    return ranges;
+}
+
+// Menggabungkan hasil tiap potongan ke model sesuai urutan file, sehingga hasilnya sama persis
+// dengan parsing serial (termasuk ID ganda: baris terakhir yang menang di idToIndex)
+static void MergeChunks(DataModel& model, std::vector<ParsedChunk>& chunks) {
+    // Satu potongan (mode serial): data langsung dipindahkan tanpa menyalin orang satu per satu
+    const bool single = (chunks.size() == 1);
+    if (single) {
+        model.people = std::move(chunks[0].people);
+        model.strings = std::move(chunks[0].strings);
+        model.spouseLinks = std::move(chunks[0].spouseLinks);
+    } else {
+        size_t total = 0, links = 0;
+        for (const auto& c : chunks) {
+            total += c.people.size();
+            links += c.spouseLinks.size();
+        }
+        model.people.reserve(total);
+        model.spouseLinks.reserve(links);
+    }
+
+    // Log per baris hanya pada LogLevel::Verbose: mencetak jutaan baris jauh lebih lambat dari parsing-nya
+    const bool info = LogEnabled(LogLevel::Info);
+    const bool verbose = LogEnabled(LogLevel::Verbose);
+    int lineOffset = 0;
+    size_t index = 0;
+    std::vector<uint32_t> roleMap; // Nomor peran di potongan -> nomor peran di model
+    for (auto& chunk : chunks) {
+        std::vector<Person>& src = single ? model.people : chunk.people;
+        uint32_t linkOffset = (uint32_t)(single ? 0 : model.spouseLinks.size());
+        if (!single) {
+            model.spouseLinks.insert(model.spouseLinks.end(), chunk.spouseLinks.begin(), chunk.spouseLinks.end());
+            roleMap.assign(chunk.strings.Count(), DataModel::NO_INDEX);
+        }
+        size_t skip = 0;
+        AddCounter(Counter::RowsSkipped, chunk.skipped.size());
+        for (size_t k = 0; k < src.size(); ++k, ++index) {
+            // Cetak log baris yang dilewati sesuai urutan aslinya di file
+            while (skip < chunk.skipped.size() && chunk.skipped[skip].first < src[k].line) {
+                if (info) std::cout << "[SKIP] Line " << lineOffset + chunk.skipped[skip].first << ": '" << chunk.skipped[skip].second << "' (Not an ID)\n";
+                skip++;
+            }
+            if (!single) {
+                // Teks dipindah ke pool model; peran yang sama di potongan lain mendapat nomor yang sama
+                Person p = src[k];
+                p.name = model.strings.Add(chunk.strings.Get(p.name));
+                uint32_t& role = roleMap[p.role];
+                if (role == DataModel::NO_INDEX) role = model.strings.Intern(chunk.strings.Get(p.role));
+                p.role = role;
+                p.spouseBegin += linkOffset;
+                model.people.push_back(p);
+            }
+            Person& p = model.people[index];
+            p.line += lineOffset;
+
+            if (verbose) std::cout << "[LOAD] OK - ID:" << p.id << "\n";
+        }
+        for (; skip < chunk.skipped.size() && info; ++skip) {
+            std::cout << "[SKIP] Line " << lineOffset + chunk.skipped[skip].first << ": '" << chunk.skipped[skip].second << "' (Not an ID)\n";
+        }
+        lineOffset += chunk.lineCount;
+        // Lepas memori potongan sesegera mungkin
+        std::vector<Person>().swap(chunk.people);
+        std::vector<SpouseLink>().swap(chunk.spouseLinks);
+        chunk.strings.Clear();
+    }
+}
+
+// Mengecek waktu modifikasi file. Mengembalikan false jika file tidak ada atau belum berubah
+// sejak load terakhir; jika berubah, waktu baru langsung dicatat di model.
+static bool FileChanged(DataModel& model, const std::string& path) {
+    std::error_code ec;
+    auto writeTime = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        std::cout << "[ERROR] File not found: " << path << "\n";
+        return false;
+    }
+    // Jika file belum berubah sejak load terakhir, batalkan load (efisiensi)
+    if (writeTime == model.lastWriteTime) return false;
+    model.lastWriteTime = writeTime;
+    return true;
+}
+
+// Membaca seluruh isi CSV ke model yang masih kosong (serial atau paralel per potongan)
+static bool ParseCsvFile(DataModel& model, const std::string& path, unsigned threads) {
+    // Memetakan file ke memori; mapping langsung ditutup setelah parsing agar
+    // file tidak terkunci saat editor ingin menyimpan perubahan berikutnya
+    MappedFile file;
+    if (!file.Open(path)) {
+        std::cout << "[ERROR] Could not open file stream!\n";
+        return false;
+    }
+
+    if (LogEnabled(LogLevel::Info)) std::cout << "[INFO] File opened. Reading lines...\n";
+
+    // Tentukan jumlah thread: otomatis = jumlah core, tapi file kecil cukup diproses serial
+    const size_t MIN_CHUNK_BYTES = 1 << 20;
+    threads = ResolveThreads(threads);
+    threads = (unsigned)std::min<size_t>(threads, std::max<size_t>(1, file.size() / MIN_CHUNK_BYTES));
+
+    auto ranges = SplitAtLines(file.data(), file.size(), threads);
+    std::vector<ParsedChunk> chunks(ranges.size());
+    if (ranges.size() <= 1) {
+        if (!ranges.empty()) ParseCsvChunk(ranges[0].first, (size_t)(ranges[0].second - ranges[0].first), chunks[0]);
+    } else {
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            workers.emplace_back(ParseCsvChunk, ranges[i].first, (size_t)(ranges[i].second - ranges[i].first), std::ref(chunks[i]));
+        }
+        for (auto& w : workers) w.join();
+    }
+    MergeChunks(model, chunks); // Harus sebelum Close(): log baris yang dilewati masih menunjuk ke mapping
+    file.Close();
+    return true;
+}
+
+// Membaca file ke model yang masih kosong lalu membangun indeksnya. File .ged dibaca sebagai
+// GEDCOM (streaming, lihat gedcom.h), selain itu sebagai CSV.
+static void ParseFile(DataModel& model, const std::string& path, unsigned threads) {
+    ScopedTimer parseTimer(Stage::Parse);
+    bool ok = IsGedcomPath(path) ? ReadGedcom(model, path) : ParseCsvFile(model, path, threads);
+    if (!ok) return;
+    parseTimer.Stop();
+    AddCounter(Counter::PeopleLoaded, model.people.size());
+
+    {
+        ScopedTimer indexTimer(Stage::IndexBuild);
+        model.BuildIndexes(); // Susun indeks ID, orang tua, dan anak sekali setelah seluruh data terbaca
+    }
+
+    if (LogEnabled(LogLevel::Info)) std::cout << "[STATUS] Finished. Loaded " << model.people.size() << " people.\n";
+}
+
+bool LoadData(DataModel& model, const std::string& path, unsigned threads) {
+    if (!FileChanged(model, path)) return false;
+
+    model.Clear(); // Bersihkan memori sebelum memuat data baru
+    ParseFile(model, path, threads);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// INCREMENTAL RELOAD (Memuat ulang hanya baris yang berubah)
+// -----------------------------------------------------------------------------
+
+// Field yang memengaruhi bentuk pohon (lebar sub-pohon dan kelompok anak)
+static bool SameStructure(const DataModel& ma, const Person& a, const DataModel& mb, const Person& b) {
+    if (a.gender != b.gender || a.fatherId != b.fatherId || a.motherId != b.motherId) return false;
+    if (a.spouseCount != b.spouseCount) return false;
+    SpouseRange sa = ma.Spouses(a), sb = mb.Spouses(b);
+    for (size_t k = 0; k < sa.size(); ++k) {
+        if (sa.first[k].id != sb.first[k].id) return false;
+    }
+    return true;
+}
+
+// Field yang hanya memengaruhi tampilan kotak/garis, bukan posisi (struktur sudah sama)
+static bool SameContent(const DataModel& ma, const Person& a, const DataModel& mb, const Person& b) {
+    if (ma.Text(a.name) != mb.Text(b.name) || ma.Text(a.role) != mb.Text(b.role)) return false;
+    SpouseRange sa = ma.Spouses(a), sb = mb.Spouses(b);
+    for (size_t k = 0; k < sa.size(); ++k) {
+        if (sa.first[k].ex != sb.first[k].ex) return false;
+    }
+    return true;
+}
+
+ReloadResult ReloadData(DataModel& model, const std::string& path, unsigned threads) {
+    ReloadResult result;
+    if (!FileChanged(model, path)) return result;
+    ScopedTimer timer(Stage::Reload);
+
+    // Load pertama (atau model kosong): tidak ada yang bisa dibandingkan
+    if (model.people.empty()) {
+        model.Clear();
+        ParseFile(model, path, threads);
+        result.changed = true;
+        result.fullReload = true;
+        result.added = model.people.size();
+        return result;
+    }
+
+    DataModel fresh;
+    ParseFile(fresh, path, threads);
+
+    // 1. Bandingkan per ID (orang yang aktif menurut idToIndex; ID ganda: baris terakhir)
+    fresh.idToIndex.ForEach([&](int id, size_t index) {
+        const Person& np = fresh.people[index];
+        const Person* op = model.Get(id);
+        if (!op) {
+            result.added++;
+            result.dirtyIds.push_back(np.id);
+        } else if (!SameStructure(model, *op, fresh, np)) {
+            result.modified++;
+            result.dirtyIds.push_back(np.id);
+            // Orang tua lama kehilangan anak ini, jadi lebar mereka juga harus dihitung ulang
+            if (op->fatherId != 0) result.dirtyIds.push_back(op->fatherId);
+            if (op->motherId != 0) result.dirtyIds.push_back(op->motherId);
+        } else if (!SameContent(model, *op, fresh, np)) {
+            result.modified++;
+        }
+    });
+    model.idToIndex.ForEach([&](int id, size_t index) {
+        if (fresh.idToIndex.Contains(id)) return;
+        const Person& op = model.people[index];
+        result.removed++;
+        if (op.fatherId != 0) result.dirtyIds.push_back(op.fatherId);
+        if (op.motherId != 0) result.dirtyIds.push_back(op.motherId);
+    });
+
+    // Urutan baris menentukan urutan akar dan anak saat penempatan
+    bool sameOrder = (fresh.people.size() == model.people.size());
+    for (size_t i = 0; sameOrder && i < fresh.people.size(); ++i) {
+        sameOrder = (fresh.people[i].id == model.people[i].id);
+    }
+
+    result.changed = (result.added + result.removed + result.modified > 0) || !sameOrder;
+    result.needsLayout = !result.dirtyIds.empty() || !sameOrder;
+    if (!result.changed) return result;
+
+    if (!result.needsLayout) {
+        // 2a. Hanya teks/tanda cerai yang berubah: data identitas diganti, kolom layout
+        //     (posisi, lebar) tetap karena urutan dan struktur sama persis
+        model.people = std::move(fresh.people);
+        model.strings = std::move(fresh.strings);
+        model.spouseLinks = std::move(fresh.spouseLinks);
+        return result;
+    }
+
+    // 2b. Struktur berubah: pakai data baru, tapi bawa lebar sub-pohon yang masih berlaku
+    //     agar layout inkremental tidak perlu menghitung ulang seluruh pohon, begitu juga
+    //     status ciut (lebar lama dihitung dengan status yang sama)
+    for (size_t i = 0; i < fresh.people.size(); ++i) {
+        size_t old = model.IndexOf(fresh.people[i].id);
+        if (old != IdIndex::NPOS) fresh.collapsed[i] = model.collapsed[old];
+        if (old != IdIndex::NPOS && model.widthValid[old]) {
+            fresh.subtreeWidth[i] = model.subtreeWidth[old];
+            fresh.widthValid[i] = 1;
+        }
+    }
+    auto writeTime = model.lastWriteTime;
+    LayoutMode mode = model.layoutMode;
+    model = std::move(fresh);
+    model.lastWriteTime = writeTime;
+    model.layoutMode = mode;
+    return result;
+}
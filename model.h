@@ -0,0 +1,296 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// MODEL (Struktur Data & Pembacaan CSV) - bagian inti yang tidak bergantung pada Win32
+// -----------------------------------------------------------------------------
+#include <cstdint>       // uint32_t untuk indeks CSR
+#include <memory>        // Blok memori string pool
+#include <vector>        // Kontainer array dinamis
+#include <string>        // Manipulasi teks
+#include <string_view>   // Potongan teks tanpa salinan saat parsing
+#include <unordered_map> // Untuk indeks anak berdasarkan pasangan (Ayah, Ibu) dan ID yang jarang
+#include <filesystem>    // Untuk membaca waktu modifikasi file secara portabel
+
+// Jenis kelamin (kolom Gender: "M"/"m" = laki-laki, "F"/"f" = perempuan, selain itu tidak diketahui)
+enum class Gender : uint8_t { Unknown, Male, Female };
+
+Gender ParseGender(std::string_view s);
+
+// Penyimpanan teks bersama: setiap teks unik disimpan sekali, orang hanya menyimpan nomornya.
+// Teks tidak pernah dipindah setelah disimpan, jadi string_view dari Get() tetap berlaku.
+class StringPool {
+public:
+    StringPool() { Clear(); }
+
+    // Mengembalikan nomor teks (teks yang sama selalu mendapat nomor yang sama). 0 = teks kosong.
+    uint32_t Intern(std::string_view text);
+    // Menyimpan teks tanpa mencari duplikat (untuk teks yang hampir selalu unik, seperti nama)
+    uint32_t Add(std::string_view text);
+    std::string_view Get(uint32_t handle) const { return m_strings[handle]; }
+    size_t Count() const { return m_strings.size(); }
+    void Clear();
+
+    // Nomor-nomor teks yang di-intern (untuk disimpan di snapshot)
+    std::vector<uint32_t> InternedHandles() const;
+    // Mengisi pool dari data snapshot: seluruh karakter disalin ke satu blok sekaligus.
+    // Teks ke-h adalah chars[offsets[h] .. offsets[h+1]); offsets berisi count+1 elemen.
+    void Assign(const char* chars, const uint64_t* offsets, size_t count, const uint32_t* interned, size_t internedCount);
+
+private:
+    static constexpr size_t BLOCK_SIZE = 1 << 16;
+    std::vector<std::unique_ptr<char[]>> m_blocks; // Blok karakter, tidak pernah dipindah
+    char* m_active = nullptr;                      // Blok yang sedang diisi teks pendek
+    size_t m_activeUsed = 0;                       // Byte terpakai di blok aktif
+    std::vector<std::string_view> m_strings;       // Nomor -> teks
+    std::unordered_map<std::string_view, uint32_t> m_lookup; // Teks -> nomor
+};
+
+// Satu hubungan pasangan milik seseorang (disimpan berdampingan untuk semua orang)
+struct SpouseLink {
+    int id = 0;               // ID pasangan
+    bool ex = false;          // Mantan pasangan (cerai, ditandai 'x' di file)
+};
+
+// Data identitas seseorang. Posisi dan data layout lain disimpan terpisah per kolom di DataModel.
+struct Person {
+    int id = 0;               // ID Unik setiap orang
+    uint32_t name = 0;        // Nama (nomor teks UTF-8 di DataModel::strings)
+    uint32_t role = 0;        // Peran/Jabatan (misal: Kakek, Ayah)
+    Gender gender = Gender::Unknown;
+    int fatherId = 0;         // Referensi ID Ayah
+    int motherId = 0;         // Referensi ID Ibu
+    uint32_t spouseBegin = 0; // Pasangan ada di DataModel::spouseLinks[spouseBegin .. +spouseCount)
+    uint32_t spouseCount = 0;
+    int line = 0;             // Nomor baris asal di file CSV (untuk pesan error/validasi)
+};
+
+// Rentang (read-only) pasangan seseorang
+struct SpouseRange {
+    const SpouseLink* first = nullptr;
+    const SpouseLink* last = nullptr;
+    const SpouseLink* begin() const { return first; }
+    const SpouseLink* end() const { return last; }
+    size_t size() const { return (size_t)(last - first); }
+    bool empty() const { return first == last; }
+};
+
+// Pencarian ID -> indeks. ID yang rapat (kasus umum: 1..N) memakai tabel langsung,
+// ID yang sangat jarang/besar memakai hash map.
+class IdIndex {
+public:
+    static constexpr size_t NPOS = (size_t)-1;
+
+    // Dibangun dari daftar orang; untuk ID ganda, baris terakhir yang menang
+    void Build(const std::vector<Person>& people);
+    void Clear();
+
+    size_t Find(int id) const {
+        if (m_dense) {
+            long long slot = (long long)id - m_minId;
+            if (slot < 0 || slot >= (long long)m_table.size()) return NPOS;
+            uint32_t index = m_table[(size_t)slot];
+            return (index == EMPTY) ? NPOS : index;
+        }
+        auto it = m_sparse.find(id);
+        return (it != m_sparse.end()) ? it->second : NPOS;
+    }
+    bool Contains(int id) const { return Find(id) != NPOS; }
+    size_t Size() const { return m_count; }
+
+    // Memanggil fn(id, indeks) untuk setiap ID unik
+    template <typename Fn> void ForEach(Fn&& fn) const {
+        if (m_dense) {
+            for (size_t slot = 0; slot < m_table.size(); ++slot) {
+                if (m_table[slot] != EMPTY) fn((int)((long long)slot + m_minId), (size_t)m_table[slot]);
+            }
+        } else {
+            for (const auto& kv : m_sparse) fn(kv.first, (size_t)kv.second);
+        }
+    }
+
+private:
+    static constexpr uint32_t EMPTY = 0xFFFFFFFFu;
+    bool m_dense = true;
+    long long m_minId = 0;
+    std::vector<uint32_t> m_table;              // Mode rapat: indeks per (ID - m_minId)
+    std::unordered_map<int, uint32_t> m_sparse; // Mode jarang
+    size_t m_count = 0;
+};
+
+// Rentang (read-only) daftar ID anak yang tersimpan berurutan di dalam indeks anak
+struct ChildRange {
+    const int* first = nullptr;
+    const int* last = nullptr;
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    size_t size() const { return (size_t)(last - first); }
+    bool empty() const { return first == last; }
+};
+
+// Tabel hash terbuka (linear probing) untuk kunci grup orang tua -> nomor grup.
+// Datar (satu array) agar cepat dicari dan bisa disimpan/dimuat apa adanya dari snapshot.
+// Kunci 0 (Ayah & Ibu tidak diketahui) tidak pernah disimpan, jadi dipakai sebagai slot kosong.
+class ParentGroupTable {
+public:
+    static constexpr uint32_t NOT_FOUND = 0xFFFFFFFFu;
+    struct Slot {
+        long long key = 0;
+        uint32_t group = 0;
+    };
+
+    void Clear() { m_slots.clear(); m_count = 0; }
+
+    // Mengembalikan nomor grup yang sudah ada untuk key, atau menyimpan group baru dan mengembalikannya
+    uint32_t Insert(long long key, uint32_t group);
+
+    uint32_t Find(long long key) const {
+        if (m_slots.empty()) return NOT_FOUND;
+        size_t mask = m_slots.size() - 1;
+        for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+            if (m_slots[i].key == key) return m_slots[i].group;
+            if (m_slots[i].key == 0) return NOT_FOUND;
+        }
+    }
+
+    size_t Size() const { return m_count; }
+    const std::vector<Slot>& Slots() const { return m_slots; }
+    void AssignSlots(std::vector<Slot>&& slots, size_t count) { m_slots = std::move(slots); m_count = count; }
+
+private:
+    // Bagian atas hasil kali ikut dicampur ke bit bawah: kunci orang tua tunggal (Ibu = 0) punya
+    // 32 bit bawah nol, dan tanpa campuran itu semuanya jatuh di slot kelipatan yang sama
+    static size_t Hash(long long key) {
+        unsigned long long h = (unsigned long long)key * 0x9E3779B97F4A7C15ull;
+        return (size_t)(h ^ (h >> 32));
+    }
+    void Rehash(size_t capacity);
+
+    std::vector<Slot> m_slots; // Ukuran selalu pangkat dua (atau kosong)
+    size_t m_count = 0;
+};
+
+// Satu garis penghubung hasil layout (koordinat canvas), tidak terikat ke API gambar tertentu
+struct LineSegment {
+    int x1 = 0, y1 = 0;       // Titik awal
+    int x2 = 0, y2 = 0;       // Titik akhir
+    bool dotted = false;      // Garis putus-putus (pasangan yang sudah bercerai)
+};
+
+// Cara menempatkan pohon (dipakai RecalculateLayout dan semua layout inkremental)
+enum class LayoutMode : uint8_t {
+    Classic, // Setiap sub-pohon memesan kotak selebar generasi terlebarnya, berjajar kiri ke kanan
+    Compact, // Sub-pohon saling didekatkan menurut kontur kiri/kanannya di setiap generasi
+};
+
+class DataModel {
+public:
+    static constexpr uint32_t NO_INDEX = 0xFFFFFFFFu; // Orang tua tidak ada di data
+
+    std::vector<Person> people;       // List utama seluruh orang di database
+    StringPool strings;               // Nama dan peran (teks yang sama disimpan sekali)
+    std::vector<SpouseLink> spouseLinks; // Pasangan seluruh orang, berurutan sesuai people
+    IdIndex idToIndex;                // Kamus untuk mencari indeks berdasarkan ID
+    std::filesystem::file_time_type lastWriteTime{}; // Waktu terakhir file diubah (untuk auto-reload)
+    int maxX = 0;                     // Batas terjauh koordinat X (untuk scrollbar)
+    int maxY = 0;                     // Batas terjauh koordinat Y (untuk scrollbar)
+
+    // Kolom layout per orang (indeks sama dengan people), dipisah dari data identitas agar
+    // loop layout dan gambar hanya menyentuh memori yang dibutuhkan
+    std::vector<int> posX;            // Koordinat X di canvas
+    std::vector<int> posY;            // Koordinat Y di canvas
+    std::vector<int> subtreeWidth;    // Total lebar area yang dibutuhkan orang ini dan keturunannya
+    std::vector<uint8_t> placed;      // 1 jika orang ini sudah diatur posisinya
+    std::vector<uint8_t> widthValid;  // 1 jika subtreeWidth masih berlaku (tidak perlu dihitung ulang)
+    std::vector<uint8_t> collapsed;   // 1 jika keturunan orang ini diciutkan (tidak ditempatkan/digambar)
+    LayoutMode layoutMode = LayoutMode::Classic; // Pilihan pengguna, tetap berlaku setelah Clear()/reload
+    std::vector<uint32_t> fatherIndex; // Indeks Ayah di people (NO_INDEX jika tidak ada)
+    std::vector<uint32_t> motherIndex; // Indeks Ibu di people (NO_INDEX jika tidak ada)
+    std::vector<uint32_t> rootCandidates; // Indeks orang tanpa Ayah & Ibu (calon akar keluarga), urut sesuai people
+
+    // Indeks anak format CSR: anak dari grup orang tua ke-g ada di
+    // childIds[childOffsets[g] .. childOffsets[g+1]), urut sesuai urutan di file
+    ParentGroupTable childGroup;                      // Kunci (Ayah, Ibu) -> nomor grup
+    std::vector<size_t> childOffsets;                 // Batas awal tiap grup (ukuran = grup + 1)
+    std::vector<int> childIds;                        // ID anak seluruh grup, disimpan berdampingan
+
+    // Garis penghubung hasil layout format CSR: garis milik people[i] ada di
+    // segments[segmentStart[i] .. segmentStart[i+1])
+    std::vector<LineSegment> segments;
+    std::vector<uint32_t> segmentStart;
+
+    // Menghapus data lama saat akan memuat ulang file
+    void Clear();
+
+    // Indeks orang berdasarkan ID (IdIndex::NPOS jika tidak ada)
+    size_t IndexOf(int id) const { return idToIndex.Find(id); }
+
+    // Mengambil pointer data orang berdasarkan ID
+    const Person* Get(int id) const {
+        size_t index = idToIndex.Find(id);
+        return (index != IdIndex::NPOS) ? &people[index] : nullptr;
+    }
+
+    std::string_view Text(uint32_t handle) const { return strings.Get(handle); }
+
+    SpouseRange Spouses(const Person& p) const {
+        SpouseRange r;
+        r.first = spouseLinks.data() + p.spouseBegin;
+        r.last = r.first + p.spouseCount;
+        return r;
+    }
+
+    // Menggabungkan pasangan ID (Ayah, Ibu) menjadi satu kunci 64-bit
+    static long long ParentKey(int fatherId, int motherId) {
+        return ((long long)(unsigned int)fatherId << 32) | (unsigned int)motherId;
+    }
+
+    // Membangun ulang idToIndex, indeks orang tua, dan indeks anak dalam O(N), lalu
+    // menyiapkan kolom layout kosong. Dipanggil sekali setelah people terisi.
+    void BuildIndexes();
+    // Bagian dari BuildIndexes: idToIndex, indeks orang tua, dan calon akar saja
+    void BuildLookup();
+    // Bagian dari BuildIndexes: kolom layout diisi nol, garis penghubung dikosongkan
+    void ResetLayout();
+
+    // Mengambil daftar anak dari pasangan (Ayah, Ibu); ID 0 berarti orang tua tidak diketahui
+    ChildRange Children(int fatherId, int motherId) const {
+        ChildRange r;
+        if (fatherId == 0 && motherId == 0) return r;
+        uint32_t g = childGroup.Find(ParentKey(fatherId, motherId));
+        if (g == ParentGroupTable::NOT_FOUND) return r;
+        r.first = childIds.data() + childOffsets[g];
+        r.last = childIds.data() + childOffsets[g + 1];
+        return r;
+    }
+
+private:
+    void BuildChildIndex(); // Hitung jumlah anak per grup, prefix sum, lalu isi
+};
+
+// Mengonversi string UTF-8 ke wstring (UTF-16 di Windows, UTF-32 di Linux)
+std::wstring ToWString(std::string_view str);
+
+// Mengonversi teks angka ke tipe data integer secara aman (mencegah crash jika data bukan angka)
+int SafeToInt(std::string_view s);
+
+// Membaca file CSV (atau GEDCOM untuk file .ged, lihat gedcom.h) ke dalam model. Mengembalikan true jika isi model berubah
+// (file dimuat ulang), false jika file tidak ditemukan atau belum berubah sejak load terakhir.
+// threads: jumlah thread parsing (0 = otomatis sesuai jumlah core; file kecil selalu serial).
+// Hasilnya identik untuk berapa pun jumlah thread.
+bool LoadData(DataModel& model, const std::string& path, unsigned threads = 0);
+
+// Ringkasan hasil reload inkremental
+struct ReloadResult {
+    bool changed = false;      // Isi model berubah (tampilan perlu digambar ulang)
+    bool fullReload = false;   // Model dimuat penuh (load pertama), layout dihitung dari nol
+    bool needsLayout = false;  // Struktur/urutan berubah, posisi perlu diperbarui
+    size_t added = 0;          // Jumlah orang baru
+    size_t removed = 0;        // Jumlah orang yang dihapus
+    size_t modified = 0;       // Jumlah orang yang datanya berubah
+    std::vector<int> dirtyIds; // ID yang lebar sub-pohonnya harus dihitung ulang (beserta leluhurnya)
+};
+
+// Memuat ulang file dengan membandingkan isi baru terhadap model lama per ID.
+// Perubahan teks saja (nama/peran/tanda cerai) ditambal langsung tanpa menyentuh layout;
+// perubahan struktur mengisi dirtyIds untuk UpdateLayout().
+ReloadResult ReloadData(DataModel& model, const std::string& path, unsigned threads = 0);
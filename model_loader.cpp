@@ -0,0 +1,169 @@
+#include "model_loader.h"
+#include "snapshot.h"
+#include "stats.h"
+
+#include <chrono>
+#include <iostream>
+
+void ModelLoader::Start(const std::string& path, Callback onReady, bool useSnapshot, unsigned threads) {
+    Stop();
+    m_path = path;
+    m_onReady = std::move(onReady);
+    m_useSnapshot = useSnapshot;
+    m_threads = threads;
+    m_stop = false;
+    m_built = m_requested;
+    m_requested++; // Load pertama
+    m_thread = std::thread(&ModelLoader::Run, this);
+}
+
+void ModelLoader::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void ModelLoader::Request() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requested++; // Pembangunan yang sedang berjalan melihat nomor ini berubah dan berhenti
+    }
+    m_cv.notify_all();
+}
+
+std::unique_ptr<LoadedScene> ModelLoader::TakeResult() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::move(m_result);
+}
+
+void ModelLoader::Recycle(std::unique_ptr<LoadedScene> old) {
+    if (!old) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_spare) m_spare = std::move(old);
+}
+
+void ModelLoader::SetCollapsedIds(std::vector<int> ids) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_collapsedIds = std::move(ids);
+    m_syncCollapsed = true;
+}
+
+void ModelLoader::SetLayoutMode(LayoutMode mode) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_layoutMode = mode;
+}
+
+void ModelLoader::Run() {
+    for (;;) {
+        uint64_t generation;
+        std::unique_ptr<LoadedScene> buf;
+        bool fromResult = false;
+        bool stale = false;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stop || m_requested != m_built; });
+            if (m_stop) return;
+            generation = m_requested;
+            // Basis paling baru: hasil yang belum sempat diambil UI, lalu buffer lama dari UI
+            if (m_result) { buf = std::move(m_result); fromResult = true; }
+            else if (m_spare) buf = std::move(m_spare);
+            else buf = std::make_unique<LoadedScene>();
+            // Buffer lama dari UI bisa tertinggal lebih dari satu versi (mis. file a -> b -> c -> a):
+            // "sama dengan isi buffer" belum tentu "sama dengan yang sedang digambar UI"
+            stale = !fromResult && !buf->model.people.empty() && buf->generation != m_published;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        bool complete = Build(*buf, generation, stale);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        bool publish = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_built = generation;
+            if (!complete) {
+                // Setengah jadi (data baru, posisi lama): dibuang, versi berikutnya dibangun dari buffer lain
+                if (LogEnabled(LogLevel::Info)) std::cout << "[LOADER] generation=" << generation << " cancelled by a newer change\n";
+            } else if (buf->reload.changed || stale) {
+                buf->generation = generation;
+                m_published = generation;
+                buf->buildMs = ms;
+                m_result = std::move(buf);
+                publish = true;
+                if (LogEnabled(LogLevel::Info)) std::cout << "[LOADER] generation=" << generation << " ready in " << ms << " ms\n";
+            } else if (fromResult) {
+                m_result = std::move(buf); // Isi file sama dengan hasil yang menunggu: tetap menunggu
+            } else if (!m_spare) {
+                m_spare = std::move(buf);
+            }
+        }
+        if (publish) m_onReady();
+    }
+}
+
+bool ModelLoader::Build(LoadedScene& buf, uint64_t generation, bool stale) {
+    DataModel& model = buf.model;
+    ReloadResult& r = buf.reload;
+    r = ReloadResult();
+    buf.layout = LayoutStats();
+    LayoutMode mode;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        mode = m_layoutMode;
+    }
+    bool modeChanged = (model.layoutMode != mode);
+    model.layoutMode = mode; // Sebelum snapshot dimuat: layout dengan mode lain tidak dipakai
+
+    // 1. Baca: snapshot/CSV penuh untuk buffer kosong, selain itu reload inkremental
+    bool hasLayout = false;
+    if (model.people.empty() && m_useSnapshot && LoadSnapshot(model, m_path, hasLayout)) {
+        r.changed = r.fullReload = true;
+        r.added = model.people.size();
+        buf.snapshotDirty = false;
+    } else {
+        r = ReloadData(model, m_path, m_threads);
+        if (!r.changed && !stale) return true;
+        if (r.changed) buf.snapshotDirty = true;
+    }
+
+    bool structural = r.fullReload || r.needsLayout; // Orang/orang tua berubah (bukan sekadar status ciut/mode)
+    if (modeChanged && !r.fullReload) r.needsLayout = true; // Posisi buffer ini dihitung dengan mode lain
+
+    // 1b. Status ciut dari UI: buffer ini bisa tertinggal beberapa versi, samakan sebelum layout
+    std::vector<int> collapsedIds;
+    bool syncCollapsed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        syncCollapsed = m_syncCollapsed;
+        if (syncCollapsed) collapsedIds = m_collapsedIds;
+    }
+    if (syncCollapsed) {
+        std::vector<int> dirtyIds = ApplyCollapsedIds(model, collapsedIds);
+        if (!dirtyIds.empty()) {
+            if (r.fullReload) {
+                hasLayout = false; // Layout di snapshot dihitung dengan status ciut lain
+            } else {
+                r.needsLayout = true;
+                r.dirtyIds.insert(r.dirtyIds.end(), dirtyIds.begin(), dirtyIds.end());
+            }
+        }
+    }
+    if (Cancelled(generation)) return false;
+
+    // 2. Layout: penuh, inkremental, atau cukup garis jika hanya teks/tanda cerai yang berubah
+    //    (layout dari snapshot dipakai apa adanya)
+    bool moved = r.fullReload || r.needsLayout;
+    if (!r.fullReload || !hasLayout) buf.layout = ApplyReload(model, r, m_threads);
+    if (Cancelled(generation)) return false;
+
+    // 3. Grid gambar, indeks silsilah, dan indeks pencarian (nama/peran bisa berubah tanpa
+    // perubahan struktur, jadi selalu dibangun ulang); snapshot ditulis sekali saat model pertama kali dibaca dari CSV
+    if (moved) BuildSceneIndex(model, buf.scene);
+    if (structural) buf.pedigree.Build(model, m_threads);
+    buf.search.Build(model, m_threads);
+    if (r.fullReload && buf.snapshotDirty && m_useSnapshot && SaveSnapshot(model, m_path)) buf.snapshotDirty = false;
+    return true;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// MODEL LOADER (Memuat & me-layout Family.csv di thread latar, UI tetap menggambar versi lama)
+// Dua buffer: "depan" dipegang UI untuk digambar, "belakang" diisi thread pekerja. Hasil baru
+// diserahkan utuh (kepemilikan pindah lewat unique_ptr), UI menukar lalu mengembalikan buffer
+// lama lewat Recycle() agar reload berikutnya tetap inkremental. ReloadData membandingkan isi
+// buffer itu sendiri dengan file, sedangkan buffer lama bisa tertinggal beberapa versi dari yang
+// sedang digambar UI (mis. file a -> b -> c -> a). Karena itu nomor versi yang terakhir
+// diserahkan disimpan (m_published): buffer lama dengan nomor lain dianggap basi dan hasilnya
+// selalu diserahkan, walaupun isi file sama dengan isi buffer itu.
+// Permintaan baru saat pembangunan masih berjalan membatalkan pembangunan itu di batas tahap
+// berikutnya (setelah baca file / layout); buffer yang setengah jadi dibuang.
+// -----------------------------------------------------------------------------
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "layout.h"
+#include "model.h"
+#include "pedigree.h"
+#include "search.h"
+#include "spatial_index.h"
+
+// Satu versi data yang siap digambar: model ter-layout beserta grid-nya
+struct LoadedScene {
+    DataModel model;
+    SceneIndex scene;
+    PedigreeIndex pedigree; // Untuk pertanyaan hubungan; dibangun ulang hanya jika struktur berubah
+    SearchIndex search;     // Untuk kotak cari nama/peran; dibangun ulang setiap ada perubahan
+    ReloadResult reload;   // Ringkasan perubahan dibanding isi buffer sebelum dibangun ulang
+    LayoutStats layout;    // Statistik layout (kosong jika posisi tidak berubah)
+    uint64_t generation = 0; // Nomor permintaan yang menghasilkan versi ini
+    double buildMs = 0;      // Waktu membangun versi ini (baca + layout + grid + silsilah + cari)
+    bool snapshotDirty = false; // Model belum tersimpan ke snapshot
+};
+
+class ModelLoader {
+public:
+    using Callback = std::function<void()>;
+
+    ModelLoader() = default;
+    ~ModelLoader() { Stop(); }
+    ModelLoader(const ModelLoader&) = delete;
+    ModelLoader& operator=(const ModelLoader&) = delete;
+
+    // Mulai thread pekerja dan langsung minta load pertama. onReady dipanggil dari thread
+    // pekerja setiap ada hasil baru (mis. PostMessage ke jendela). useSnapshot: load pertama
+    // mencoba snapshot dulu dan menyimpannya bila model dibaca dari CSV.
+    void Start(const std::string& path, Callback onReady, bool useSnapshot = true, unsigned threads = 0);
+    void Stop();
+
+    // File berubah: bangun versi baru. Pembangunan yang sedang berjalan dibatalkan.
+    void Request();
+
+    // Hasil terbaru yang belum diambil (nullptr jika tidak ada). Dipanggil dari thread UI.
+    std::unique_ptr<LoadedScene> TakeResult();
+
+    // Mengembalikan buffer yang tidak lagi digambar UI untuk dipakai ulang sebagai buffer belakang
+    void Recycle(std::unique_ptr<LoadedScene> old);
+
+    // Status ciut terbaru di UI (lihat CollapsedIds). Buffer belakang bisa tertinggal beberapa
+    // versi, jadi setiap pembangunan berikutnya menyamakan statusnya dulu sebelum layout. Sebelum
+    // dipanggil pertama kali, status dari snapshot/buffer itu sendiri yang dipakai.
+    void SetCollapsedIds(std::vector<int> ids);
+
+    // Mode layout di UI (classic/compact). Boleh dipanggil sebelum Start agar load pertama (dan
+    // layout di snapshot) langsung memakai mode itu; buffer dengan mode lain di-layout ulang.
+    void SetLayoutMode(LayoutMode mode);
+
+private:
+    void Run();
+    // false jika dibatalkan permintaan yang lebih baru. stale: buf lebih lama dari versi yang
+    // terakhir diserahkan ke UI, jadi tetap dibangun walaupun isi file sama dengan isi buf.
+    bool Build(LoadedScene& buf, uint64_t generation, bool stale);
+    bool Cancelled(uint64_t generation) const { return m_stop || m_requested != generation; }
+
+    std::string m_path;
+    Callback m_onReady;
+    bool m_useSnapshot = true;
+    unsigned m_threads = 0;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::atomic<bool> m_stop{false};
+    std::atomic<uint64_t> m_requested{0}; // Nomor permintaan terbaru
+    uint64_t m_built = 0;                  // Nomor permintaan terakhir yang selesai/dibatalkan
+    uint64_t m_published = 0;              // Nomor versi terakhir yang diserahkan ke UI
+
+    std::unique_ptr<LoadedScene> m_result; // Hasil siap yang belum diambil UI
+    std::unique_ptr<LoadedScene> m_spare;  // Buffer lama dari UI (basi jika generation != m_published)
+    std::vector<int> m_collapsedIds;       // Status ciut dari UI
+    bool m_syncCollapsed = false;          // true setelah SetCollapsedIds dipanggil
+    LayoutMode m_layoutMode = LayoutMode::Classic;
+};
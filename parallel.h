@@ -0,0 +1,36 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// PARALLEL (Pembagian tugas ke beberapa thread)
+// Semua bagian yang paralel (layout, garis penghubung, pedigree, search, validator, kinship)
+// memakai pola yang sama: tugas 0..count-1 diambil dari satu penghitung bersama, jadi thread
+// yang selesai lebih dulu langsung mengambil tugas berikutnya. Thread pemanggil ikut bekerja.
+// -----------------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Jumlah thread yang dipakai: 0 = otomatis (jumlah core, minimal 1)
+inline unsigned ResolveThreads(unsigned threads) {
+    return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Menjalankan fn(task) atau fn(task, worker) untuk task 0..count-1 di `threads` thread.
+// worker = nomor thread (0 = thread pemanggil, selalu < threads) untuk memilih data milik
+// thread itu sendiri (mis. penghitung atau tabel hasil antara).
+template <typename Fn> void ParallelFor(size_t count, unsigned threads, Fn&& fn) {
+    std::atomic<size_t> next(0);
+    auto worker = [&](unsigned w) {
+        for (size_t t = next++; t < count; t = next++) {
+            if constexpr (std::is_invocable_v<Fn&, size_t, unsigned>) fn(t, w);
+            else fn(t);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned k = 1; k < threads && k < count; ++k) pool.emplace_back(worker, k);
+    worker(0);
+    for (std::thread& th : pool) th.join();
+}
@@ -0,0 +1,434 @@
+#include "pedigree.h"
+#include "parallel.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+#include <unordered_set>
+
+static const uint32_t NONE = DataModel::NO_INDEX;
+
+void PedigreeIndex::Clear() {
+    m_father.clear();
+    m_mother.clear();
+    m_childStart.clear();
+    m_children.clear();
+    m_generation.clear();
+    m_primary.clear();
+    m_depth.clear();
+    m_tin.clear();
+    m_tout.clear();
+    m_up.clear();
+    m_flags.clear();
+    m_cyclesCut = 0;
+}
+
+void PedigreeIndex::Build(const DataModel& model, unsigned threads) {
+    ScopedTimer timer(Stage::Pedigree);
+    Clear();
+    size_t n = model.people.size();
+    threads = ResolveThreads(threads);
+    m_father = model.fatherIndex;
+    m_mother = model.motherIndex;
+    for (size_t i = 0; i < n; ++i) {
+        if (m_father[i] == i) { m_father[i] = NONE; m_cyclesCut++; } // Orang tua dirinya sendiri
+        if (m_mother[i] == i) { m_mother[i] = NONE; m_cyclesCut++; }
+        if (m_mother[i] == m_father[i]) m_mother[i] = NONE;          // Ayah & Ibu orang yang sama
+    }
+
+    // 1. Anak per orang (CSR)
+    auto buildChildren = [&]() {
+        m_childStart.assign(n + 1, 0);
+        for (size_t i = 0; i < n; ++i) {
+            if (m_father[i] != NONE) m_childStart[m_father[i] + 1]++;
+            if (m_mother[i] != NONE) m_childStart[m_mother[i] + 1]++;
+        }
+        for (size_t i = 0; i < n; ++i) m_childStart[i + 1] += m_childStart[i];
+        m_children.resize(m_childStart[n]);
+        std::vector<uint32_t> fill(m_childStart.begin(), m_childStart.end() - 1);
+        for (size_t i = 0; i < n; ++i) {
+            if (m_father[i] != NONE) m_children[fill[m_father[i]]++] = (uint32_t)i;
+            if (m_mother[i] != NONE) m_children[fill[m_mother[i]]++] = (uint32_t)i;
+        }
+    };
+    buildChildren();
+
+    // 2. Urutan topologis (orang tua selalu sebelum anak). Jika tertahan, ada siklus: telusuri
+    //    orang tua yang belum selesai sampai bertemu orang yang sama, lalu putus satu hubungannya.
+    std::vector<uint8_t> pending(n), queued(n, 0);
+    std::vector<uint32_t> order;
+    order.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        pending[i] = (uint8_t)((m_father[i] != NONE) + (m_mother[i] != NONE));
+        if (pending[i] == 0) { queued[i] = 1; order.push_back((uint32_t)i); }
+    }
+    std::vector<uint32_t> seen;
+    uint32_t walk = 0;
+    size_t head = 0, scan = 0;
+    size_t cutBefore = m_cyclesCut;
+    for (;;) {
+        while (head < order.size()) {
+            uint32_t u = order[head++];
+            for (uint32_t k = m_childStart[u]; k < m_childStart[u + 1]; ++k) {
+                uint32_t c = m_children[k];
+                if (m_father[c] != u && m_mother[c] != u) continue; // Hubungan sudah diputus
+                if (--pending[c] == 0) { queued[c] = 1; order.push_back(c); }
+            }
+        }
+        if (order.size() == n) break;
+        while (queued[scan]) scan++;
+        if (seen.empty()) seen.assign(n, 0);
+        walk++;
+        auto waitingParent = [&](uint32_t x) { return (m_father[x] != NONE && !queued[m_father[x]]) ? m_father[x] : m_mother[x]; };
+        uint32_t u = (uint32_t)scan;
+        while (seen[u] != walk) { seen[u] = walk; u = waitingParent(u); }
+        uint32_t p = waitingParent(u);
+        (m_father[u] == p ? m_father[u] : m_mother[u]) = NONE;
+        m_cyclesCut++;
+        if (--pending[u] == 0) { queued[u] = 1; order.push_back(u); }
+    }
+    if (m_cyclesCut != cutBefore) buildChildren();
+    std::vector<uint8_t>().swap(pending);
+    std::vector<uint8_t>().swap(queued);
+    std::vector<uint32_t>().swap(seen);
+
+    // 3. Generasi, orang tua utama, dan kedalaman di hutan (mengikuti urutan topologis)
+    auto hasParents = [&](uint32_t x) { return m_father[x] != NONE || m_mother[x] != NONE; };
+    m_generation.assign(n, 0);
+    m_primary.assign(n, NONE);
+    m_depth.assign(n, 0);
+    int maxDepth = 0;
+    for (uint32_t u : order) {
+        uint32_t f = m_father[u], m = m_mother[u];
+        int g = 0;
+        if (f != NONE) g = std::max(g, m_generation[f] + 1);
+        if (m != NONE) g = std::max(g, m_generation[m] + 1);
+        m_generation[u] = g;
+        uint32_t p = (f != NONE && (m == NONE || hasParents(f) || !hasParents(m))) ? f : m;
+        m_primary[u] = p;
+        if (p != NONE) {
+            m_depth[u] = m_depth[p] + 1;
+            maxDepth = std::max(maxDepth, m_depth[u]);
+        }
+    }
+
+    // 4. Penanda garis sederhana. Orang tua kedua "daun": tanpa leluhur dan semua anaknya punya
+    //    orang tua utama yang sama (bukan dirinya), sehingga selalu berada tepat di samping garis.
+    m_flags.assign(n, 0);
+    for (size_t s = 0; s < n; ++s) {
+        if (hasParents((uint32_t)s) || m_childStart[s] == m_childStart[s + 1]) continue;
+        uint32_t partner = m_primary[m_children[m_childStart[s]]];
+        bool leaf = partner != (uint32_t)s;
+        for (uint32_t k = m_childStart[s]; leaf && k < m_childStart[s + 1]; ++k) leaf = m_primary[m_children[k]] == partner;
+        if (leaf) m_flags[s] |= FLAG_LEAF_ANCESTOR;
+    }
+    for (uint32_t u : order) {
+        uint32_t p = m_primary[u];
+        uint32_t q = (p == m_father[u]) ? m_mother[u] : m_father[u];
+        bool simple = (p == NONE || (m_flags[p] & FLAG_SIMPLE)) && (q == NONE || (m_flags[q] & FLAG_LEAF_ANCESTOR));
+        if (simple) m_flags[u] |= FLAG_SIMPLE;
+    }
+    std::vector<uint32_t>().swap(order);
+
+    // 5. Euler tour hutan (iteratif): tin saat masuk, tout = tin terbesar di sub-pohonnya
+    std::vector<uint32_t> forestStart(n + 1, 0), forest;
+    for (size_t i = 0; i < n; ++i) if (m_primary[i] != NONE) forestStart[m_primary[i] + 1]++;
+    for (size_t i = 0; i < n; ++i) forestStart[i + 1] += forestStart[i];
+    forest.resize(forestStart[n]);
+    {
+        std::vector<uint32_t> fill(forestStart.begin(), forestStart.end() - 1);
+        for (size_t i = 0; i < n; ++i) if (m_primary[i] != NONE) forest[fill[m_primary[i]]++] = (uint32_t)i;
+    }
+    m_tin.assign(n, 0);
+    m_tout.assign(n, 0);
+    uint32_t clock = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> stack; // (orang, anak berikutnya di forest)
+    for (size_t r = 0; r < n; ++r) {
+        if (m_primary[r] != NONE) continue;
+        m_tin[r] = clock++;
+        stack.push_back({ (uint32_t)r, forestStart[r] });
+        while (!stack.empty()) {
+            auto& top = stack.back();
+            if (top.second < forestStart[top.first + 1]) {
+                uint32_t c = forest[top.second++];
+                m_tin[c] = clock++;
+                stack.push_back({ c, forestStart[c] });
+            } else {
+                m_tout[top.first] = clock - 1;
+                stack.pop_back();
+            }
+        }
+    }
+
+    // 6. Binary lifting: level ke-k bergantung pada level k-1, isi tiap level dibagi ke thread
+    int levels = 1;
+    while ((1 << levels) <= maxDepth) levels++;
+    m_up.assign(levels, std::vector<uint32_t>(n));
+    for (size_t i = 0; i < n; ++i) m_up[0][i] = (m_primary[i] == NONE) ? (uint32_t)i : m_primary[i];
+    size_t chunks = (size_t)threads * 8;
+    size_t per = (n + chunks - 1) / chunks;
+    for (int k = 1; k < levels; ++k) {
+        const std::vector<uint32_t>& prev = m_up[k - 1];
+        std::vector<uint32_t>& cur = m_up[k];
+        ParallelFor(chunks, (n < 100000) ? 1 : threads, [&](size_t c) {
+            for (size_t i = std::min(n, c * per); i < std::min(n, (c + 1) * per); ++i) cur[i] = prev[prev[i]];
+        });
+    }
+}
+
+uint32_t PedigreeIndex::Lift(uint32_t node, int generations) const {
+    for (int k = 0; generations > 0; ++k, generations >>= 1) {
+        if (generations & 1) node = m_up[k][node];
+    }
+    return node;
+}
+
+uint32_t PedigreeIndex::ForestLca(uint32_t a, uint32_t b) const {
+    if (m_depth[a] < m_depth[b]) std::swap(a, b);
+    a = Lift(a, m_depth[a] - m_depth[b]);
+    if (a == b) return a;
+    for (int k = (int)m_up.size() - 1; k >= 0; --k) {
+        if (m_up[k][a] != m_up[k][b]) { a = m_up[k][a]; b = m_up[k][b]; }
+    }
+    if (m_primary[a] == NONE) return NONE; // Dua akar berbeda: pohon yang tidak terhubung
+    return m_primary[a];
+}
+
+uint32_t PedigreeIndex::LeafAncestorChildOnLine(uint32_t a, uint32_t b) const {
+    if (!(m_flags[a] & FLAG_LEAF_ANCESTOR)) return NONE;
+    for (uint32_t k = m_childStart[a]; k < m_childStart[a + 1]; ++k) {
+        if (InForestSubtree(m_children[k], b)) return m_children[k];
+    }
+    return NONE;
+}
+
+bool PedigreeIndex::FullSiblings(uint32_t a, uint32_t b) const {
+    return m_father[a] != NONE && m_mother[a] != NONE && m_father[a] == m_father[b] && m_mother[a] == m_mother[b];
+}
+
+bool PedigreeIndex::IsAncestor(size_t ancestor, size_t person) const {
+    uint32_t a = (uint32_t)ancestor, d = (uint32_t)person;
+    if (a == d) return false;
+    if (m_flags[d] & FLAG_SIMPLE) return InForestSubtree(a, d) || LeafAncestorChildOnLine(a, d) != NONE;
+
+    std::vector<uint32_t> stack = { d };
+    std::unordered_set<uint32_t> seen;
+    while (!stack.empty()) {
+        uint32_t x = stack.back();
+        stack.pop_back();
+        for (uint32_t p : { m_father[x], m_mother[x] }) {
+            if (p == NONE || !seen.insert(p).second) continue;
+            if (p == a) return true;
+            stack.push_back(p);
+        }
+    }
+    return false;
+}
+
+// BFS per generasi lewat next(x, fn) sampai maxGenerations; jarak = generasi terdekat
+template <typename Next> static std::vector<Relative> Walk(uint32_t start, int maxGenerations, Next&& next) {
+    std::vector<Relative> out;
+    std::unordered_set<uint32_t> seen = { start };
+    std::vector<uint32_t> level = { start }, following;
+    for (int g = 1; !level.empty() && (maxGenerations < 0 || g <= maxGenerations); ++g) {
+        following.clear();
+        for (uint32_t x : level) {
+            next(x, [&](uint32_t y) {
+                if (seen.insert(y).second) following.push_back(y);
+            });
+        }
+        std::sort(following.begin(), following.end());
+        for (uint32_t y : following) out.push_back({ y, g });
+        level.swap(following);
+    }
+    return out;
+}
+
+std::vector<Relative> PedigreeIndex::Ancestors(size_t index, int maxGenerations) const {
+    return Walk((uint32_t)index, maxGenerations, [&](uint32_t x, auto&& add) {
+        if (m_father[x] != NONE) add(m_father[x]);
+        if (m_mother[x] != NONE) add(m_mother[x]);
+    });
+}
+
+std::vector<Relative> PedigreeIndex::Descendants(size_t index, int maxGenerations) const {
+    return Walk((uint32_t)index, maxGenerations, [&](uint32_t x, auto&& add) {
+        for (uint32_t k = m_childStart[x]; k < m_childStart[x + 1]; ++k) add(m_children[k]);
+    });
+}
+
+// Penelusuran leluhur kedua orang: leluhur bersama dengan jumlah generasi terkecil (lalu
+// jarak dari a terkecil). lcas (opsional) diisi semua leluhur bersama dengan jarak yang sama.
+static Relationship ExactRelate(const std::vector<uint32_t>& father, const std::vector<uint32_t>& mother,
+                                uint32_t a, uint32_t b, std::vector<uint32_t>* lcas) {
+    // Wadah per thread dipakai ulang antar pertanyaan (RelateBatch) agar tidak alokasi tiap kali
+    static thread_local std::unordered_map<uint32_t, int> s_distA;
+    static thread_local std::unordered_set<uint32_t> s_seen;
+    static thread_local std::vector<std::pair<uint32_t, int>> s_queue;
+    auto bfs = [&](uint32_t start, auto&& visit) {
+        s_queue.clear();
+        s_queue.push_back({ start, 0 });
+        s_seen.clear();
+        s_seen.insert(start);
+        for (size_t h = 0; h < s_queue.size(); ++h) {
+            auto [x, d] = s_queue[h];
+            visit(x, d);
+            for (uint32_t p : { father[x], mother[x] }) {
+                if (p != NONE && s_seen.insert(p).second) s_queue.push_back({ p, d + 1 });
+            }
+        }
+    };
+    s_distA.clear();
+    bfs(a, [&](uint32_t x, int d) { s_distA.emplace(x, d); });
+
+    Relationship r;
+    std::vector<uint32_t> best;
+    bfs(b, [&](uint32_t x, int d) {
+        auto it = s_distA.find(x);
+        if (it == s_distA.end()) return;
+        int up = it->second;
+        bool better = !r.related || up + d < r.up + r.down || (up + d == r.up + r.down && up < r.up);
+        if (better) {
+            r.related = true;
+            r.up = up;
+            r.down = d;
+            best.clear();
+        }
+        if (r.up == up && r.down == d) best.push_back(x);
+    });
+    if (!r.related) return r;
+    std::sort(best.begin(), best.end());
+    r.ancestor = best.front();
+    r.half = r.up > 0 && r.down > 0 && best.size() < 2;
+    if (lcas) *lcas = std::move(best);
+    return r;
+}
+
+Relationship PedigreeIndex::RelateExact(size_t a, size_t b) const {
+    return ExactRelate(m_father, m_mother, (uint32_t)a, (uint32_t)b, nullptr);
+}
+
+Relationship PedigreeIndex::Relate(size_t ai, size_t bi) const {
+    uint32_t a = (uint32_t)ai, b = (uint32_t)bi;
+    Relationship r;
+    if (a == b) {
+        r.related = true;
+        r.ancestor = a;
+        return r;
+    }
+    if (!(m_flags[a] & FLAG_SIMPLE) || !(m_flags[b] & FLAG_SIMPLE)) return RelateExact(a, b);
+
+    // Garis lurus: lewat hutan, atau lewat orang tua kedua (menantu) di samping garis
+    uint32_t c;
+    if (InForestSubtree(a, b)) { r.related = true; r.down = m_depth[b] - m_depth[a]; r.ancestor = a; return r; }
+    if (InForestSubtree(b, a)) { r.related = true; r.up = m_depth[a] - m_depth[b]; r.ancestor = b; return r; }
+    if ((c = LeafAncestorChildOnLine(a, b)) != NONE) { r.related = true; r.down = m_depth[b] - m_depth[c] + 1; r.ancestor = a; return r; }
+    if ((c = LeafAncestorChildOnLine(b, a)) != NONE) { r.related = true; r.up = m_depth[a] - m_depth[c] + 1; r.ancestor = b; return r; }
+
+    // Garis menyamping: LCA di hutan, lalu anak LCA di kedua garis menentukan sekandung/tiri
+    uint32_t lca = ForestLca(a, b);
+    if (lca == NONE) return r;
+    r.related = true;
+    r.up = m_depth[a] - m_depth[lca];
+    r.down = m_depth[b] - m_depth[lca];
+    r.ancestor = lca;
+    r.half = !FullSiblings(Lift(a, r.up - 1), Lift(b, r.down - 1));
+    return r;
+}
+
+std::vector<uint32_t> PedigreeIndex::LowestCommonAncestors(size_t a, size_t b) const {
+    std::vector<uint32_t> lcas;
+    if (!(m_flags[a] & FLAG_SIMPLE) || !(m_flags[b] & FLAG_SIMPLE)) {
+        ExactRelate(m_father, m_mother, (uint32_t)a, (uint32_t)b, &lcas);
+        return lcas;
+    }
+    Relationship r = Relate(a, b);
+    if (!r.related) return lcas;
+    lcas.push_back(r.ancestor);
+    if (r.up > 0 && r.down > 0 && !r.half) {
+        // Pasangan LCA: orang tua lain dari anaknya di garis a
+        uint32_t child = Lift((uint32_t)a, r.up - 1);
+        lcas.push_back(m_father[child] == r.ancestor ? m_mother[child] : m_father[child]);
+        std::sort(lcas.begin(), lcas.end());
+    }
+    return lcas;
+}
+
+void PedigreeIndex::RelateBatch(const std::vector<std::pair<uint32_t, uint32_t>>& pairs, std::vector<Relationship>& out,
+                                unsigned threads) const {
+    threads = ResolveThreads(threads);
+    out.resize(pairs.size());
+    size_t chunk = 4096;
+    ParallelFor((pairs.size() + chunk - 1) / chunk, threads, [&](size_t c) {
+        for (size_t k = c * chunk; k < std::min(pairs.size(), (c + 1) * chunk); ++k) {
+            out[k] = Relate(pairs[k].first, pairs[k].second);
+        }
+    });
+}
+
+// -----------------------------------------------------------------------------
+// NAMA HUBUNGAN (Penjelasan)
+// -----------------------------------------------------------------------------
+
+static std::string Gendered(Gender gender, const char* male, const char* female, const char* neutral) {
+    return (gender == Gender::Male) ? male : (gender == Gender::Female) ? female : neutral;
+}
+
+// "great-" sebanyak count (lebih dari tiga ditulis "4x great-")
+static std::string Greats(int count) {
+    if (count <= 0) return "";
+    if (count > 3) return std::to_string(count) + "x great-";
+    std::string s;
+    for (int i = 0; i < count; ++i) s += "great-";
+    return s;
+}
+
+static std::string Ordinal(int n) {
+    static const char* const WORDS[] = { "", "first", "second", "third", "fourth", "fifth",
+                                         "sixth", "seventh", "eighth", "ninth", "tenth" };
+    if (n <= 10) return WORDS[n];
+    const char* suffix = (n % 100 >= 11 && n % 100 <= 13) ? "th" : (n % 10 == 1) ? "st" : (n % 10 == 2) ? "nd" : (n % 10 == 3) ? "rd" : "th";
+    return std::to_string(n) + suffix;
+}
+
+static std::string Times(int n) {
+    if (n == 1) return "once";
+    if (n == 2) return "twice";
+    if (n == 3) return "three times";
+    return std::to_string(n) + " times";
+}
+
+std::string RelationshipName(const Relationship& r, Gender gender) {
+    if (!r.related) return "not related";
+    int up = r.up, down = r.down;
+    if (up == 0 && down == 0) return "self";
+    std::string half = r.half ? "half-" : "";
+    if (up == 0) { // a leluhur b
+        if (down == 1) return Gendered(gender, "father", "mother", "parent");
+        return Greats(down - 2) + Gendered(gender, "grandfather", "grandmother", "grandparent");
+    }
+    if (down == 0) { // a keturunan b
+        if (up == 1) return Gendered(gender, "son", "daughter", "child");
+        return Greats(up - 2) + Gendered(gender, "grandson", "granddaughter", "grandchild");
+    }
+    if (up == 1 && down == 1) return half + Gendered(gender, "brother", "sister", "sibling");
+    if (up == 1) return Greats(down - 2) + half + Gendered(gender, "uncle", "aunt", "uncle or aunt");
+    if (down == 1) return Greats(up - 2) + half + Gendered(gender, "nephew", "niece", "nephew or niece");
+    std::string name = (r.half ? "half " : "") + Ordinal(std::min(up, down) - 1) + " cousin";
+    if (up != down) name += " " + Times(std::abs(up - down)) + " removed";
+    return name;
+}
+
+std::string DescribeRelationship(const DataModel& model, const PedigreeIndex& pedigree, size_t a, size_t b) {
+    const Person& pa = model.people[a];
+    std::string spouse;
+    for (const SpouseLink& link : model.Spouses(pa)) {
+        if (link.id != model.people[b].id) continue;
+        spouse = (link.ex ? "ex-" : "") + Gendered(pa.gender, "husband", "wife", "spouse");
+    }
+    Relationship r = pedigree.Relate(a, b);
+    if (spouse.empty()) return RelationshipName(r, pa.gender);
+    if (!r.related) return spouse;
+    return spouse + " and " + RelationshipName(r, pa.gender);
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// PEDIGREE (Indeks silsilah: leluhur, keturunan, generasi, dan hubungan dua orang)
+// Setiap orang punya satu "orang tua utama": yang punya leluhur di data (jika keduanya, Ayah).
+// Garis orang tua utama membentuk hutan yang diberi Euler tour (uji leluhur O(1)) dan tabel
+// binary lifting (LCA O(log n)). Orang tua yang lain biasanya menantu tanpa leluhur di data;
+// selama itu berlaku di sepanjang garis leluhur kedua orang, jawaban dari hutan sudah tepat
+// untuk seluruh silsilah. Garis yang melewati pernikahan antar kerabat, atau menantu yang punya
+// anak dari beberapa pasangan, dijawab dengan penelusuran leluhur (sebanding jumlah leluhur).
+// Semua fungsi memakai indeks people (bukan ID). Bangun ulang setelah struktur data berubah.
+// -----------------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "model.h"
+
+// Satu orang hasil Ancestors/Descendants beserta jaraknya (generasi terdekat)
+struct Relative {
+    uint32_t index;
+    int generations;
+};
+
+// Hubungan darah a terhadap b lewat leluhur bersama terdekat
+struct Relationship {
+    bool related = false;  // Orang yang sama atau punya leluhur bersama
+    int up = 0;            // Generasi dari a naik ke leluhur bersama (0 = a sendiri leluhurnya)
+    int down = 0;          // Generasi dari b naik ke leluhur bersama
+    bool half = false;     // Hanya lewat satu leluhur, bukan sepasang (mis. saudara seayah)
+    uint32_t ancestor = DataModel::NO_INDEX; // Salah satu leluhur bersama terdekat
+};
+
+class PedigreeIndex {
+public:
+    // threads: untuk tabel binary lifting (0 = otomatis). Hubungan orang tua yang membentuk
+    // siklus (data rusak) diputus dan dihitung di CyclesCut().
+    void Build(const DataModel& model, unsigned threads = 0);
+    void Clear();
+    size_t Size() const { return m_generation.size(); }
+    size_t CyclesCut() const { return m_cyclesCut; }
+
+    // Generasi: 0 untuk orang tanpa orang tua di data, selain itu 1 + generasi orang tua terjauh
+    int Generation(size_t index) const { return m_generation[index]; }
+    // Orang tua setelah siklus diputus (DataModel::NO_INDEX jika tidak ada)
+    uint32_t Father(size_t index) const { return m_father[index]; }
+    uint32_t Mother(size_t index) const { return m_mother[index]; }
+
+    // true jika ancestor adalah leluhur (bukan diri sendiri) dari person
+    bool IsAncestor(size_t ancestor, size_t person) const;
+
+    // Semua leluhur/keturunan sampai maxGenerations (-1 = tanpa batas), urut menurut jarak lalu indeks
+    std::vector<Relative> Ancestors(size_t index, int maxGenerations = -1) const;
+    std::vector<Relative> Descendants(size_t index, int maxGenerations = -1) const;
+
+    // Leluhur bersama terdekat (biasanya sepasang suami istri, atau satu orang untuk hubungan
+    // tiri/garis lurus). Kosong jika tidak berhubungan darah.
+    std::vector<uint32_t> LowestCommonAncestors(size_t a, size_t b) const;
+
+    // O(log n) jika garis leluhur keduanya sederhana (lihat atas), selain itu penelusuran leluhur
+    Relationship Relate(size_t a, size_t b) const;
+    // Selalu lewat penelusuran leluhur (untuk verifikasi jalur cepat)
+    Relationship RelateExact(size_t a, size_t b) const;
+    // Banyak pasangan sekaligus, dibagi ke beberapa thread (0 = otomatis)
+    void RelateBatch(const std::vector<std::pair<uint32_t, uint32_t>>& pairs, std::vector<Relationship>& out,
+                     unsigned threads = 0) const;
+
+    // true jika pertanyaan tentang orang ini bisa dijawab dari hutan saja
+    bool SimpleLine(size_t index) const { return (m_flags[index] & FLAG_SIMPLE) != 0; }
+
+private:
+    static constexpr uint8_t FLAG_SIMPLE = 1;        // Garis leluhur sederhana
+    static constexpr uint8_t FLAG_LEAF_ANCESTOR = 2; // Tanpa leluhur, semua anaknya dari satu orang tua utama lain
+
+    bool InForestSubtree(uint32_t root, uint32_t node) const { return m_tin[root] <= m_tin[node] && m_tin[node] <= m_tout[root]; }
+    uint32_t Lift(uint32_t node, int generations) const;
+    uint32_t ForestLca(uint32_t a, uint32_t b) const;
+    // a tanpa leluhur yang menjadi orang tua kedua di garis b: anak a di garis itu (atau NO_INDEX)
+    uint32_t LeafAncestorChildOnLine(uint32_t a, uint32_t b) const;
+    bool FullSiblings(uint32_t a, uint32_t b) const;
+
+    std::vector<uint32_t> m_father, m_mother;   // Orang tua (siklus sudah diputus)
+    std::vector<uint32_t> m_childStart, m_children; // Anak per orang (CSR, lewat Ayah dan Ibu)
+    std::vector<int> m_generation;
+    std::vector<uint32_t> m_primary;            // Orang tua utama (induk di hutan) atau NO_INDEX
+    std::vector<int> m_depth;                   // Kedalaman di hutan
+    std::vector<uint32_t> m_tin, m_tout;        // Euler tour hutan
+    std::vector<std::vector<uint32_t>> m_up;    // m_up[k][i] = leluhur utama ke-2^k (akar menunjuk dirinya)
+    std::vector<uint8_t> m_flags;
+    size_t m_cyclesCut = 0;
+};
+
+// Nama hubungan a terhadap b dalam bahasa Inggris ("father", "second cousin once removed",
+// "not related"); gender a menentukan kata (father/mother/parent)
+std::string RelationshipName(const Relationship& r, Gender gender);
+
+// Seperti RelationshipName, tetapi juga mengenali pasangan/mantan pasangan
+std::string DescribeRelationship(const DataModel& model, const PedigreeIndex& pedigree, size_t a, size_t b);
@@ -0,0 +1,396 @@
+#include "search.h"
+#include "parallel.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+// -----------------------------------------------------------------------------
+// FOLDING (Huruf kecil dan huruf dasar tanpa diakritik)
+// -----------------------------------------------------------------------------
+
+// Huruf dasar U+00C0..U+00FF dan U+0100..U+017F ('.' = tidak punya huruf dasar tunggal)
+static const char LATIN1_BASE[] = "AAAAAA.CEEEEIIIIDNOOOOO.OUUUUY..aaaaaa.ceeeeiiiidnooooo.ouuuuy.y";
+static const char LATIN_EXT_A_BASE[] =
+    "AaAaAaCcCcCcCcDdDdEeEeEeEeEeGgGgGgGgHhHhIiIiIiIiIiIiJjKkkLlLlLlLlLlNnNnNnnNnOoOoOoOoRrRrRrSsSsSsSsTtTtTtUuUuUuUuUuUuWwYyYZzZzZzs";
+
+// Huruf dasar (dengan kapitalisasinya) atau 0 jika tidak berubah; dua huruf untuk Æ, ß, Œ
+static uint32_t StripDiacritic(uint32_t cp, uint32_t& second) {
+    second = 0;
+    switch (cp) {
+        case 0xC6: second = 'E'; return 'A';
+        case 0xE6: second = 'e'; return 'a';
+        case 0xDF: second = 's'; return 's';
+        case 0x152: second = 'E'; return 'O';
+        case 0x153: second = 'e'; return 'o';
+    }
+    if (cp >= 0xC0 && cp <= 0xFF) return LATIN1_BASE[cp - 0xC0] == '.' ? 0 : (uint32_t)LATIN1_BASE[cp - 0xC0];
+    if (cp >= 0x100 && cp <= 0x17F) return (uint32_t)LATIN_EXT_A_BASE[cp - 0x100];
+    if (cp == 0x1A0 || cp == 0x1A1) return cp == 0x1A0 ? 'O' : 'o'; // Ơ ơ (Vietnam)
+    if (cp == 0x1AF || cp == 0x1B0) return cp == 0x1AF ? 'U' : 'u'; // Ư ư
+    if (cp >= 0x1EA0 && cp <= 0x1EF9) { // Vietnam: pasangan kapital (genap) / kecil (ganjil)
+        char base = cp <= 0x1EB7 ? 'A' : cp <= 0x1EC7 ? 'E' : cp <= 0x1ECB ? 'I' : cp <= 0x1EE3 ? 'O' : cp <= 0x1EF1 ? 'U' : 'Y';
+        return (cp % 2) ? (uint32_t)(base + 32) : (uint32_t)base;
+    }
+    switch (cp) { // Tonos/dialitika Yunani
+        case 0x386: return 0x391; case 0x388: return 0x395; case 0x389: return 0x397; case 0x38A: return 0x399;
+        case 0x38C: return 0x39F; case 0x38E: return 0x3A5; case 0x38F: return 0x3A9;
+        case 0x3AC: return 0x3B1; case 0x3AD: return 0x3B5; case 0x3AE: return 0x3B7; case 0x3AF: return 0x3B9;
+        case 0x3CC: return 0x3BF; case 0x3CD: return 0x3C5; case 0x3CE: return 0x3C9;
+        case 0x390: case 0x3CA: return 0x3B9;
+        case 0x3B0: case 0x3CB: return 0x3C5;
+    }
+    return 0;
+}
+
+static uint32_t ToLower(uint32_t cp) {
+    if (cp < 0x80) return (cp >= 'A' && cp <= 'Z') ? cp + 32 : cp;
+    if (cp >= 0xC0 && cp <= 0xDE && cp != 0xD7) return cp + 0x20;
+    if ((cp >= 0x100 && cp <= 0x137) || (cp >= 0x14A && cp <= 0x177)) return (cp % 2) ? cp : cp + 1;
+    if ((cp >= 0x139 && cp <= 0x148) || (cp >= 0x179 && cp <= 0x17E)) return (cp % 2) ? cp + 1 : cp;
+    if (cp == 0x178) return 0xFF;
+    if (cp == 0x1A0 || cp == 0x1AF) return cp + 1;
+    if (cp == 0x386) return 0x3AC;
+    if (cp >= 0x388 && cp <= 0x38A) return cp + 0x25;
+    if (cp == 0x38C) return 0x3CC;
+    if (cp == 0x38E || cp == 0x38F) return cp + 0x3F;
+    if (cp >= 0x391 && cp <= 0x3AB && cp != 0x3A2) return cp + 0x20;
+    if (cp == 0x3C2) return 0x3C3; // Sigma akhir
+    if (cp >= 0x400 && cp <= 0x40F) return cp + 0x50;
+    if (cp >= 0x410 && cp <= 0x42F) return cp + 0x20;
+    if ((cp >= 0x1E00 && cp <= 0x1E95) || (cp >= 0x1EA0 && cp <= 0x1EFF)) return (cp % 2) ? cp : cp + 1;
+    return cp;
+}
+
+static void AppendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += (char)cp;
+    } else if (cp < 0x800) {
+        out += (char)(0xC0 | (cp >> 6));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += (char)(0xE0 | (cp >> 12));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else {
+        out += (char)(0xF0 | (cp >> 18));
+        out += (char)(0x80 | ((cp >> 12) & 0x3F));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+// Satu karakter UTF-8 mulai dari text[i]; byte tidak valid dikembalikan apa adanya (length 1, valid false)
+static uint32_t DecodeUtf8(std::string_view text, size_t i, size_t& length, bool& valid) {
+    unsigned char c = (unsigned char)text[i];
+    length = 1;
+    valid = true;
+    if (c < 0x80) return c;
+    int extra = (c >= 0xF0 && c < 0xF8) ? 3 : (c >= 0xE0) ? 2 : (c >= 0xC0) ? 1 : -1;
+    if (extra < 0 || i + extra >= text.size()) {
+        valid = false;
+        return c;
+    }
+    uint32_t cp = c & (0x3F >> extra);
+    for (int k = 1; k <= extra; ++k) {
+        unsigned char cc = (unsigned char)text[i + k];
+        if ((cc & 0xC0) != 0x80) {
+            valid = false;
+            return c;
+        }
+        cp = (cp << 6) | (cc & 0x3F);
+    }
+    length = (size_t)extra + 1;
+    return cp;
+}
+
+// Seperti FoldText, tetapi menambahkan ke out (tanpa alokasi string baru per teks)
+static void AppendFolded(std::string& out, std::string_view text, bool ignoreCase, bool ignoreDiacritics) {
+    for (size_t i = 0; i < text.size(); ) {
+        unsigned char c = (unsigned char)text[i];
+        if (c >= 0x20 && c < 0x7F) { // Jalur cepat ASCII
+            out += (ignoreCase && c >= 'A' && c <= 'Z') ? (char)(c + 32) : (char)c;
+            i++;
+            continue;
+        }
+        size_t length;
+        bool valid;
+        uint32_t cp = DecodeUtf8(text, i, length, valid);
+        if (!valid) {
+            out += text[i++];
+            continue;
+        }
+        i += length;
+        if (cp < 0x20 || cp == 0x7F) cp = ' ';
+        if (ignoreDiacritics && cp >= 0x300 && cp <= 0x36F) continue; // Tanda diakritik gabung (NFD)
+        uint32_t second = 0;
+        if (ignoreDiacritics) {
+            uint32_t base = StripDiacritic(cp, second);
+            if (base) cp = base;
+        }
+        AppendUtf8(out, ignoreCase ? ToLower(cp) : cp);
+        if (second) AppendUtf8(out, ignoreCase ? ToLower(second) : second);
+    }
+}
+
+std::string FoldText(std::string_view text, bool ignoreCase, bool ignoreDiacritics) {
+    std::string out;
+    out.reserve(text.size());
+    AppendFolded(out, text, ignoreCase, ignoreDiacritics);
+    return out;
+}
+
+// -----------------------------------------------------------------------------
+// INDEX (Bucket trigram, pencarian kandidat, dan pencocokan ulang)
+// -----------------------------------------------------------------------------
+
+// Pemisah kata: byte ASCII selain huruf/angka (byte UTF-8 >= 0x80 dianggap bagian kata)
+static bool IsSeparator(char c) {
+    unsigned char u = (unsigned char)c;
+    return u < 0x80 && !((u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9'));
+}
+
+static bool IsWordStart(std::string_view text, size_t pos) {
+    return !IsSeparator(text[pos]) && (pos == 0 || IsSeparator(text[pos - 1]));
+}
+
+// Trigram: 3 byte apa adanya. Awal kata: penanda 1/2 di byte teratas + 2 atau 1 byte pertama
+// kata (untuk query awalan yang lebih pendek dari 3 byte). Byte teks terlipat selalu >= 0x20,
+// jadi kedua jenis kunci tidak pernah sama.
+static uint32_t Trigram(std::string_view t, size_t i) {
+    return ((uint32_t)(unsigned char)t[i] << 16) | ((uint32_t)(unsigned char)t[i + 1] << 8) | (unsigned char)t[i + 2];
+}
+static uint32_t WordStartGram(std::string_view t, size_t i) {
+    if (i + 1 < t.size() && !IsSeparator(t[i + 1])) return 0x01000000u | ((uint32_t)(unsigned char)t[i] << 8) | (unsigned char)t[i + 1];
+    return 0x02000000u | (unsigned char)t[i];
+}
+
+template <typename Fn> static void ForEachGram(std::string_view text, Fn&& fn) {
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (IsWordStart(text, i)) {
+            fn(0x02000000u | (unsigned char)text[i]);
+            if (i + 1 < text.size() && !IsSeparator(text[i + 1])) fn(WordStartGram(text, i));
+        }
+        if (i + 2 < text.size()) fn(Trigram(text, i));
+    }
+}
+
+static uint32_t Bucket(uint32_t key, int bits) {
+    return (key * 2654435761u) >> (32 - bits);
+}
+
+void SearchIndex::Clear() {
+    m_bucketBits = 0;
+    m_bucketStart.clear();
+    m_postings.clear();
+    m_textStart.clear();
+    m_text.clear();
+    m_roleOf.clear();
+    m_roleHandle.clear();
+    m_roleText.clear();
+    m_rolePeopleStart.clear();
+    m_rolePeople.clear();
+}
+
+void SearchIndex::Build(const DataModel& model, unsigned threads) {
+    ScopedTimer timer(Stage::Search);
+    Clear();
+    size_t n = model.people.size();
+    unsigned parts = (n < 50000) ? 1 : ResolveThreads(threads); // Potongan orang berurutan, satu per thread
+
+    // 1. Lipat semua nama per potongan, lalu gabungkan jadi satu buffer
+    std::vector<std::string> texts(parts);
+    std::vector<std::vector<uint32_t>> lengths(parts);
+    auto partBegin = [&](size_t t) { return n * t / parts; };
+    ParallelFor(parts, parts, [&](size_t t) {
+        for (size_t i = partBegin(t); i < partBegin(t + 1); ++i) {
+            size_t before = texts[t].size();
+            AppendFolded(texts[t], model.Text(model.people[i].name), true, true);
+            lengths[t].push_back((uint32_t)(texts[t].size() - before));
+        }
+    });
+    m_textStart.reserve(n + 1);
+    m_textStart.push_back(0);
+    size_t total = 0;
+    for (const std::string& t : texts) total += t.size();
+    m_text.reserve(total);
+    for (size_t t = 0; t < parts; ++t) {
+        m_text += texts[t];
+        for (uint32_t len : lengths[t]) m_textStart.push_back(m_textStart.back() + len);
+        std::string().swap(texts[t]);
+    }
+
+    // 2. Gram -> orang (CSR per bucket). Jenis gram di nama sungguhan hanya puluhan ribu, jadi
+    //    tabel bucket dibatasi 2^18 agar hitungannya muat di cache. Tiap thread menghitung
+    //    potongannya sendiri lalu menulis ke posisinya di bucket, sehingga daftar tetap urut indeks.
+    m_bucketBits = 10;
+    while (m_bucketBits < 18 && ((size_t)1 << m_bucketBits) < m_text.size() / 16) m_bucketBits++;
+    size_t buckets = (size_t)1 << m_bucketBits;
+    // Grams satu orang bisa jatuh di bucket yang sama berkali-kali; cukup dicek terhadap orang
+    // terakhir yang tercatat di bucket itu (per thread)
+    auto forEachBucket = [&](size_t i, std::vector<uint32_t>& last, auto&& fn) {
+        ForEachGram(FoldedName(i), [&](uint32_t key) {
+            uint32_t b = Bucket(key, m_bucketBits);
+            if (last[b] == (uint32_t)i) return;
+            last[b] = (uint32_t)i;
+            fn(b);
+        });
+    };
+    std::vector<std::vector<uint32_t>> offsets(parts, std::vector<uint32_t>(buckets, 0));
+    ParallelFor(parts, parts, [&](size_t t) {
+        std::vector<uint32_t> last(buckets, DataModel::NO_INDEX);
+        for (size_t i = partBegin(t); i < partBegin(t + 1); ++i) forEachBucket(i, last, [&](uint32_t b) { offsets[t][b]++; });
+    });
+    m_bucketStart.assign(buckets + 1, 0);
+    for (size_t b = 0; b < buckets; ++b) {
+        uint32_t at = m_bucketStart[b];
+        for (size_t t = 0; t < parts; ++t) {
+            uint32_t count = offsets[t][b];
+            offsets[t][b] = at;
+            at += count;
+        }
+        m_bucketStart[b + 1] = at;
+    }
+    m_postings.resize(m_bucketStart[buckets]);
+    ParallelFor(parts, parts, [&](size_t t) {
+        std::vector<uint32_t> last(buckets, DataModel::NO_INDEX);
+        for (size_t i = partBegin(t); i < partBegin(t + 1); ++i) {
+            forEachBucket(i, last, [&](uint32_t b) { m_postings[offsets[t][b]++] = (uint32_t)i; });
+        }
+    });
+
+    // 3. Peran unik (di-intern di string pool, jadi cukup dibedakan dari nomor teksnya)
+    std::unordered_map<uint32_t, uint32_t> roleSlot;
+    m_roleOf.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t handle = model.people[i].role;
+        auto it = roleSlot.find(handle);
+        if (it == roleSlot.end()) {
+            it = roleSlot.emplace(handle, (uint32_t)m_roleHandle.size()).first;
+            m_roleHandle.push_back(handle);
+            m_roleText.push_back(FoldText(model.Text(handle)));
+        }
+        m_roleOf[i] = it->second;
+    }
+    m_rolePeopleStart.assign(m_roleHandle.size() + 1, 0);
+    for (uint32_t r : m_roleOf) m_rolePeopleStart[r + 1]++;
+    for (size_t r = 0; r < m_roleHandle.size(); ++r) m_rolePeopleStart[r + 1] += m_rolePeopleStart[r];
+    m_rolePeople.resize(n);
+    std::vector<uint32_t> fill(m_rolePeopleStart.begin(), m_rolePeopleStart.end() - 1);
+    for (size_t i = 0; i < n; ++i) m_rolePeople[fill[m_roleOf[i]]++] = (uint32_t)i;
+}
+
+bool SearchIndex::Candidates(const std::string& q, SearchMode mode, std::vector<uint32_t>& out) const {
+    using Range = std::pair<const uint32_t*, const uint32_t*>;
+    std::vector<Range> lists;
+    auto add = [&](uint32_t key) {
+        uint32_t b = Bucket(key, m_bucketBits);
+        lists.push_back({ m_postings.data() + m_bucketStart[b], m_postings.data() + m_bucketStart[b + 1] });
+    };
+    for (size_t i = 0; i + 2 < q.size(); ++i) add(Trigram(q, i));
+    if (mode == SearchMode::Prefix && !IsSeparator(q[0])) add(WordStartGram(q, 0));
+    if (lists.empty()) return false;
+
+    // Mulai dari daftar terpendek, saring dengan daftar berikutnya (disusuri bersamaan). Berhenti
+    // jika daftar berikutnya jauh lebih panjang dari kandidat: menyusurinya lebih mahal daripada
+    // langsung mencocokkan kandidat yang tersisa.
+    std::sort(lists.begin(), lists.end(), [](const Range& a, const Range& b) { return a.second - a.first < b.second - b.first; });
+    out.assign(lists[0].first, lists[0].second);
+    for (size_t k = 1; k < lists.size() && out.size() > 32; ++k) {
+        const uint32_t* from = lists[k].first;
+        const uint32_t* end = lists[k].second;
+        if ((size_t)(end - from) > out.size() * 4) break;
+        size_t kept = 0;
+        for (uint32_t i : out) {
+            while (from != end && *from < i) ++from;
+            if (from == end) break;
+            if (*from == i) out[kept++] = i;
+        }
+        out.resize(kept);
+    }
+    return true;
+}
+
+// Rank kecocokan q di text (lihat SearchHit), -1 jika tidak cocok
+static int MatchRank(std::string_view text, std::string_view q, SearchMode mode) {
+    if (text == q) return 0;
+    int best = -1;
+    for (size_t pos = text.find(q); pos != std::string_view::npos; pos = text.find(q, pos + 1)) {
+        int rank = (pos == 0) ? 1 : IsWordStart(text, pos) ? 2 : 3;
+        if (best < 0 || rank < best) best = rank;
+        if (best <= 2) break; // Rank 1 hanya mungkin di kemunculan pertama
+    }
+    return (best == 3 && mode == SearchMode::Prefix) ? -1 : best;
+}
+
+size_t SearchIndex::Find(const DataModel& model, std::string_view query, const SearchOptions& options,
+                         std::vector<SearchHit>& out) const {
+    out.clear();
+    while (!query.empty() && query.front() == ' ') query.remove_prefix(1);
+    while (!query.empty() && query.back() == ' ') query.remove_suffix(1);
+    if (query.empty() || Size() == 0 || Size() != model.people.size()) return 0;
+
+    // Gram selalu dari teks terlipat penuh; jika pencarian peka huruf/diakritik, kandidat
+    // dicocokkan ulang dengan teks asli yang dilipat sesuai opsi
+    bool fullFold = options.ignoreCase && options.ignoreDiacritics;
+    std::string q = FoldText(query);
+    std::string qv = fullFold ? q : FoldText(query, options.ignoreCase, options.ignoreDiacritics);
+    bool searchNames = (options.fields & SEARCH_NAME) != 0;
+    auto nameRank = [&](uint32_t i) {
+        if (fullFold) return MatchRank(FoldedName(i), qv, options.mode);
+        return MatchRank(FoldText(model.Text(model.people[i].name), options.ignoreCase, options.ignoreDiacritics), qv, options.mode);
+    };
+
+    // 1. Peran: cocokkan tiap peran unik sekali
+    std::vector<int> roleRank;
+    size_t total = 0;
+    if (options.fields & SEARCH_ROLE) {
+        roleRank.assign(m_roleHandle.size(), -1);
+        for (size_t r = 0; r < m_roleHandle.size(); ++r) {
+            roleRank[r] = fullFold ? MatchRank(m_roleText[r], qv, options.mode)
+                                   : MatchRank(FoldText(model.Text(m_roleHandle[r]), options.ignoreCase, options.ignoreDiacritics), qv, options.mode);
+            if (roleRank[r] >= 0) total += m_rolePeopleStart[r + 1] - m_rolePeopleStart[r];
+        }
+    }
+
+    // 2. Nama: kandidat dari irisan daftar gram (atau semua orang untuk query sangat pendek).
+    //    Hanya `limit` hasil pertama per rank yang disimpan, sisanya cukup dihitung; orang yang
+    //    juga cocok lewat peran tidak dihitung dua kali.
+    std::vector<SearchHit> names[4];
+    if (searchNames) {
+        auto check = [&](uint32_t i) {
+            int rank = nameRank(i);
+            if (rank < 0) return;
+            if (roleRank.empty() || roleRank[m_roleOf[i]] < 0) total++;
+            if (names[rank].size() < options.limit) names[rank].push_back({ i, SEARCH_NAME, (uint8_t)rank });
+        };
+        std::vector<uint32_t> candidates;
+        if (Candidates(q, options.mode, candidates)) {
+            for (uint32_t i : candidates) check(i);
+        } else {
+            for (uint32_t i = 0; i < (uint32_t)Size(); ++i) check(i);
+        }
+    }
+
+    // 3. Hasil terbaik: per rank, nama dulu lalu peran (gabungan daftar orang per peran, urut
+    //    indeks). Orang yang cocok lewat nama sudah tercantum di bagian nama.
+    for (int rank = 0; rank <= 3 && out.size() < options.limit; ++rank) {
+        for (size_t k = 0; k < names[rank].size() && out.size() < options.limit; ++k) out.push_back(names[rank][k]);
+        if (roleRank.empty()) continue;
+        using Cursor = std::pair<const uint32_t*, const uint32_t*>;
+        std::vector<Cursor> lists;
+        for (size_t r = 0; r < roleRank.size(); ++r) {
+            if (roleRank[r] == rank) lists.push_back({ m_rolePeople.data() + m_rolePeopleStart[r], m_rolePeople.data() + m_rolePeopleStart[r + 1] });
+        }
+        while (out.size() < options.limit) {
+            Cursor* pick = nullptr;
+            for (Cursor& l : lists) {
+                if (l.first != l.second && (!pick || *l.first < *pick->first)) pick = &l;
+            }
+            if (!pick) break;
+            uint32_t i = *pick->first++;
+            if (!searchNames || nameRank(i) < 0) out.push_back({ i, SEARCH_ROLE, (uint8_t)rank });
+        }
+    }
+    return total;
+}
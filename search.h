@@ -0,0 +1,74 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// SEARCH (Indeks pencarian nama dan peran)
+// Nama setiap orang disimpan sekali dalam bentuk terlipat (huruf kecil, tanpa tanda diakritik:
+// "José Müller" -> "jose muller") lalu dipecah menjadi trigram byte beserta awalan setiap kata.
+// Trigram dimasukkan ke sejumlah bucket hash (format CSR); tabrakan hash hanya menambah kandidat
+// yang kemudian dicocokkan ulang, jadi hasil tetap tepat. Peran hanya sedikit macamnya sehingga
+// dicocokkan per peran unik, lalu orang-orangnya diambil dari daftar per peran.
+// -----------------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "model.h"
+
+enum class SearchMode : uint8_t {
+    Prefix,    // Query berada di awal salah satu kata ("san" cocok dengan "Budi Santoso")
+    Substring, // Query berada di mana saja
+};
+
+const uint8_t SEARCH_NAME = 1;
+const uint8_t SEARCH_ROLE = 2;
+
+struct SearchOptions {
+    SearchMode mode = SearchMode::Substring;
+    uint8_t fields = SEARCH_NAME | SEARCH_ROLE;
+    bool ignoreCase = true;
+    bool ignoreDiacritics = true;
+    size_t limit = 50; // Jumlah hasil maksimum di out (jumlah seluruh hasil tetap dihitung)
+};
+
+// Satu hasil: rank 0 = teks persis sama, 1 = awal teks, 2 = awal kata, 3 = di tengah kata
+struct SearchHit {
+    uint32_t index;
+    uint8_t field; // SEARCH_NAME atau SEARCH_ROLE
+    uint8_t rank;
+};
+
+// Melipat teks UTF-8 untuk dibandingkan: huruf kecil (Latin, Yunani, Sirilik) dan/atau huruf
+// dasar tanpa diakritik (Latin-1, Latin Extended-A, Vietnam, tonos Yunani, tanda gabung).
+// Karakter kontrol menjadi spasi.
+std::string FoldText(std::string_view text, bool ignoreCase = true, bool ignoreDiacritics = true);
+
+class SearchIndex {
+public:
+    void Build(const DataModel& model, unsigned threads = 0);
+    void Clear();
+    size_t Size() const { return m_roleOf.size(); }
+
+    // Hasil terbaik (urut rank, nama sebelum peran, lalu indeks) sampai options.limit ke out.
+    // Mengembalikan jumlah seluruh orang yang cocok. model harus versi yang sama dengan Build.
+    // Query nama kurang dari 3 byte (mode Substring) dicocokkan dengan memindai semua nama.
+    size_t Find(const DataModel& model, std::string_view query, const SearchOptions& options,
+                std::vector<SearchHit>& out) const;
+
+private:
+    // Kandidat nama untuk query terlipat q: irisan daftar gram-gramnya, urut indeks
+    // (false jika query terlalu pendek dan semua nama harus dipindai)
+    bool Candidates(const std::string& q, SearchMode mode, std::vector<uint32_t>& out) const;
+    std::string_view FoldedName(size_t index) const {
+        return std::string_view(m_text).substr(m_textStart[index], m_textStart[index + 1] - m_textStart[index]);
+    }
+
+    int m_bucketBits = 0;
+    std::vector<uint32_t> m_bucketStart, m_postings; // Orang per bucket gram (CSR, urut indeks)
+    std::vector<uint32_t> m_textStart;               // Nama terlipat people[i] = m_text[m_textStart[i] .. i+1)
+    std::string m_text;
+    std::vector<uint32_t> m_roleOf;                  // Nomor peran unik per orang
+    std::vector<uint32_t> m_roleHandle;              // Nomor teks peran (DataModel::strings) per peran unik
+    std::vector<std::string> m_roleText;             // Peran unik terlipat
+    std::vector<uint32_t> m_rolePeopleStart, m_rolePeople; // Orang per peran unik (CSR, urut indeks)
+};
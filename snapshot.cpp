@@ -0,0 +1,317 @@
+#include "snapshot.h"
+#include "mapped_file.h"
+#include "stats.h"
+
+#include <cstring>     // std::memcmp/std::memcpy untuk header dan hash
+#include <filesystem>  // Ukuran, waktu modifikasi, dan rename file
+#include <fstream>     // Membaca dan menulis file snapshot
+#include <iostream>    // Untuk output ke console (debugging)
+#include <type_traits> // Memastikan struct yang disalin mentah memang aman disalin
+
+static const char SNAPSHOT_MAGIC[8] = { 'S', 'L', 'S', 'N', 'A', 'P', '\0', '\0' };
+static const uint32_t SNAPSHOT_VERSION = 3; // 3: hash ParentGroupTable berubah (slot disimpan apa adanya)
+static const uint32_t FLAG_LAYOUT = 1;
+static const uint32_t FLAG_COMPACT = 2; // Layout disimpan dengan LayoutMode::Compact
+
+static_assert(std::is_trivially_copyable<Person>::value, "Person disalin mentah ke snapshot");
+static_assert(std::is_trivially_copyable<SpouseLink>::value, "SpouseLink disalin mentah ke snapshot");
+static_assert(std::is_trivially_copyable<LineSegment>::value, "LineSegment disalin mentah ke snapshot");
+static_assert(std::is_trivially_copyable<ParentGroupTable::Slot>::value, "Slot disalin mentah ke snapshot");
+
+// Header di awal file; setiap bagian sesudahnya dimulai di kelipatan 8 byte
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t personSize;    // sizeof(...) saat ditulis: snapshot dari build lain ditolak
+    uint32_t linkSize;
+    uint32_t segmentSize;
+    uint32_t slotSize;
+    uint64_t csvSize;       // Ukuran dan waktu modifikasi CSV yang menjadi sumber snapshot
+    int64_t csvWriteTime;
+    uint64_t csvHash;       // Hash isi CSV (dipakai jika waktu modifikasi berbeda)
+    uint64_t people;
+    uint64_t links;
+    uint64_t strings;
+    uint64_t stringBytes;
+    uint64_t interned;
+    uint64_t groupSlots;
+    uint64_t groups;
+    uint64_t childIds;
+    uint64_t segments;
+    int32_t maxX;
+    int32_t maxY;
+};
+
+std::string SnapshotPath(const std::string& csvPath) {
+    return csvPath + ".snap";
+}
+
+static size_t Align8(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+// Hash 64-bit sederhana (FNV-1a per 8 byte) untuk mendeteksi perubahan isi CSV
+static uint64_t HashBytes(const char* data, size_t size) {
+    uint64_t h = 0xcbf29ce484222325ull ^ size;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        h = (h ^ word) * 0x100000001b3ull;
+        h ^= h >> 29;
+    }
+    for (; i < size; ++i) h = (h ^ (unsigned char)data[i]) * 0x100000001b3ull;
+    return h;
+}
+
+static bool HashFile(const std::string& path, uint64_t& hash) {
+    MappedFile file;
+    if (!file.Open(path)) return false;
+    hash = HashBytes(file.data(), file.size());
+    return true;
+}
+
+// Pembaca bagian-bagian snapshot secara berurutan, langsung ke vector tujuan.
+// Jumlah elemen dicek terhadap sisa ukuran file sebelum alokasi (header rusak tidak memicu alokasi raksasa).
+struct SectionReader {
+    std::ifstream& in;
+    uint64_t size;
+    uint64_t pos;
+
+    template <typename T> bool Read(std::vector<T>& dst, uint64_t count) {
+        if (pos > size || count > (size - pos) / sizeof(T)) return false;
+        size_t bytes = (size_t)count * sizeof(T);
+        dst.resize((size_t)count);
+        if (bytes) in.read(reinterpret_cast<char*>(dst.data()), (std::streamsize)bytes);
+        pos += Align8(bytes);
+        in.seekg((std::streamoff)pos);
+        return (bool)in;
+    }
+};
+
+// Offset CSR harus mulai dari 0, tidak pernah turun, dan berakhir tepat di ukuran datanya
+template <typename T> static bool ValidOffsets(const std::vector<T>& offsets, uint64_t total) {
+    if (offsets.empty() || offsets.front() != 0 || offsets.back() != total) return false;
+    for (size_t k = 1; k < offsets.size(); ++k) {
+        if (offsets[k] < offsets[k - 1]) return false;
+    }
+    return true;
+}
+
+// Memeriksa isi bagian yang sudah terbaca sebelum dipakai. Ukuran file sudah dicek oleh
+// SectionReader, tapi nomor dan offset di dalamnya bisa rusak (disk/penyalinan) dan akan
+// menjadi akses di luar batas saat digambar atau dicari.
+static bool ValidSnapshot(const SnapshotHeader& h, const DataModel& fresh, const std::vector<uint64_t>& offsets,
+                          const std::vector<uint32_t>& interned, const std::vector<ParentGroupTable::Slot>& slots,
+                          const std::vector<uint64_t>& childOffsets) {
+    // Teks 0 (teks kosong) selalu ada di pool
+    if (h.strings == 0 || !ValidOffsets(offsets, h.stringBytes)) return false;
+    for (uint32_t handle : interned) {
+        if (handle >= h.strings) return false;
+    }
+    for (const Person& p : fresh.people) {
+        if (p.name >= h.strings || p.role >= h.strings) return false;
+        if ((uint64_t)p.spouseBegin + p.spouseCount > h.links) return false;
+    }
+
+    // Tabel grup: ukuran pangkat dua dengan minimal satu slot kosong (Find berhenti di sana),
+    // dan setiap grup tersimpan tepat sekali
+    if (!slots.empty() && (slots.size() & (slots.size() - 1)) != 0) return false;
+    uint64_t used = 0;
+    for (const ParentGroupTable::Slot& slot : slots) {
+        if (slot.key == 0) continue;
+        if (slot.group >= h.groups) return false;
+        used++;
+    }
+    if (used != h.groups || (!slots.empty() && used >= slots.size())) return false;
+    return ValidOffsets(childOffsets, h.childIds);
+}
+
+bool LoadSnapshot(DataModel& model, const std::string& csvPath, bool& hasLayout) {
+    hasLayout = false;
+    std::error_code ec;
+    auto writeTime = std::filesystem::last_write_time(csvPath, ec);
+    if (ec) return false;
+    uint64_t csvSize = std::filesystem::file_size(csvPath, ec);
+    if (ec) return false;
+    std::string path = SnapshotPath(csvPath);
+    uint64_t snapSize = std::filesystem::file_size(path, ec);
+    if (ec || snapSize < sizeof(SnapshotHeader)) return false;
+    ScopedTimer timer(Stage::Snapshot);
+
+    std::ifstream file(path, std::ios::binary);
+    SnapshotHeader h;
+    if (!file.read(reinterpret_cast<char*>(&h), sizeof(h))) return false;
+    if (std::memcmp(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic)) != 0 || h.version != SNAPSHOT_VERSION ||
+        h.personSize != sizeof(Person) || h.linkSize != sizeof(SpouseLink) ||
+        h.segmentSize != sizeof(LineSegment) || h.slotSize != sizeof(ParentGroupTable::Slot)) {
+        if (LogEnabled(LogLevel::Info)) std::cout << "[SNAPSHOT] Ignoring incompatible snapshot\n";
+        return false;
+    }
+
+    // CSV yang hanya "disentuh" (waktu berubah, isi sama) tetap boleh memakai snapshot
+    bool stale = h.csvSize != csvSize;
+    if (!stale && h.csvWriteTime != (int64_t)writeTime.time_since_epoch().count()) {
+        uint64_t hash = 0;
+        stale = !HashFile(csvPath, hash) || hash != h.csvHash;
+    }
+    if (stale) {
+        if (LogEnabled(LogLevel::Info)) std::cout << "[SNAPSHOT] " << path << " is out of date, parsing CSV\n";
+        return false;
+    }
+
+    // Dimuat ke model sementara: jika snapshot terpotong, model pemanggil tidak berubah
+    DataModel fresh;
+    std::vector<uint64_t> offsets, childOffsets;
+    std::vector<char> chars;
+    std::vector<uint32_t> interned;
+    std::vector<ParentGroupTable::Slot> slots;
+    SectionReader in = { file, snapSize, Align8(sizeof(SnapshotHeader)) };
+    file.seekg((std::streamoff)in.pos);
+    bool ok = in.Read(fresh.people, h.people) && in.Read(fresh.spouseLinks, h.links) &&
+              in.Read(offsets, h.strings + 1) && in.Read(chars, h.stringBytes) &&
+              in.Read(interned, h.interned) && in.Read(slots, h.groupSlots) &&
+              in.Read(childOffsets, h.groups + 1) && in.Read(fresh.childIds, h.childIds);
+    if (ok && !ValidSnapshot(h, fresh, offsets, interned, slots, childOffsets)) {
+        if (LogEnabled(LogLevel::Info)) std::cout << "[SNAPSHOT] Ignoring corrupt snapshot\n";
+        return false;
+    }
+    // Layout yang disimpan dengan mode lain tetap dibaca, tapi hanya status ciutnya yang dipakai
+    bool savedLayout = ok && (h.flags & FLAG_LAYOUT) != 0;
+    bool compact = (model.layoutMode == LayoutMode::Compact);
+    hasLayout = savedLayout && ((h.flags & FLAG_COMPACT) != 0) == compact;
+    if (savedLayout) {
+        ok = in.Read(fresh.posX, h.people) && in.Read(fresh.posY, h.people) &&
+             in.Read(fresh.subtreeWidth, h.people) && in.Read(fresh.placed, h.people) &&
+             in.Read(fresh.widthValid, h.people) && in.Read(fresh.collapsed, h.people) &&
+             in.Read(fresh.segments, h.segments) &&
+             in.Read(fresh.segmentStart, h.people + 1) &&
+             ValidOffsets(fresh.segmentStart, h.segments);
+    }
+    if (!ok) {
+        hasLayout = false;
+        if (LogEnabled(LogLevel::Info)) std::cout << "[SNAPSHOT] Ignoring truncated or corrupt snapshot\n";
+        return false;
+    }
+
+    fresh.strings.Assign(chars.data(), offsets.data(), (size_t)h.strings, interned.data(), interned.size());
+    fresh.childGroup.AssignSlots(std::move(slots), (size_t)h.groups);
+    fresh.childOffsets.assign(childOffsets.begin(), childOffsets.end());
+    fresh.BuildLookup();
+    if (hasLayout) {
+        fresh.maxX = h.maxX;
+        fresh.maxY = h.maxY;
+    } else {
+        std::vector<uint8_t> collapsed;
+        if (savedLayout) collapsed.swap(fresh.collapsed); // Status ciut tetap berlaku untuk mode lain
+        fresh.ResetLayout();
+        if (savedLayout) fresh.collapsed.swap(collapsed);
+    }
+    fresh.lastWriteTime = writeTime;
+    fresh.layoutMode = model.layoutMode;
+    model = std::move(fresh);
+
+    if (LogEnabled(LogLevel::Info)) {
+        std::cout << "[SNAPSHOT] Loaded " << model.people.size() << " people from " << path
+                  << (hasLayout ? " (with layout)" : "") << "\n";
+    }
+    return true;
+}
+
+// Menulis satu bagian lalu menambah padding sampai kelipatan 8 byte
+template <typename T> static void WriteSection(std::ofstream& out, const T* data, size_t count) {
+    static const char zeros[8] = {};
+    size_t bytes = count * sizeof(T);
+    if (bytes) out.write(reinterpret_cast<const char*>(data), (std::streamsize)bytes);
+    out.write(zeros, (std::streamsize)(Align8(bytes) - bytes));
+}
+
+bool SaveSnapshot(const DataModel& model, const std::string& csvPath, bool includeLayout) {
+    // Model harus berasal dari isi CSV yang sekarang, jika tidak snapshot akan menyesatkan
+    std::error_code ec;
+    auto writeTime = std::filesystem::last_write_time(csvPath, ec);
+    if (ec || writeTime != model.lastWriteTime) return false;
+    ScopedTimer timer(Stage::Snapshot);
+    uint64_t csvSize = std::filesystem::file_size(csvPath, ec);
+    if (ec) return false;
+    uint64_t csvHash = 0;
+    if (!HashFile(csvPath, csvHash)) return false;
+
+    includeLayout = includeLayout && model.segmentStart.size() == model.people.size() + 1;
+
+    // String pool ditulis sebagai satu blok karakter + tabel offset
+    size_t stringCount = model.strings.Count();
+    std::vector<uint64_t> offsets(stringCount + 1, 0);
+    for (size_t s = 0; s < stringCount; ++s) offsets[s + 1] = offsets[s] + model.Text((uint32_t)s).size();
+    std::vector<uint32_t> interned = model.strings.InternedHandles();
+    std::vector<uint64_t> childOffsets(model.childOffsets.begin(), model.childOffsets.end());
+
+    SnapshotHeader h = {};
+    std::memcpy(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic));
+    h.version = SNAPSHOT_VERSION;
+    h.flags = includeLayout ? FLAG_LAYOUT : 0;
+    if (includeLayout && model.layoutMode == LayoutMode::Compact) h.flags |= FLAG_COMPACT;
+    h.personSize = sizeof(Person);
+    h.linkSize = sizeof(SpouseLink);
+    h.segmentSize = sizeof(LineSegment);
+    h.slotSize = sizeof(ParentGroupTable::Slot);
+    h.csvSize = csvSize;
+    h.csvWriteTime = (int64_t)writeTime.time_since_epoch().count();
+    h.csvHash = csvHash;
+    h.people = model.people.size();
+    h.links = model.spouseLinks.size();
+    h.strings = stringCount;
+    h.stringBytes = offsets.back();
+    h.interned = interned.size();
+    h.groupSlots = model.childGroup.Slots().size();
+    h.groups = childOffsets.empty() ? 0 : childOffsets.size() - 1;
+    if (childOffsets.empty()) childOffsets.push_back(0);
+    h.childIds = model.childIds.size();
+    h.segments = includeLayout ? model.segments.size() : 0;
+    h.maxX = model.maxX;
+    h.maxY = model.maxY;
+
+    std::string path = SnapshotPath(csvPath);
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        WriteSection(out, &h, 1);
+        WriteSection(out, model.people.data(), model.people.size());
+        WriteSection(out, model.spouseLinks.data(), model.spouseLinks.size());
+        WriteSection(out, offsets.data(), offsets.size());
+        // Karakter ditulis per teks (di memori tersebar di beberapa blok), padding di akhir
+        for (size_t s = 0; s < stringCount; ++s) {
+            std::string_view text = model.Text((uint32_t)s);
+            out.write(text.data(), (std::streamsize)text.size());
+        }
+        out.write("\0\0\0\0\0\0\0", (std::streamsize)(Align8(h.stringBytes) - h.stringBytes));
+        WriteSection(out, interned.data(), interned.size());
+        WriteSection(out, model.childGroup.Slots().data(), model.childGroup.Slots().size());
+        WriteSection(out, childOffsets.data(), childOffsets.size());
+        WriteSection(out, model.childIds.data(), model.childIds.size());
+        if (includeLayout) {
+            WriteSection(out, model.posX.data(), model.posX.size());
+            WriteSection(out, model.posY.data(), model.posY.size());
+            WriteSection(out, model.subtreeWidth.data(), model.subtreeWidth.size());
+            WriteSection(out, model.placed.data(), model.placed.size());
+            WriteSection(out, model.widthValid.data(), model.widthValid.size());
+            WriteSection(out, model.collapsed.data(), model.collapsed.size());
+            WriteSection(out, model.segments.data(), model.segments.size());
+            WriteSection(out, model.segmentStart.data(), model.segmentStart.size());
+        }
+        if (!out) {
+            out.close();
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    if (LogEnabled(LogLevel::Info)) std::cout << "[SNAPSHOT] Saved " << model.people.size() << " people to " << path << "\n";
+    return true;
+}
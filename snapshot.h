@@ -0,0 +1,26 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// SNAPSHOT (Cache biner DataModel di samping file CSV untuk startup cepat)
+// File "<csv>.snap" berisi data hasil parsing (orang, pasangan, string pool, indeks anak)
+// dan opsional hasil layout terakhir. Snapshot hanya dipakai jika masih cocok dengan CSV:
+// ukuran sama dan waktu modifikasi sama, atau waktu berbeda tapi isi (hash) tetap sama.
+// Format mengikuti tata letak memori mesin ini; mesin/versi lain cukup membuat ulang dari CSV.
+// -----------------------------------------------------------------------------
+#include <string>
+
+#include "model.h"
+
+// Lokasi snapshot untuk sebuah file CSV
+std::string SnapshotPath(const std::string& csvPath);
+
+// Memuat snapshot ke model jika masih berlaku. Setiap bagian dibaca dengan satu pembacaan besar
+// std::ifstream langsung ke vektor tujuan (tanpa alokasi per orang); pemetaan memori hanya dipakai
+// untuk menghitung hash CSV. hasLayout = true jika posisi ikut dimuat
+// sehingga RecalculateLayout tidak perlu dipanggil. Mengembalikan false jika snapshot tidak ada,
+// rusak, atau sudah basi (model tidak diubah).
+bool LoadSnapshot(DataModel& model, const std::string& csvPath, bool& hasLayout);
+
+// Menulis snapshot model (ditulis ke file sementara lalu diganti namanya). Dilewati jika CSV
+// sudah berubah sejak model dimuat. includeLayout: ikut simpan posisi dan garis penghubung.
+bool SaveSnapshot(const DataModel& model, const std::string& csvPath, bool includeLayout = true);
@@ -0,0 +1,307 @@
+#include "spatial_index.h"
+#include "layout.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+// Menggabungkan satu titik ke dalam rect (rect kosong menjadi rect 1x1 di titik itu)
+static void Extend(Rect& r, int x, int y) {
+    if (r.Empty()) { r = { x, y, x + 1, y + 1 }; return; }
+    r.left = std::min(r.left, x);
+    r.top = std::min(r.top, y);
+    r.right = std::max(r.right, x + 1);
+    r.bottom = std::max(r.bottom, y + 1);
+}
+
+void SpatialGrid::Build(const std::vector<uint32_t>& ids, const std::vector<Rect>& rects) {
+    m_cellStart.clear();
+    m_items.clear();
+    m_bandStart.clear();
+    m_bandItems.clear();
+    m_ids.clear();
+    m_rects.clear();
+    m_queryGen = 0;
+    m_cols = m_rows = 0;
+
+    // Hanya rect yang tidak kosong yang disimpan (slot), jadi ukuran grid mengikuti jumlah item
+    // yang benar-benar ada, bukan jumlah orang di data
+    Rect world;
+    for (size_t k = 0; k < rects.size(); ++k) {
+        const Rect& r = rects[k];
+        if (r.Empty()) continue;
+        m_ids.push_back(ids[k]);
+        m_rects.push_back(r);
+        Extend(world, r.left, r.top);
+        Extend(world, r.right - 1, r.bottom - 1);
+    }
+    m_stamp.assign(m_rects.size(), 0);
+    size_t count = m_rects.size();
+    if (count == 0) return;
+
+    // Ukuran sel: sekitar 2 item per sel, minimal 256 piksel agar grid tidak terlalu besar
+    double area = (double)(world.right - world.left) * (double)(world.bottom - world.top);
+    m_cellSize = std::max(256, (int)std::sqrt(area / (2.0 * (double)count)));
+    m_originX = world.left;
+    m_originY = world.top;
+    m_cols = (world.right - world.left) / m_cellSize + 1;
+    m_rows = (world.bottom - world.top) / m_cellSize + 1;
+
+    // Dua tahap: hitung item per sel, lalu isi (CSR)
+    std::vector<uint32_t> counts((size_t)m_cols * m_rows + 1, 0);
+    auto forEachCell = [&](const Rect& r, auto&& fn) {
+        int c0 = (r.left - m_originX) / m_cellSize, c1 = (r.right - 1 - m_originX) / m_cellSize;
+        int r0 = (r.top - m_originY) / m_cellSize, r1 = (r.bottom - 1 - m_originY) / m_cellSize;
+        for (int row = r0; row <= r1; ++row)
+            for (int col = c0; col <= c1; ++col) fn((size_t)row * m_cols + col);
+    };
+    auto cellSpan = [&](const Rect& r) {
+        long long cols = (r.right - 1 - m_originX) / m_cellSize - (r.left - m_originX) / m_cellSize + 1;
+        long long rows = (r.bottom - 1 - m_originY) / m_cellSize - (r.top - m_originY) / m_cellSize + 1;
+        return cols * rows;
+    };
+    // Item yang sangat lebar (garis ke anak-anak yang tersebar jauh) tidak disalin ke ribuan
+    // sel; item itu hanya dimasukkan ke pita baris (band) dan diurutkan menurut sisi kiri
+    std::vector<bool> wide(count, false);
+    std::vector<uint32_t> bandCounts((size_t)m_rows + 1, 0);
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        const Rect& r = m_rects[slot];
+        if (cellSpan(r) > MAX_CELLS_PER_ITEM) {
+            wide[slot] = true;
+            for (int row = (r.top - m_originY) / m_cellSize; row <= (r.bottom - 1 - m_originY) / m_cellSize; ++row) bandCounts[row + 1]++;
+        } else {
+            forEachCell(r, [&](size_t cell) { counts[cell + 1]++; });
+        }
+    }
+    for (size_t c = 1; c < counts.size(); ++c) counts[c] += counts[c - 1];
+    for (size_t b = 1; b < bandCounts.size(); ++b) bandCounts[b] += bandCounts[b - 1];
+    m_cellStart = counts;
+    m_bandStart = bandCounts;
+    m_items.resize(counts.back());
+    m_bandItems.resize(bandCounts.back());
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        const Rect& r = m_rects[slot];
+        if (wide[slot]) {
+            for (int row = (r.top - m_originY) / m_cellSize; row <= (r.bottom - 1 - m_originY) / m_cellSize; ++row) m_bandItems[bandCounts[row]++] = slot;
+        } else {
+            forEachCell(r, [&](size_t cell) { m_items[counts[cell]++] = slot; });
+        }
+    }
+    for (int row = 0; row < m_rows; ++row) {
+        std::sort(m_bandItems.begin() + m_bandStart[row], m_bandItems.begin() + m_bandStart[row + 1],
+                  [&](uint32_t a, uint32_t b) { return m_rects[a].left < m_rects[b].left; });
+    }
+}
+
+// Memanggil fn(slot) untuk setiap item di sel/pita yang disentuh area (bisa berulang untuk
+// item yang menutupi beberapa sel)
+template <typename Fn> void SpatialGrid::ForEachCandidate(const Rect& area, Fn&& fn) const {
+    if (m_cols == 0 || area.Empty()) return;
+
+    int c0 = std::max(0, (area.left - m_originX) / m_cellSize);
+    int c1 = std::min(m_cols - 1, (area.right - 1 - m_originX) / m_cellSize);
+    int r0 = std::max(0, (area.top - m_originY) / m_cellSize);
+    int r1 = std::min(m_rows - 1, (area.bottom - 1 - m_originY) / m_cellSize);
+    if (area.right - 1 < m_originX || area.bottom - 1 < m_originY || c0 > c1 || r0 > r1) return;
+
+    for (int row = r0; row <= r1; ++row) {
+        // Item lebar: urut menurut sisi kiri, berhenti begitu sisi kiri melewati area
+        for (uint32_t k = m_bandStart[row]; k < m_bandStart[row + 1]; ++k) {
+            uint32_t slot = m_bandItems[k];
+            if (m_rects[slot].left >= area.right) break;
+            fn(slot);
+        }
+    }
+    for (int row = r0; row <= r1; ++row) {
+        for (int col = c0; col <= c1; ++col) {
+            size_t cell = (size_t)row * m_cols + col;
+            for (uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) fn(m_items[k]);
+        }
+    }
+}
+
+static bool Intersects(const Rect& r, const Rect& area) {
+    return r.left < area.right && area.left < r.right && r.top < area.bottom && area.top < r.bottom;
+}
+
+void SpatialGrid::Query(const Rect& area, std::vector<uint32_t>& out) {
+    out.clear();
+    if (m_cols == 0 || area.Empty()) return;
+    if (++m_queryGen == 0) { // Penanda berputar balik: reset sekali
+        std::fill(m_stamp.begin(), m_stamp.end(), 0);
+        m_queryGen = 1;
+    }
+    ForEachCandidate(area, [&](uint32_t slot) {
+        if (m_stamp[slot] == m_queryGen) return;
+        m_stamp[slot] = m_queryGen;
+        // Sel hanya kandidat kasar: cek perpotongan sebenarnya
+        if (Intersects(m_rects[slot], area)) out.push_back(m_ids[slot]);
+    });
+    std::sort(out.begin(), out.end()); // Urutan gambar tetap sama dengan urutan data
+}
+
+void SpatialGrid::QueryConcurrent(const Rect& area, std::vector<uint32_t>& out) const {
+    out.clear();
+    ForEachCandidate(area, [&](uint32_t slot) {
+        if (Intersects(m_rects[slot], area)) out.push_back(m_ids[slot]);
+    });
+    // Tanpa penanda bersama: duplikat dibuang setelah diurutkan
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+// -----------------------------------------------------------------------------
+// OVERVIEW (Blok ringkasan per baris generasi untuk zoom jauh)
+// -----------------------------------------------------------------------------
+
+void OverviewPyramid::Clear() {
+    m_rowTop.clear();
+    m_levels.clear();
+}
+
+void OverviewPyramid::Build(const DataModel& model, const std::vector<uint32_t>& placed) {
+    Clear();
+    if (placed.empty()) return;
+
+    // Baris = posY yang berbeda (sebanyak generasi, jadi set kecil)
+    std::unordered_set<int> tops;
+    for (uint32_t i : placed) tops.insert(model.posY[i]);
+    m_rowTop.assign(tops.begin(), tops.end());
+    std::sort(m_rowTop.begin(), m_rowTop.end());
+    auto rowOf = [&](int y) { return (size_t)(std::lower_bound(m_rowTop.begin(), m_rowTop.end(), y) - m_rowTop.begin()); };
+
+    // Urutkan menurut baris lalu sisi kiri dengan radix sort (LSD, 11 bit per putaran). Kunci 64-bit:
+    // nomor baris di bit atas, posX - minX di tengah, bit 0 = perempuan.
+    size_t rows = m_rowTop.size();
+    std::vector<uint32_t> rowStart(rows + 1, 0);
+    int minX = INT32_MAX, maxX = INT32_MIN;
+    for (uint32_t i : placed) {
+        minX = std::min(minX, model.posX[i]);
+        maxX = std::max(maxX, model.posX[i]);
+    }
+    int xBits = 1;
+    while (xBits < 32 && ((uint64_t)((int64_t)maxX - minX) >> xBits) != 0) xBits++;
+    int rowBits = 1;
+    while (rowBits < 32 && (rows >> rowBits) != 0) rowBits++;
+    std::vector<uint64_t> keys(placed.size()), sorted(placed.size());
+    for (size_t k = 0; k < placed.size(); ++k) {
+        uint32_t i = placed[k];
+        size_t row = rowOf(model.posY[i]);
+        rowStart[row + 1]++;
+        keys[k] = ((uint64_t)row << (xBits + 1)) | ((uint64_t)((int64_t)model.posX[i] - minX) << 1) |
+                  (model.people[i].gender == Gender::Female ? 1 : 0);
+    }
+    for (size_t r = 0; r < rows; ++r) rowStart[r + 1] += rowStart[r];
+    const int DIGIT = 11;
+    std::vector<uint32_t> counts((size_t)1 << DIGIT);
+    for (int shift = 0; shift < 1 + xBits + rowBits; shift += DIGIT) {
+        std::fill(counts.begin(), counts.end(), 0);
+        for (uint64_t key : keys) counts[(key >> shift) & ((1u << DIGIT) - 1)]++;
+        uint32_t sum = 0;
+        for (uint32_t& c : counts) { uint32_t n = c; c = sum; sum += n; }
+        for (uint64_t key : keys) sorted[counts[(key >> shift) & ((1u << DIGIT) - 1)]++] = key;
+        keys.swap(sorted);
+    }
+    uint64_t xMask = ((uint64_t)1 << xBits) - 1;
+
+    // Level 0 langsung dari kotak, level berikutnya dari level sebelumnya
+    m_levels.emplace_back();
+    Level& base = m_levels.back();
+    base.rowStart.push_back(0);
+    for (size_t r = 0; r < rows; ++r) {
+        int top = m_rowTop[r];
+        for (uint32_t k = rowStart[r]; k < rowStart[r + 1]; ++k) {
+            int x = (int)((int64_t)minX + (int64_t)((keys[k] >> 1) & xMask));
+            bool female = keys[k] & 1;
+            bool merge = k > rowStart[r] && x - base.blocks.back().rect.right < BlockGap(0);
+            if (!merge) {
+                OverviewBlock b;
+                b.rect = { x, top, x + BOX_WIDTH, top + BOX_HEIGHT };
+                base.blocks.push_back(b);
+            }
+            OverviewBlock& b = base.blocks.back();
+            b.rect.right = std::max(b.rect.right, x + BOX_WIDTH);
+            b.people++;
+            b.females += female ? 1 : 0;
+        }
+        base.rowStart.push_back((uint32_t)base.blocks.size());
+    }
+
+    const int MAX_LEVELS = 24;
+    while ((int)m_levels.size() < MAX_LEVELS && m_levels.back().blocks.size() > rows) {
+        int level = (int)m_levels.size();
+        m_levels.emplace_back();
+        const Level& prev = m_levels[level - 1];
+        Level& next = m_levels.back();
+        next.rowStart.push_back(0);
+        for (size_t r = 0; r < rows; ++r) {
+            for (uint32_t k = prev.rowStart[r]; k < prev.rowStart[r + 1]; ++k) {
+                const OverviewBlock& b = prev.blocks[k];
+                if (k > prev.rowStart[r] && b.rect.left - next.blocks.back().rect.right < BlockGap(level)) {
+                    OverviewBlock& last = next.blocks.back();
+                    last.rect.right = std::max(last.rect.right, b.rect.right);
+                    last.people += b.people;
+                    last.females += b.females;
+                } else {
+                    next.blocks.push_back(b);
+                }
+            }
+            next.rowStart.push_back((uint32_t)next.blocks.size());
+        }
+    }
+}
+
+int OverviewPyramid::LevelForScale(double scale) const {
+    int level = 0;
+    while (level + 1 < Levels() && BlockGap(level + 1) * scale <= 2.0) level++;
+    return level;
+}
+
+void OverviewPyramid::Query(int level, const Rect& area, std::vector<OverviewBlock>& out) const {
+    out.clear();
+    if (m_levels.empty() || area.Empty()) return;
+    level = std::max(0, std::min(level, Levels() - 1));
+    const Level& lv = m_levels[level];
+    // Baris yang menyentuh area: posY di (area.top - BOX_HEIGHT, area.bottom)
+    size_t r0 = std::upper_bound(m_rowTop.begin(), m_rowTop.end(), area.top - BOX_HEIGHT) - m_rowTop.begin();
+    for (size_t r = r0; r < m_rowTop.size() && m_rowTop[r] < area.bottom; ++r) {
+        // Blok dalam satu baris tidak bertumpuk, jadi sisi kanannya juga urut
+        auto first = std::upper_bound(lv.blocks.begin() + lv.rowStart[r], lv.blocks.begin() + lv.rowStart[r + 1], area.left,
+                                      [](int x, const OverviewBlock& b) { return x < b.rect.right; });
+        for (auto it = first; it != lv.blocks.begin() + lv.rowStart[r + 1] && it->rect.left < area.right; ++it) out.push_back(*it);
+    }
+}
+
+Rect BoxBounds(const DataModel& model, size_t index) {
+    if (!model.placed[index]) return Rect();
+    int x = model.posX[index], y = model.posY[index];
+    return { x, y, x + BOX_WIDTH + 4, y + BOX_HEIGHT + 4 }; // +4: bayangan kotak
+}
+
+Rect ConnectorBounds(const DataModel& model, size_t index) {
+    Rect r;
+    if (index + 1 >= model.segmentStart.size()) return r;
+    for (uint32_t k = model.segmentStart[index]; k < model.segmentStart[index + 1]; ++k) {
+        const LineSegment& s = model.segments[k];
+        Extend(r, s.x1, s.y1);
+        Extend(r, s.x2, s.y2);
+    }
+    if (!r.Empty()) { r.right++; r.bottom++; } // Lebar pena 1 piksel
+    return r;
+}
+
+void BuildSceneIndex(const DataModel& model, SceneIndex& scene) {
+    ScopedTimer timer(Stage::SceneIndex);
+    // Hanya orang yang ditempatkan yang punya kotak dan garis (keturunan yang diciutkan dilewati)
+    std::vector<uint32_t> ids;
+    for (size_t i = 0; i < model.placed.size(); ++i) {
+        if (model.placed[i]) ids.push_back((uint32_t)i);
+    }
+    std::vector<Rect> rects(ids.size());
+    for (size_t k = 0; k < ids.size(); ++k) rects[k] = BoxBounds(model, ids[k]);
+    scene.boxes.Build(ids, rects);
+    for (size_t k = 0; k < ids.size(); ++k) rects[k] = ConnectorBounds(model, ids[k]);
+    scene.connectors.Build(ids, rects);
+    scene.overview.Build(model, ids);
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// SPATIAL INDEX (Grid seragam untuk mencari kotak/garis yang terlihat di layar)
+// -----------------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+
+#include "model.h"
+
+// Persegi panjang koordinat canvas (right/bottom eksklusif). right <= left berarti kosong.
+struct Rect {
+    int left = 0;
+    int top = 0;
+    int right = 0;
+    int bottom = 0;
+    bool Empty() const { return right <= left || bottom <= top; }
+};
+
+// Grid seragam format CSR: item di sel c ada di m_items[m_cellStart[c] .. m_cellStart[c+1]).
+// Item yang menutupi lebih dari MAX_CELLS_PER_ITEM sel disimpan per baris saja (m_bandItems).
+// Sel dan pita menyimpan nomor slot (urutan item yang tidak kosong); ID aslinya ada di m_ids.
+class SpatialGrid {
+public:
+    // Membangun grid dari daftar rect; ID item rects[k] adalah ids[k] (harus naik agar hasil
+    // query tetap urut). Rect kosong tidak dimasukkan.
+    void Build(const std::vector<uint32_t>& ids, const std::vector<Rect>& rects);
+
+    // Mengisi out dengan ID item yang menyentuh area, terurut naik dan tanpa duplikat
+    void Query(const Rect& area, std::vector<uint32_t>& out);
+
+    // Sama seperti Query, tetapi tidak mengubah grid sehingga aman dipanggil dari banyak thread
+    // sekaligus (mis. ekspor tile paralel). Sedikit lebih lambat: duplikat dibuang dengan sort.
+    void QueryConcurrent(const Rect& area, std::vector<uint32_t>& out) const;
+
+    size_t CellCount() const { return m_cellStart.empty() ? 0 : m_cellStart.size() - 1; }
+
+private:
+    template <typename Fn> void ForEachCandidate(const Rect& area, Fn&& fn) const;
+
+    static constexpr long long MAX_CELLS_PER_ITEM = 64; // Di atas ini item masuk pita baris
+
+    int m_originX = 0, m_originY = 0; // Pojok kiri atas grid
+    int m_cellSize = 256;             // Ukuran sel (piksel), dipilih dari luas canvas / jumlah item
+    int m_cols = 0, m_rows = 0;
+    std::vector<uint32_t> m_cellStart;
+    std::vector<uint32_t> m_items;
+    std::vector<uint32_t> m_bandStart; // Item lebar per baris sel (CSR), terurut menurut sisi kiri
+    std::vector<uint32_t> m_bandItems;
+    std::vector<uint32_t> m_ids;      // ID item per slot
+    std::vector<Rect> m_rects;        // Rect asli per slot untuk uji perpotongan tepat
+    std::vector<uint32_t> m_stamp;    // Penanda query terakhir per slot (buang duplikat tanpa alokasi)
+    uint32_t m_queryGen = 0;
+};
+
+// -----------------------------------------------------------------------------
+// LEVEL OF DETAIL (Apa yang digambar menurut skala zoom = piksel layar per piksel canvas)
+// -----------------------------------------------------------------------------
+enum class DetailLevel : uint8_t {
+    Full,   // Kotak lengkap: bayangan, bingkai, nama, dan peran
+    Plain,  // Kotak berwarna polos tanpa teks (teks tidak terbaca lagi)
+    Blocks, // Blok ringkasan per generasi dari OverviewPyramid, tanpa garis
+};
+const double DETAIL_FULL_MIN_SCALE = 0.5;        // Di bawah ini teks terlalu kecil untuk dibaca
+const double DETAIL_PLAIN_MIN_SCALE = 1.0 / 16;  // Di bawah ini kotak lebih kecil dari 8x4 piksel
+
+inline DetailLevel ChooseDetail(double scale) {
+    if (scale >= DETAIL_FULL_MIN_SCALE) return DetailLevel::Full;
+    if (scale >= DETAIL_PLAIN_MIN_SCALE) return DetailLevel::Plain;
+    return DetailLevel::Blocks;
+}
+
+// Satu blok ringkasan: kotak-kotak bersebelahan di satu baris generasi digabung jadi satu rect
+struct OverviewBlock {
+    Rect rect;
+    uint32_t people = 0;  // Jumlah orang di blok
+    uint32_t females = 0; // Jumlah perempuan (warna blok dicampur menurut perbandingan ini)
+};
+
+// Piramida blok per baris generasi (posY yang sama). Level k menggabungkan kotak yang celahnya
+// kurang dari BlockGap(k) piksel canvas; setiap level menggandakan celah sampai satu baris tinggal
+// satu blok. Saat zoom jauh cukup dipilih level yang celahnya di bawah 2 piksel layar, sehingga
+// jumlah blok yang digambar sebanding lebar layar, bukan jumlah orang.
+class OverviewPyramid {
+public:
+    void Build(const DataModel& model, const std::vector<uint32_t>& placed);
+    void Clear();
+
+    static int BlockGap(int level) { return 32 << level; }
+    int Levels() const { return (int)m_levels.size(); }
+    // Level paling kasar yang celah terkecilnya (di layar) belum terlihat pada skala ini
+    int LevelForScale(double scale) const;
+
+    // Blok di level yang menyentuh area, urut baris lalu sisi kiri
+    void Query(int level, const Rect& area, std::vector<OverviewBlock>& out) const;
+    size_t BlockCount(int level) const { return m_levels[level].blocks.size(); }
+
+private:
+    struct Level {
+        std::vector<OverviewBlock> blocks; // Urut baris lalu sisi kiri
+        std::vector<uint32_t> rowStart;    // Blok baris r = blocks[rowStart[r] .. rowStart[r+1])
+    };
+    std::vector<int> m_rowTop; // posY setiap baris (naik)
+    std::vector<Level> m_levels;
+};
+
+// Indeks scene: kotak orang dan kelompok garis penghubung milik tiap orang (indeks = g_Model.people)
+struct SceneIndex {
+    SpatialGrid boxes;
+    SpatialGrid connectors;
+    OverviewPyramid overview; // Blok ringkasan untuk zoom jauh
+};
+
+// Batas kotak (termasuk bayangan) people[index] jika sudah ditempatkan
+Rect BoxBounds(const DataModel& model, size_t index);
+
+// Batas seluruh garis milik people[index] di model.segments (kosong jika tidak ada garis)
+Rect ConnectorBounds(const DataModel& model, size_t index);
+
+// Dibangun ulang setiap kali layout berubah (hanya dari orang yang ditempatkan)
+void BuildSceneIndex(const DataModel& model, SceneIndex& scene);
@@ -0,0 +1,165 @@
+#include "stats.h"
+
+#include <algorithm>   // std::max untuk durasi terlama
+#include <atomic>      // Penghitung yang bisa dipakai dari banyak thread
+#include <cstdint>     // uintptr_t untuk alokasi ber-alignment
+#include <cstdlib>     // std::malloc/std::free untuk operator new pengganti
+#include <fstream>     // Menulis file JSON
+#include <mutex>       // Melindungi statistik tahap
+#include <new>         // std::bad_alloc
+
+// -----------------------------------------------------------------------------
+// ALLOCATION TRACKING (Menghitung alokasi lewat operator new global, -DSILSILAH_ALLOC_STATS)
+// -----------------------------------------------------------------------------
+static std::atomic<uint64_t> s_allocCount{0};
+static std::atomic<uint64_t> s_allocBytes{0};
+
+#ifdef SILSILAH_ALLOC_STATS
+static void CountAlloc(std::size_t size) {
+    s_allocCount.fetch_add(1, std::memory_order_relaxed);
+    s_allocBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+// Versi ber-alignment: blok dari malloc digeser ke kelipatan align, pointer aslinya disimpan
+// tepat sebelum blok yang dikembalikan (tidak bergantung pada aligned_alloc yang tidak ada di MSVC)
+static void* CountedAlignedAlloc(std::size_t size, std::size_t align) {
+    CountAlloc(size);
+    align = std::max(align, sizeof(void*));
+    void* raw = std::malloc(size + align + sizeof(void*));
+    if (!raw) return nullptr;
+    uintptr_t at = ((uintptr_t)raw + sizeof(void*) + align - 1) & ~(uintptr_t)(align - 1);
+    reinterpret_cast<void**>(at)[-1] = raw;
+    return reinterpret_cast<void*>(at);
+}
+
+static void AlignedFree(void* p) {
+    if (p) std::free(reinterpret_cast<void**>(p)[-1]);
+}
+
+void* operator new(std::size_t size) {
+    CountAlloc(size);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    if (void* p = CountedAlignedAlloc(size, (std::size_t)align)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t align) { return operator new(size, align); }
+void operator delete(void* p, std::align_val_t) noexcept { AlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { AlignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { AlignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { AlignedFree(p); }
+#endif
+
+AllocStats GetAllocStats() {
+    AllocStats a;
+    a.count = s_allocCount.load(std::memory_order_relaxed);
+    a.bytes = s_allocBytes.load(std::memory_order_relaxed);
+    return a;
+}
+
+bool AllocTrackingEnabled() {
+#ifdef SILSILAH_ALLOC_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// LOG LEVEL, STAGES & COUNTERS
+// -----------------------------------------------------------------------------
+static std::atomic<int> s_logLevel{(int)LogLevel::Info};
+
+void SetLogLevel(LogLevel level) { s_logLevel = (int)level; }
+bool LogEnabled(LogLevel level) { return (int)level <= s_logLevel.load(std::memory_order_relaxed); }
+
+static std::mutex s_stageMutex;
+static StageStats s_stages[(int)Stage::Count];
+static std::atomic<uint64_t> s_counters[(int)Counter::Count];
+
+const char* StageName(Stage stage) {
+    static const char* const NAMES[] = { "parse", "index_build", "reload", "snapshot", "layout", "connectors", "scene_index", "pedigree", "search", "validate", "kinship", "paint" };
+    return NAMES[(int)stage];
+}
+
+const char* CounterName(Counter counter) {
+    static const char* const NAMES[] = { "people_loaded", "rows_skipped", "widths_computed", "segments", "boxes_drawn" };
+    return NAMES[(int)counter];
+}
+
+StageStats GetStageStats(Stage stage) {
+    std::lock_guard<std::mutex> lock(s_stageMutex);
+    return s_stages[(int)stage];
+}
+
+void AddCounter(Counter counter, uint64_t amount) {
+    s_counters[(int)counter].fetch_add(amount, std::memory_order_relaxed);
+}
+
+uint64_t GetCounter(Counter counter) {
+    return s_counters[(int)counter].load(std::memory_order_relaxed);
+}
+
+void ResetStats() {
+    {
+        std::lock_guard<std::mutex> lock(s_stageMutex);
+        for (StageStats& s : s_stages) s = StageStats();
+    }
+    for (auto& c : s_counters) c = 0;
+}
+
+ScopedTimer::ScopedTimer(Stage stage)
+    : m_stage(stage), m_start(std::chrono::steady_clock::now()), m_allocStart(GetAllocStats()) {}
+
+double ScopedTimer::Stop() {
+    if (!m_running) return 0;
+    m_running = false;
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    AllocStats a = GetAllocStats();
+
+    std::lock_guard<std::mutex> lock(s_stageMutex);
+    StageStats& s = s_stages[(int)m_stage];
+    s.calls++;
+    s.totalMs += ms;
+    s.lastMs = ms;
+    s.maxMs = std::max(s.maxMs, ms);
+    s.allocs += a.count - m_allocStart.count;
+    s.allocBytes += a.bytes - m_allocStart.bytes;
+    return ms;
+}
+
+// -----------------------------------------------------------------------------
+// JSON EXPORT
+// -----------------------------------------------------------------------------
+void WriteStatsJson(std::ostream& out) {
+    AllocStats alloc = GetAllocStats();
+    out << "{\n  \"stages\": {\n";
+    for (int i = 0; i < (int)Stage::Count; ++i) {
+        StageStats s = GetStageStats((Stage)i);
+        out << "    \"" << StageName((Stage)i) << "\": {\"calls\": " << s.calls << ", \"total_ms\": " << s.totalMs
+            << ", \"last_ms\": " << s.lastMs << ", \"max_ms\": " << s.maxMs << ", \"allocs\": " << s.allocs
+            << ", \"alloc_bytes\": " << s.allocBytes << "}" << (i + 1 < (int)Stage::Count ? "," : "") << "\n";
+    }
+    out << "  },\n  \"counters\": {\n";
+    for (int i = 0; i < (int)Counter::Count; ++i) {
+        out << "    \"" << CounterName((Counter)i) << "\": " << GetCounter((Counter)i)
+            << (i + 1 < (int)Counter::Count ? "," : "") << "\n";
+    }
+    out << "  },\n  \"allocations\": {\"tracked\": " << (AllocTrackingEnabled() ? "true" : "false")
+        << ", \"count\": " << alloc.count << ", \"bytes\": " << alloc.bytes << "}\n}\n";
+}
+
+bool WriteStatsJson(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) return false;
+    WriteStatsJson(out);
+    return (bool)out;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// STATS (Instrumentasi bagian inti: timer per tahap, penghitung, alokasi memori, tingkat log)
+// Timer dipasang per tahap (sekali per load/layout/frame), bukan per baris, sehingga biayanya
+// tidak terasa. Alokasi hanya dihitung jika dikompilasi dengan -DSILSILAH_ALLOC_STATS (operator
+// new/delete global diganti, jadi hanya untuk cli/bench); angka per tahap ikut mencakup thread
+// lain yang sedang berjalan.
+// -----------------------------------------------------------------------------
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Tingkat log konsol: Quiet = hanya error, Info = ringkasan per tahap (default),
+// Verbose = juga satu baris per orang/akar (memperlambat file besar)
+enum class LogLevel { Quiet = 0, Info = 1, Verbose = 2 };
+void SetLogLevel(LogLevel level);
+bool LogEnabled(LogLevel level);
+
+// Tahap yang diukur
+enum class Stage {
+    Parse,      // Membaca CSV (termasuk parsing paralel dan penggabungan potongan)
+    IndexBuild, // Indeks ID, orang tua, dan anak
+    Reload,     // ReloadData: membaca file baru (juga tercatat di Parse) dan membandingkannya dengan model
+    Snapshot,   // Memuat/menyimpan snapshot biner
+    Layout,     // Lebar sub-pohon dan penempatan (tanpa garis)
+    Connectors, // BuildConnectors
+    SceneIndex, // Grid kotak & garis
+    Pedigree,   // Indeks silsilah untuk pertanyaan hubungan (PedigreeIndex::Build)
+    Search,     // Indeks pencarian nama/peran (SearchIndex::Build)
+    Validate,   // Pemeriksaan integritas data (ValidateModel)
+    Kinship,    // Koefisien inbreeding semua orang (KinshipIndex::Build)
+    Paint,      // Satu frame di jendela
+    Count
+};
+const char* StageName(Stage stage);
+
+struct StageStats {
+    uint64_t calls = 0;
+    double totalMs = 0;
+    double lastMs = 0;
+    double maxMs = 0;
+    uint64_t allocs = 0;      // Jumlah alokasi selama tahap (total semua panggilan)
+    uint64_t allocBytes = 0;  // Byte yang dialokasikan selama tahap (total semua panggilan)
+};
+StageStats GetStageStats(Stage stage);
+
+// Penghitung kejadian
+enum class Counter {
+    PeopleLoaded,   // Orang yang dibaca dari CSV
+    RowsSkipped,    // Baris CSV yang dilewati (bukan ID)
+    WidthsComputed, // Lebar sub-pohon yang dihitung
+    Segments,       // Garis penghubung yang dibuat
+    BoxesDrawn,     // Kotak yang digambar di jendela
+    Count
+};
+const char* CounterName(Counter counter);
+void AddCounter(Counter counter, uint64_t amount);
+uint64_t GetCounter(Counter counter);
+
+// Total alokasi sejak program mulai (0 jika penghitungan alokasi dimatikan)
+struct AllocStats {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+AllocStats GetAllocStats();
+bool AllocTrackingEnabled();
+
+void ResetStats();
+
+// Semua tahap, penghitung, dan alokasi sebagai satu objek JSON
+void WriteStatsJson(std::ostream& out);
+bool WriteStatsJson(const std::string& path);
+
+// Mengukur satu tahap dari konstruksi sampai destruksi (atau Stop() jika lebih dulu)
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Stage stage);
+    ~ScopedTimer() { Stop(); }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    // Mencatat hasil dan mengembalikan durasi dalam ms (0 jika sudah dihentikan)
+    double Stop();
+
+private:
+    Stage m_stage;
+    bool m_running = true;
+    std::chrono::steady_clock::time_point m_start;
+    AllocStats m_allocStart;
+};
@@ -0,0 +1,1014 @@
+// -----------------------------------------------------------------------------
+// TESTS (Pemeriksaan kebenaran bagian inti, tanpa GUI)
+//   ./silsilah_tests [folder data]   (bawaan tests/data, jalankan dari folder repo)
+// Fixture kecil di tests/data dicek terhadap nilai yang dihitung dengan tangan (posisi, hasil reload,
+// hubungan, koefisien kekerabatan, masalah validasi). Data sintetis kecil dipakai untuk membandingkan jalur cepat dengan cara
+// lambat atau serial (parsing/layout paralel, snapshot, grid, pencarian, GEDCOM, zoom).
+// File sementara ditulis ke folder temp sistem. Exit code 1 jika ada pemeriksaan yang gagal.
+// -----------------------------------------------------------------------------
+#include <algorithm>   // std::sort/std::equal untuk membandingkan hasil
+#include <chrono>      // Menggeser waktu modifikasi file untuk reload
+#include <climits>     // INT32_MIN/MAX untuk query seluruh canvas
+#include <cmath>       // std::fabs untuk membandingkan koefisien
+#include <cstddef>     // offsetof untuk merusak snapshot
+#include <filesystem>  // Folder sementara, salin file, waktu modifikasi
+#include <fstream>     // Menulis file sementara
+#include <iostream>    // Laporan ke console
+#include <iterator>    // Membaca seluruh file untuk dibandingkan
+#include <random>      // Pilihan acak deterministik
+#include <sstream>     // Memecah baris CSV
+#include <string>
+#include <vector>
+
+#include "model.h"
+#include "layout.h"
+#include "spatial_index.h"
+#include "snapshot.h"
+#include "generator.h"
+#include "exporter.h"
+#include "gedcom.h"
+#include "pedigree.h"
+#include "kinship.h"
+#include "search.h"
+#include "validator.h"
+#include "stats.h"
+
+namespace fs = std::filesystem;
+
+static int g_failures = 0;
+static std::string g_data = "tests/data"; // Folder fixture
+static fs::path g_temp;                   // Folder file sementara
+
+static void Fail(int line, const char* expr) {
+    g_failures++;
+    std::cout << "[FAIL] tests.cpp:" << line << ": " << expr << "\n";
+}
+
+#define CHECK(cond) do { if (!(cond)) Fail(__LINE__, #cond); } while (0)
+#define CHECK_EQ(actual, expected) do { \
+        auto a_ = (actual); auto e_ = (expected); \
+        if (!(a_ == e_)) { Fail(__LINE__, #actual " == " #expected); std::cout << "       got " << a_ << ", expected " << e_ << "\n"; } \
+    } while (0)
+
+static std::string Data(const char* name) { return g_data + "/" + name; }
+static std::string Temp(const std::string& name) { return (g_temp / name).string(); }
+
+static bool Load(DataModel& model, const std::string& path, unsigned threads = 0) {
+    return LoadData(model, path, threads) && !model.people.empty();
+}
+
+static std::string ReadFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+static void WriteFile(const std::string& path, const std::string& text) {
+    std::ofstream(path, std::ios::binary) << text;
+}
+
+// Data orang (tanpa layout) harus sama persis, termasuk urutan, nomor baris, pasangan, dan anak
+static bool SameModel(const DataModel& a, const DataModel& b) {
+    if (a.people.size() != b.people.size() || a.childIds != b.childIds) return false;
+    for (size_t i = 0; i < a.people.size(); ++i) {
+        const Person& x = a.people[i];
+        const Person& y = b.people[i];
+        if (x.id != y.id || x.line != y.line || a.Text(x.name) != b.Text(y.name) || a.Text(x.role) != b.Text(y.role) ||
+            x.gender != y.gender || x.fatherId != y.fatherId || x.motherId != y.motherId ||
+            x.spouseCount != y.spouseCount || a.IndexOf(x.id) != b.IndexOf(y.id)) return false;
+        SpouseRange sx = a.Spouses(x), sy = b.Spouses(y);
+        for (size_t k = 0; k < sx.size(); ++k) {
+            if (sx.first[k].id != sy.first[k].id || sx.first[k].ex != sy.first[k].ex) return false;
+        }
+        ChildRange cx = a.Children(x.fatherId, x.motherId), cy = b.Children(x.fatherId, x.motherId);
+        if (cx.size() != cy.size() || !std::equal(cx.begin(), cx.end(), cy.begin())) return false;
+    }
+    return true;
+}
+
+// Posisi, kotak yang tergambar, ukuran canvas, dan semua garis penghubung harus sama persis
+static bool SameLayout(const DataModel& a, const DataModel& b) {
+    if (a.people.size() != b.people.size() || a.posX != b.posX || a.posY != b.posY || a.placed != b.placed ||
+        a.maxX != b.maxX || a.maxY != b.maxY || a.segmentStart != b.segmentStart || a.segments.size() != b.segments.size()) return false;
+    for (size_t i = 0; i < a.people.size(); ++i) {
+        if (a.people[i].id != b.people[i].id) return false;
+    }
+    for (size_t k = 0; k < a.segments.size(); ++k) {
+        const LineSegment& x = a.segments[k];
+        const LineSegment& y = b.segments[k];
+        if (x.x1 != y.x1 || x.y1 != y.y1 || x.x2 != y.x2 || x.y2 != y.y2 || x.dotted != y.dotted) return false;
+    }
+    return true;
+}
+
+// Layout di tempat harus sama dengan layout penuh yang baru dengan status ciut yang sama
+// (model tidak bisa disalin, jadi hasilnya disimpan dulu lalu layout penuh dijalankan ulang)
+static bool SameAsFullLayout(DataModel& model, unsigned threads = 0) {
+    std::vector<uint8_t> placed = model.placed;
+    std::vector<int> posX = model.posX, posY = model.posY;
+    size_t segments = model.segments.size();
+    int maxX = model.maxX, maxY = model.maxY;
+    RecalculateLayout(model, threads);
+    return placed == model.placed && posX == model.posX && posY == model.posY &&
+           segments == model.segments.size() && maxX == model.maxX && maxY == model.maxY;
+}
+
+static size_t DottedSegments(const DataModel& model) {
+    return (size_t)std::count_if(model.segments.begin(), model.segments.end(), [](const LineSegment& s) { return s.dotted; });
+}
+
+// Jumlah pasangan kotak bertumpuk di baris yang sama (harus 0 untuk layout mana pun)
+static size_t CountOverlaps(const DataModel& model) {
+    std::vector<uint32_t> order;
+    for (size_t i = 0; i < model.people.size(); ++i) {
+        if (model.placed[i]) order.push_back((uint32_t)i);
+    }
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return model.posY[a] != model.posY[b] ? model.posY[a] < model.posY[b] : model.posX[a] < model.posX[b];
+    });
+    size_t overlaps = 0;
+    for (size_t k = 1; k < order.size(); ++k) {
+        uint32_t a = order[k - 1], b = order[k];
+        if (model.posY[a] == model.posY[b] && model.posX[b] < model.posX[a] + BOX_WIDTH) overlaps++;
+    }
+    return overlaps;
+}
+
+// Salinan CSV dengan satu baris data diganti (indeks baris data, header tidak dihitung).
+// newLine kosong = baris dihapus, dataLine di luar data = newLine ditambahkan di akhir.
+static void WriteEdited(const std::string& src, const std::string& dst, size_t dataLine, const std::string& newLine) {
+    std::ifstream in(src);
+    std::ostringstream out;
+    std::string line;
+    size_t n = 0;
+    std::getline(in, line);
+    out << line << "\n";
+    while (std::getline(in, line)) {
+        if (n++ != dataLine) out << line << "\n";
+        else if (!newLine.empty()) out << newLine << "\n";
+    }
+    if (dataLine >= n) out << newLine << "\n";
+    WriteFile(dst, out.str());
+}
+
+// Data generator dengan opsi bawaan (deterministik, seed tetap), dibuat sekali per jalannya tes
+static std::string GeneratedCsv(const char* name, size_t people, int roots, bool unicode) {
+    std::string path = Temp(name);
+    if (!fs::exists(path)) {
+        GeneratorOptions opt;
+        opt.people = people;
+        opt.maxDepth = 30;
+        if (roots > 0) opt.roots = roots;
+        opt.unicodeNames = unicode;
+        GenerateFamilyCsv(path, opt);
+    }
+    return path;
+}
+
+// Generator 150 ribu orang: cukup besar untuk parsing paralel (>= 1 MB per thread), layout
+// paralel, dan validasi lebih dari satu potongan
+static std::string LargeCsv() { return GeneratedCsv("large.csv", 150000, 0, true); }
+// Arsip 50 keluarga akar (layout paralel membagi per keluarga akar)
+static std::string ForestCsv() { return GeneratedCsv("forest.csv", 30000, 50, false); }
+
+// -----------------------------------------------------------------------------
+// PARSING (Isi model dari fixture, format baris yang tidak biasa, dan parsing paralel)
+// -----------------------------------------------------------------------------
+static void TestParse() {
+    DataModel model;
+    CHECK(Load(model, Data("family.csv")));
+    CHECK_EQ(model.people.size(), (size_t)11);
+
+    const Person* budi = model.Get(1);
+    CHECK(budi && model.Text(budi->name) == "Budi" && model.Text(budi->role) == "Kakek" && budi->gender == Gender::Male);
+    CHECK(budi && budi->line == 2 && budi->spouseCount == 2);
+    if (budi && budi->spouseCount == 2) {
+        SpouseRange s = model.Spouses(*budi);
+        CHECK(s.first[0].id == 2 && !s.first[0].ex);
+        CHECK(s.first[1].id == 9 && s.first[1].ex);
+    }
+    const Person* jose = model.Get(10);
+    CHECK(jose && model.Text(jose->name) == "José" && jose->fatherId == 6 && jose->motherId == 11 && jose->line == 11);
+    const Person* anna = model.Get(11);
+    CHECK(anna && model.Text(anna->name) == "Anna Müller" && anna->gender == Gender::Female);
+    // Peran yang sama memakai nomor teks yang sama
+    CHECK(anna && model.Get(4) && anna->role == model.Get(4)->role);
+
+    ChildRange children = model.Children(1, 2);
+    CHECK(children.size() == 2 && children.first[0] == 3 && children.first[1] == 5);
+    ChildRange half = model.Children(1, 9);
+    CHECK(half.size() == 1 && half.first[0] == 8);
+    CHECK(model.Children(9, 1).empty());
+    CHECK_EQ(model.rootCandidates.size(), (size_t)5); // 1, 2, 4, 9, 11
+
+    // CRLF, baris kosong, kolom pasangan yang hilang, dan ID yang bukan angka (baris dilewati)
+    std::string crlf = Temp("crlf.csv");
+    WriteFile(crlf, "ID,Name,Role,Gender,FatherID,MotherID,SpouseID\r\n"
+                    "1,Budi,Kakek,M,0,0,2|9X\r\n"
+                    "\r\n"
+                    "abc,Salah,?,M,0,0,0\r\n"
+                    "2,Siti,Nenek,f,0,0,1\r\n"
+                    "3,Andi,Ayah,?,1,2\r\n");
+    DataModel odd;
+    CHECK(Load(odd, crlf));
+    CHECK_EQ(odd.people.size(), (size_t)3);
+    const Person* a = odd.Get(1);
+    CHECK(a && a->spouseCount == 2 && odd.Spouses(*a).first[1].id == 9 && odd.Spouses(*a).first[1].ex);
+    const Person* b = odd.Get(2);
+    CHECK(b && b->line == 5 && b->gender == Gender::Female && odd.Text(b->role) == "Nenek");
+    const Person* c = odd.Get(3);
+    CHECK(c && c->line == 6 && c->gender == Gender::Unknown && c->spouseCount == 0 && odd.Text(c->role) == "Ayah");
+
+    // Parsing paralel harus identik dengan serial
+    std::string large = LargeCsv();
+    DataModel serial;
+    CHECK(Load(serial, large, 1));
+    for (unsigned threads : { 2u, 4u, 8u }) {
+        DataModel parallel;
+        CHECK(Load(parallel, large, threads));
+        CHECK(SameModel(serial, parallel));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// LAYOUT (Posisi fixture, garis lurus panjang, layout paralel, ciut/buka, dan mode kompak)
+// -----------------------------------------------------------------------------
+static void TestLayout() {
+    DataModel model;
+    CHECK(Load(model, Data("family.csv")));
+    LayoutStats st = RecalculateLayout(model, 1);
+    CHECK_EQ(st.rootsPositioned, (size_t)1);
+
+    // Akar di x = 50; pasangan di kanan orangnya (BOX_WIDTH + 10), satu generasi = V_GAP ke bawah.
+    // Mantan istri (9) di kanan istri pertama, anaknya (8) di kanan anak-anak istri pertama.
+    struct Expect { int id, x, y; };
+    const Expect expected[] = {
+        { 1, 187, 50 }, { 2, 317, 50 }, { 9, 447, 50 },
+        { 3, 117, 130 }, { 4, 247, 130 }, { 5, 450, 130 }, { 8, 585, 130 },
+        { 6, 50, 210 }, { 11, 180, 210 }, { 7, 315, 210 },
+        { 10, 50, 290 },
+    };
+    for (const Expect& e : expected) {
+        size_t i = model.IndexOf(e.id);
+        CHECK(i != IdIndex::NPOS && model.placed[i]);
+        if (i == IdIndex::NPOS) continue;
+        CHECK_EQ(model.posX[i], e.x);
+        CHECK_EQ(model.posY[i], e.y);
+    }
+    CHECK_EQ(model.maxX, 755);
+    CHECK_EQ(model.maxY, 400);
+    CHECK_EQ(model.segments.size(), (size_t)16);
+    CHECK_EQ(DottedSegments(model), (size_t)1); // Garis ke mantan istri
+
+    // ID ganda: hanya baris terakhir yang menjadi akar, baris yang tertimpa (beserta pasangan dan
+    // anak yang hanya terhubung lewat baris itu) tidak ditempatkan. Layout paralel baru dipakai
+    // mulai PARALLEL_MIN_PEOPLE orang, jadi versi besarnya ditambah orang-orang tunggal.
+    const std::string duplicateRows = "ID,Name,Role,Gender,FatherID,MotherID,SpouseID\n"
+                                      "1,A,r,M,0,0,2\n2,B,r,F,0,0,1\n3,C,r,M,1,2,0\n1,A2,r,M,0,0,0\n5,D,r,M,0,0,0\n";
+    std::string filler;
+    for (int id = 100; id < 100 + 20000; ++id) filler += std::to_string(id) + ",P,r,M,0,0,0\n";
+    WriteFile(Temp("duplicate.csv"), duplicateRows);
+    WriteFile(Temp("duplicate_large.csv"), duplicateRows + filler);
+    for (LayoutMode mode : { LayoutMode::Classic, LayoutMode::Compact }) {
+        DataModel serial;
+        for (const char* name : { "duplicate.csv", "duplicate_large.csv" }) {
+            for (unsigned threads : { 1u, 4u }) {
+                DataModel dup;
+                CHECK(Load(dup, Temp(name)));
+                dup.layoutMode = mode;
+                LayoutStats ds = RecalculateLayout(dup, threads);
+                CHECK(!dup.placed[0] && !dup.placed[1] && !dup.placed[2]);
+                CHECK(dup.placed[3] && dup.posX[3] == 50 && dup.posY[3] == 50);
+                CHECK(dup.placed[4] && dup.posX[4] == 235 && dup.posY[4] == 50);
+                CHECK_EQ(CountOverlaps(dup), (size_t)0);
+                if (dup.people.size() == 5) {
+                    CHECK_EQ(ds.rootsPositioned, (size_t)2);
+                    CHECK(dup.maxX == 405 && dup.maxY == 160 && dup.segments.empty());
+                } else if (threads == 1) {
+                    serial = std::move(dup);
+                } else {
+                    CHECK(SameLayout(serial, dup));
+                }
+            }
+        }
+    }
+
+    // Satu garis keturunan panjang, dengan dan tanpa siklus (istri akar juga anak generasi terakhir)
+    const int generations = 5000;
+    for (int cycle = 0; cycle <= 1; ++cycle) {
+        std::ostringstream csv;
+        int wife = generations + 1;
+        csv << "ID,Name,Role,Gender,FatherID,MotherID,SpouseID\n1,Leluhur1,Eyang,M,0,0," << (cycle ? wife : 0) << "\n";
+        for (int id = 2; id <= generations; ++id) {
+            csv << id << ",Nama" << id << ",Anak,M," << (id - 1) << "," << ((cycle && id == 2) ? wife : 0) << ",0\n";
+        }
+        if (cycle) csv << wife << ",Istri" << wife << ",Eyang,F," << generations << ",0,1\n";
+        std::string path = Temp(cycle ? "chain_cycle.csv" : "chain.csv");
+        WriteFile(path, csv.str());
+        DataModel chain;
+        CHECK(Load(chain, path));
+        LayoutStats cs = RecalculateLayout(chain);
+        size_t last = chain.IndexOf(generations);
+        CHECK(last != IdIndex::NPOS && chain.placed[last]);
+        if (last != IdIndex::NPOS) CHECK_EQ(chain.posY[last], 50 + (generations - 1) * V_GAP);
+        CHECK_EQ(cs.cyclesIgnored, (size_t)cycle);
+    }
+
+    // Layout paralel harus identik dengan serial, untuk kedua mode
+    for (LayoutMode mode : { LayoutMode::Classic, LayoutMode::Compact }) {
+        DataModel serial;
+        CHECK(Load(serial, ForestCsv()));
+        serial.layoutMode = mode;
+        RecalculateLayout(serial, 1);
+        CHECK_EQ(CountOverlaps(serial), (size_t)0);
+        for (unsigned threads : { 2u, 4u, 8u }) {
+            DataModel parallel;
+            CHECK(Load(parallel, ForestCsv()));
+            parallel.layoutMode = mode;
+            RecalculateLayout(parallel, threads);
+            CHECK(SameLayout(serial, parallel));
+            if (mode == LayoutMode::Classic) CHECK(serial.subtreeWidth == parallel.subtreeWidth);
+        }
+    }
+}
+
+static void TestCollapse() {
+    for (LayoutMode mode : { LayoutMode::Classic, LayoutMode::Compact }) {
+        DataModel model, classic;
+        CHECK(Load(model, LargeCsv()));
+        CHECK(Load(classic, LargeCsv()));
+        model.layoutMode = mode;
+        RecalculateLayout(model);
+        RecalculateLayout(classic);
+        std::vector<int> expandedX = model.posX;
+        CHECK_EQ(CountOverlaps(model), (size_t)0);
+        CHECK(model.placed == classic.placed); // Mode kompak hanya mengubah posisi
+
+        SetAllCollapsed(model, true);
+        for (size_t i = 0; i < model.people.size(); ++i) {
+            // Yang tergambar hanya keluarga akar (orang tanpa orang tua dan pasangannya)
+            if (model.placed[i]) CHECK(model.fatherIndex[i] == DataModel::NO_INDEX && model.motherIndex[i] == DataModel::NO_INDEX);
+        }
+
+        // Buka leluhur orang terakhir dari akar ke bawah, seperti pengguna mengklik satu cabang
+        // (data generator paling dalam 30 generasi)
+        std::vector<int> chain;
+        for (size_t i = model.people.size() - 1;;) {
+            chain.push_back(model.people[i].id);
+            uint32_t f = model.fatherIndex[i], m = model.motherIndex[i];
+            bool fatherUp = f != DataModel::NO_INDEX && (model.fatherIndex[f] != DataModel::NO_INDEX || m == DataModel::NO_INDEX);
+            uint32_t up = fatherUp ? f : m;
+            if (up == DataModel::NO_INDEX) break;
+            i = up;
+        }
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            SetCollapsed(model, *it, false);
+            if ((it - chain.rbegin()) % 8 == 0 || it + 1 == chain.rend()) CHECK(SameAsFullLayout(model));
+        }
+        size_t last = model.IndexOf(chain.front());
+        CHECK(last != IdIndex::NPOS && model.placed[last]);
+
+        // Buka semua harus kembali ke posisi awal; ciut satu orang lalu buka lagi juga
+        SetAllCollapsed(model, false);
+        CHECK(model.posX == expandedX);
+        int mid = model.people[model.people.size() / 2].id;
+        SetCollapsed(model, mid, true);
+        CHECK(SameAsFullLayout(model));
+        SetCollapsed(model, mid, false);
+        CHECK(model.posX == expandedX);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// RELOAD (Perubahan satu baris fixture harus sama dengan load + layout penuh)
+// -----------------------------------------------------------------------------
+static void TestReload() {
+    const std::string source = Data("family.csv");
+    const std::string work = Temp("reload.csv");
+    struct Edit {
+        const char* name;
+        size_t dataLine;       // Baris data yang diganti (11 = tambah baris baru)
+        std::string line;      // Kosong = baris dihapus
+        bool needsLayout;
+        size_t added, removed, modified;
+    };
+    const Edit edits[] = {
+        { "role", 4, "5,Dewi,Tante,F,1,2,0", false, 0, 0, 1 },
+        { "name", 9, "10,Jose Maria,Cicit,M,6,11,0", false, 0, 0, 1 },
+        { "divorce", 2, "3,Andi,Ayah,M,1,2,4x", false, 0, 0, 1 },
+        { "parent", 7, "8,Joko,Paman,M,1,2,0", true, 0, 0, 1 },
+        { "add", 11, "12,Gita,Cucu,F,3,4,0", true, 1, 0, 0 },
+        { "remove", 4, "", true, 0, 1, 0 },
+    };
+    for (const Edit& e : edits) {
+        fs::copy_file(source, work, fs::copy_options::overwrite_existing);
+        DataModel live;
+        CHECK(Load(live, work));
+        RecalculateLayout(live);
+        size_t dotted = DottedSegments(live);
+
+        WriteEdited(source, work, e.dataLine, e.line);
+        fs::last_write_time(work, live.lastWriteTime + std::chrono::seconds(1));
+        ReloadResult r = ReloadData(live, work);
+        ApplyReload(live, r);
+
+        DataModel full;
+        CHECK(Load(full, work));
+        RecalculateLayout(full);
+        if (!r.changed || r.fullReload || r.needsLayout != e.needsLayout || r.added != e.added ||
+            r.removed != e.removed || r.modified != e.modified) {
+            Fail(__LINE__, "ReloadResult");
+            std::cout << "       edit=" << e.name << " changed=" << r.changed << " full=" << r.fullReload
+                      << " needsLayout=" << r.needsLayout << " added=" << r.added << " removed=" << r.removed
+                      << " modified=" << r.modified << "\n";
+        }
+        CHECK(SameModel(live, full));
+        CHECK(SameLayout(live, full));
+        // Tanda cerai hanya mengubah garis menjadi putus-putus
+        if (std::string(e.name) == "divorce") CHECK_EQ(DottedSegments(live), dotted + 1);
+    }
+
+    // Waktu modifikasi berubah tetapi isi sama: tidak ada yang berubah
+    fs::copy_file(source, work, fs::copy_options::overwrite_existing);
+    DataModel live;
+    CHECK(Load(live, work));
+    RecalculateLayout(live);
+    fs::last_write_time(work, live.lastWriteTime + std::chrono::seconds(1));
+    ReloadResult same = ReloadData(live, work);
+    CHECK(!same.needsLayout && same.added == 0 && same.removed == 0 && same.modified == 0);
+    fs::remove(work);
+}
+
+// -----------------------------------------------------------------------------
+// SNAPSHOT (Simpan/muat ulang harus identik; snapshot rusak ditolak)
+// -----------------------------------------------------------------------------
+static void TestSnapshot() {
+    std::string path = Temp("snapshot.csv");
+    fs::copy_file(LargeCsv(), path, fs::copy_options::overwrite_existing);
+    std::string snap = SnapshotPath(path);
+    fs::remove(snap);
+
+    DataModel parsed;
+    CHECK(Load(parsed, path));
+    RecalculateLayout(parsed);
+    CHECK(SaveSnapshot(parsed, path));
+
+    DataModel loaded;
+    bool hasLayout = false;
+    CHECK(LoadSnapshot(loaded, path, hasLayout));
+    CHECK(hasLayout);
+    CHECK(SameModel(parsed, loaded));
+    CHECK(SameLayout(parsed, loaded));
+
+    // Nomor teks nama orang pertama di luar jangkauan (header snapshot 136 byte, lalu array Person)
+    std::string bytes = ReadFile(snap);
+    std::string corrupt = bytes;
+    const size_t HEADER_BYTES = 136;
+    for (size_t k = 0; k < sizeof(uint32_t); ++k) corrupt[HEADER_BYTES + offsetof(Person, name) + k] = (char)0xFF;
+    WriteFile(snap, corrupt);
+    DataModel rejected;
+    CHECK(!LoadSnapshot(rejected, path, hasLayout));
+
+    // Snapshot terpotong juga ditolak
+    WriteFile(snap, bytes.substr(0, bytes.size() / 2));
+    CHECK(!LoadSnapshot(rejected, path, hasLayout));
+
+    // CSV berubah: snapshot lama tidak dipakai
+    WriteFile(snap, bytes);
+    CHECK(LoadSnapshot(rejected, path, hasLayout));
+    WriteEdited(path, path, 0, "1,Baru,Eyang,M,0,0,0");
+    fs::last_write_time(path, parsed.lastWriteTime + std::chrono::seconds(1));
+    DataModel stale;
+    CHECK(!LoadSnapshot(stale, path, hasLayout));
+    fs::remove(snap);
+}
+
+// -----------------------------------------------------------------------------
+// SCENE (Grid viewport dicek terhadap brute-force, zoom dicek terhadap gambar 1:1)
+// -----------------------------------------------------------------------------
+static bool Intersects(const Rect& a, const Rect& b) {
+    return !a.Empty() && a.left < b.right && b.left < a.right && a.top < b.bottom && b.top < a.bottom;
+}
+
+static void TestScene() {
+    DataModel model;
+    CHECK(Load(model, LargeCsv()));
+    RecalculateLayout(model);
+    SceneIndex scene;
+    BuildSceneIndex(model, scene);
+
+    std::mt19937 rng(7);
+    std::vector<uint32_t> visible, lines;
+    for (int q = 0; q < 20; ++q) {
+        size_t p = rng() % model.people.size();
+        Rect view = { model.posX[p] - 512, model.posY[p] - 384, model.posX[p] + 512, model.posY[p] + 384 };
+        scene.boxes.Query(view, visible);
+        scene.connectors.Query(view, lines);
+        std::vector<uint32_t> expect, expectLines;
+        for (uint32_t i = 0; i < model.people.size(); ++i) {
+            if (Intersects(BoxBounds(model, i), view)) expect.push_back(i);
+            if (Intersects(ConnectorBounds(model, i), view)) expectLines.push_back(i);
+        }
+        CHECK(!visible.empty() && visible == expect);
+        CHECK(lines == expectLines);
+    }
+
+    // Piramida ringkasan: setiap level memuat semua orang, dan kotak setiap orang (sampel)
+    // tertutup satu blok di barisnya
+    std::vector<uint32_t> placed;
+    for (uint32_t i = 0; i < model.people.size(); ++i) if (model.placed[i]) placed.push_back(i);
+    scene.overview.Build(model, placed);
+    CHECK(scene.overview.Levels() > 0);
+    std::vector<OverviewBlock> blocks;
+    for (int level = 0; level < scene.overview.Levels(); ++level) {
+        scene.overview.Query(level, { INT32_MIN / 2, INT32_MIN / 2, INT32_MAX / 2, INT32_MAX / 2 }, blocks);
+        uint64_t people = 0;
+        for (const OverviewBlock& b : blocks) people += b.people;
+        CHECK_EQ(people, (uint64_t)placed.size());
+        CHECK_EQ(blocks.size(), scene.overview.BlockCount(level));
+        for (size_t k = 0; k < placed.size(); k += placed.size() / 50) {
+            uint32_t i = placed[k];
+            Rect box = { model.posX[i], model.posY[i], model.posX[i] + BOX_WIDTH, model.posY[i] + BOX_HEIGHT };
+            scene.overview.Query(level, box, blocks);
+            bool covered = false;
+            for (const OverviewBlock& b : blocks) {
+                covered = covered || (b.rect.left <= box.left && box.right <= b.rect.right && b.rect.top == box.top);
+            }
+            CHECK(covered);
+        }
+    }
+
+    // Skala 1 harus sama persis dengan RenderArea (gambar 1:1 tanpa zoom)
+    const int FRAME_W = 1024, FRAME_H = 768;
+    std::vector<uint8_t> rgb, expect;
+    size_t mid = placed[placed.size() / 2];
+    int cx = model.posX[mid], cy = model.posY[mid];
+    size_t drawn = RenderView(model, scene, cx - FRAME_W / 2, cy - FRAME_H / 2, 1.0, FRAME_W, FRAME_H, rgb);
+    RenderArea(model, scene, { cx - FRAME_W / 2, cy - FRAME_H / 2, cx + FRAME_W / 2, cy + FRAME_H / 2 }, expect);
+    CHECK(drawn > 0);
+    CHECK(rgb == expect);
+}
+
+// -----------------------------------------------------------------------------
+// PEDIGREE (Nama hubungan fixture, jalur cepat dicek terhadap penelusuran leluhur)
+// -----------------------------------------------------------------------------
+static bool SameRelationship(const Relationship& a, const Relationship& b) {
+    return a.related == b.related && a.up == b.up && a.down == b.down && a.half == b.half;
+}
+
+static void TestPedigree() {
+    DataModel model;
+    CHECK(Load(model, Data("family.csv")));
+    PedigreeIndex pedigree;
+    pedigree.Build(model);
+    struct Expect { int a, b; const char* name; };
+    const Expect expected[] = {
+        { 6, 5, "nephew" }, { 8, 3, "half-brother" }, { 10, 1, "great-grandson" }, { 6, 7, "brother" },
+        { 6, 8, "half-nephew" }, { 7, 10, "aunt" }, { 5, 8, "half-sister" }, { 10, 11, "son" },
+        { 1, 9, "ex-husband" }, { 3, 4, "husband" }, { 4, 1, "not related" }, { 2, 9, "not related" },
+    };
+    for (const Expect& e : expected) {
+        std::string name = DescribeRelationship(model, pedigree, model.IndexOf(e.a), model.IndexOf(e.b));
+        if (name != e.name) {
+            Fail(__LINE__, "DescribeRelationship");
+            std::cout << "       " << e.a << " -> " << e.b << ": got " << name << ", expected " << e.name << "\n";
+        }
+    }
+    Relationship r = pedigree.Relate(model.IndexOf(6), model.IndexOf(8));
+    CHECK(r.related && r.up == 2 && r.down == 1 && r.half);
+    CHECK_EQ(pedigree.Generation(model.IndexOf(10)), 3);
+    std::vector<Relative> ancestors = pedigree.Ancestors(model.IndexOf(10));
+    CHECK_EQ(ancestors.size(), (size_t)6); // 6, 11, 3, 4, 1, 2
+    std::vector<Relative> descendants = pedigree.Descendants(model.IndexOf(1), 1);
+    CHECK_EQ(descendants.size(), (size_t)3); // 3, 5, 8
+
+    // Data generator: jalur cepat dan batch paralel harus sama dengan penelusuran leluhur
+    DataModel large;
+    CHECK(Load(large, LargeCsv()));
+    PedigreeIndex index;
+    index.Build(large);
+    size_t n = large.people.size();
+    std::mt19937 rng(777);
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (size_t k = 0; k < 20000; ++k) {
+        uint32_t a = (uint32_t)(rng() % n), b = (uint32_t)(rng() % n);
+        if (k % 2) {
+            // Kerabat dekat: naik 1-4 generasi lewat orang tua acak lalu turun 1-4 generasi
+            b = a;
+            for (int up = 1 + (int)(rng() % 4); up > 0; --up) {
+                uint32_t p = (rng() % 2) ? index.Father(b) : index.Mother(b);
+                if (p == DataModel::NO_INDEX) p = (index.Father(b) != DataModel::NO_INDEX) ? index.Father(b) : index.Mother(b);
+                if (p == DataModel::NO_INDEX) break;
+                b = p;
+            }
+            for (int down = 1 + (int)(rng() % 4); down > 0; --down) {
+                std::vector<Relative> kids = index.Descendants(b, 1);
+                if (kids.empty()) break;
+                b = kids[rng() % kids.size()].index;
+            }
+        }
+        pairs.push_back({ a, b });
+    }
+    size_t mismatches = 0, related = 0;
+    std::vector<Relationship> serial(pairs.size());
+    for (size_t k = 0; k < pairs.size(); ++k) {
+        serial[k] = index.Relate(pairs[k].first, pairs[k].second);
+        mismatches += !SameRelationship(serial[k], index.RelateExact(pairs[k].first, pairs[k].second));
+        related += serial[k].related;
+    }
+    CHECK_EQ(mismatches, (size_t)0);
+    CHECK(related > pairs.size() / 4);
+    std::vector<Relationship> batch;
+    index.RelateBatch(pairs, batch, 4);
+    size_t batchMismatches = 0;
+    for (size_t k = 0; k < pairs.size(); ++k) batchMismatches += !SameRelationship(batch[k], serial[k]);
+    CHECK_EQ(batchMismatches, (size_t)0);
+}
+
+// -----------------------------------------------------------------------------
+// SEARCH (Hasil fixture dengan diakritik, data generator dicek terhadap pemindaian semua nama)
+// -----------------------------------------------------------------------------
+static void TestSearch() {
+    DataModel model;
+    CHECK(Load(model, Data("family.csv")));
+    SearchIndex index;
+    index.Build(model);
+    std::vector<SearchHit> hits;
+    SearchOptions opt;
+
+    CHECK_EQ(index.Find(model, "jose", opt, hits), (size_t)1);
+    CHECK(hits.size() == 1 && model.people[hits[0].index].id == 10 && hits[0].field == SEARCH_NAME && hits[0].rank == 0);
+    CHECK_EQ(index.Find(model, "MULLER", opt, hits), (size_t)1);
+    CHECK(hits.size() == 1 && model.people[hits[0].index].id == 11 && hits[0].rank == 2);
+    CHECK_EQ(index.Find(model, "menantu", opt, hits), (size_t)2);
+    CHECK(hits.size() == 2 && hits[0].field == SEARCH_ROLE && model.people[hits[0].index].id == 4 &&
+          model.people[hits[1].index].id == 11);
+    CHECK_EQ(index.Find(model, "ull", opt, hits), (size_t)1);
+    opt.mode = SearchMode::Prefix;
+    CHECK_EQ(index.Find(model, "ull", opt, hits), (size_t)0);
+    CHECK_EQ(index.Find(model, "mül", opt, hits), (size_t)1);
+    opt.ignoreDiacritics = false;
+    CHECK_EQ(index.Find(model, "mul", opt, hits), (size_t)0);
+    CHECK_EQ(FoldText("José Müller"), std::string("jose muller"));
+
+    // Data generator dengan nama Unicode: potongan nama sungguhan dicek terhadap pemindaian linear
+    DataModel large;
+    CHECK(Load(large, LargeCsv()));
+    SearchIndex big;
+    big.Build(large, 4);
+    size_t n = large.people.size();
+    std::vector<std::string> folded(n), foldedRole(n);
+    for (size_t i = 0; i < n; ++i) {
+        folded[i] = FoldText(large.Text(large.people[i].name));
+        foldedRole[i] = FoldText(large.Text(large.people[i].role));
+    }
+    std::mt19937 rng(4242);
+    SearchOptions sub;
+    sub.limit = 20;
+    size_t mismatches = 0;
+    for (int k = 0; k < 50; ++k) {
+        std::string name(large.Text(large.people[rng() % n].name));
+        size_t len = std::min(name.size(), (size_t)(3 + rng() % 6));
+        std::string query = name.substr(rng() % (name.size() - len + 1), len);
+        query.erase(0, query.find_first_not_of(' ')); // Find membuang spasi di awal/akhir query
+        query.erase(query.find_last_not_of(' ') + 1);
+        if (query.empty()) continue;
+        std::string q = FoldText(query);
+        size_t expected = 0;
+        for (size_t i = 0; i < n; ++i) expected += folded[i].find(q) != std::string::npos || foldedRole[i].find(q) != std::string::npos;
+        size_t total = big.Find(large, query, sub, hits);
+        bool ok = total == expected && hits.size() == std::min(expected, sub.limit);
+        for (const SearchHit& h : hits) {
+            const std::string& text = (h.field == SEARCH_NAME) ? folded[h.index] : foldedRole[h.index];
+            ok = ok && text.find(q) != std::string::npos;
+        }
+        mismatches += !ok;
+    }
+    CHECK_EQ(mismatches, (size_t)0);
+}
+
+// -----------------------------------------------------------------------------
+// GEDCOM (Ekspor lalu baca kembali harus sama dengan CSV, ekspor ulang sama persis)
+// -----------------------------------------------------------------------------
+// Pasangan seluruh model sebagai (ID kecil, ID besar, cerai) tanpa arah. GEDCOM menyimpan pasangan
+// per FAM, jadi pasangan yang hanya dicatat satu pihak di CSV, atau orang tua dari anak yang sama,
+// menjadi pasangan bagi keduanya setelah dibaca kembali.
+static std::vector<std::pair<long long, bool>> Couples(const DataModel& model) {
+    std::vector<std::pair<long long, bool>> couples;
+    auto add = [&](int a, int b, bool ex) {
+        if (a == b || !model.Get(a) || !model.Get(b)) return;
+        if (a > b) std::swap(a, b);
+        couples.emplace_back(DataModel::ParentKey(a, b), ex);
+    };
+    for (const Person& p : model.people) {
+        for (const SpouseLink& s : model.Spouses(p)) add(p.id, s.id, s.ex);
+        add(p.fatherId, p.motherId, false);
+    }
+    std::sort(couples.begin(), couples.end());
+    size_t out = 0;
+    for (size_t i = 0; i < couples.size(); ++i) {
+        if (out > 0 && couples[out - 1].first == couples[i].first) couples[out - 1].second = couples[out - 1].second || couples[i].second;
+        else couples[out++] = couples[i];
+    }
+    couples.resize(out);
+    return couples;
+}
+
+static void TestGedcom() {
+    for (const std::string& csvPath : { Data("family.csv"), LargeCsv() }) {
+        std::string gedPath = Temp("roundtrip.ged"), againPath = Temp("roundtrip_again.ged");
+        DataModel csv, ged, again;
+        CHECK(Load(csv, csvPath));
+        CHECK(ExportGedcom(csv, gedPath));
+        CHECK(IsGedcomPath(gedPath));
+        CHECK(Load(ged, gedPath));
+        CHECK(ExportGedcom(ged, againPath));
+
+        CHECK_EQ(ged.people.size(), csv.people.size());
+        size_t different = 0;
+        for (size_t i = 0; i < std::min(csv.people.size(), ged.people.size()); ++i) {
+            const Person& x = csv.people[i];
+            const Person& y = ged.people[i];
+            different += !(x.id == y.id && csv.Text(x.name) == ged.Text(y.name) && csv.Text(x.role) == ged.Text(y.role) &&
+                           x.gender == y.gender && x.fatherId == y.fatherId && x.motherId == y.motherId);
+        }
+        CHECK_EQ(different, (size_t)0);
+        CHECK(Couples(csv) == Couples(ged));
+        CHECK(ReadFile(gedPath) == ReadFile(againPath));
+        fs::remove(gedPath);
+        fs::remove(againPath);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// VALIDATOR (Masalah fixture lengkap dengan nomor baris, hasil sama untuk berapa pun thread)
+// -----------------------------------------------------------------------------
+static bool SameIssues(const ValidationReport& a, const ValidationReport& b) {
+    if (a.issues.size() != b.issues.size() || a.unreachable != b.unreachable) return false;
+    for (size_t k = 0; k < a.issues.size(); ++k) {
+        const ValidationIssue& x = a.issues[k];
+        const ValidationIssue& y = b.issues[k];
+        if (x.kind != y.kind || x.index != y.index || x.line != y.line || x.otherId != y.otherId ||
+            x.otherLine != y.otherLine || x.count != y.count) return false;
+    }
+    return true;
+}
+
+// Salinan data generator dengan kesalahan yang sengaja dibuat di beberapa tempat yang berjauhan
+static std::string BrokenCsv() {
+    std::string path = Temp("broken_large.csv");
+    std::ifstream in(LargeCsv());
+    std::string header, line;
+    std::getline(in, header);
+    std::vector<std::vector<std::string>> table;
+    while (std::getline(in, line)) {
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        for (std::string item; std::getline(ss, item, ',');) fields.push_back(item);
+        fields.resize(7);
+        table.push_back(fields);
+    }
+    size_t n = table.size();
+    table[n / 4][4] = "2000000000";        // Ayah yang tidak ada
+    table[n / 2][0] = table[n / 2 - 1][0]; // ID ganda
+    table[n - 1][6] += "|1";               // Pasangan sepihak
+    std::ostringstream out;
+    out << header << "\n";
+    for (const auto& fields : table) {
+        for (size_t f = 0; f < fields.size(); ++f) out << (f ? "," : "") << fields[f];
+        out << "\n";
+    }
+    WriteFile(path, out.str());
+    return path;
+}
+
+static void TestValidator() {
+    DataModel model;
+    CHECK(Load(model, Data("broken.csv")));
+    struct Expect { IssueKind kind; int line, otherId, otherLine; size_t count; };
+    const Expect expected[] = {
+        { IssueKind::DuplicateId, 4, 3, 12, 0 },     // Baris 12 memakai ID 3 lagi (baris terakhir yang dipakai)
+        { IssueKind::OneSidedEx, 4, 4, 5, 0 },       // 3 menandai 4 sebagai mantan, 4 tidak
+        { IssueKind::Unreachable, 4, 0, 0, 1 },
+        { IssueKind::OneSidedSpouse, 5, 3, 12, 0 },  // ID 3 yang dipakai (baris 12) tidak punya pasangan
+        { IssueKind::Unreachable, 5, 0, 0, 1 },
+        { IssueKind::OneSidedSpouse, 6, 6, 7, 0 },
+        { IssueKind::MissingFather, 8, 77, 0, 0 },
+        { IssueKind::Unreachable, 8, 0, 0, 1 },
+        { IssueKind::MissingMother, 9, 88, 0, 0 },
+        { IssueKind::SelfSpouse, 9, 8, 0, 0 },
+        { IssueKind::Unreachable, 9, 0, 0, 1 },
+        { IssueKind::MissingSpouse, 10, 99, 0, 0 },
+        { IssueKind::FatherFemale, 10, 2, 3, 0 },
+        { IssueKind::MotherMale, 10, 1, 2, 0 },
+        { IssueKind::Unreachable, 10, 0, 0, 1 },
+        { IssueKind::MotherMale, 11, 1, 2, 0 },
+        { IssueKind::SameParent, 11, 1, 2, 0 },
+        { IssueKind::Unreachable, 11, 0, 0, 1 },
+        { IssueKind::AncestryCycle, 13, 21, 14, 2 }, // 20 <-> 21, dilaporkan sekali
+    };
+    for (unsigned threads : { 1u, 4u }) {
+        ValidationReport report = ValidateModel(model, threads);
+        CHECK(!report.Ok());
+        CHECK_EQ(report.people, (size_t)13); // Baris ID ganda tetap ada di model
+        CHECK_EQ(report.unreachable, (size_t)8); // 6 baris unreachable + 2 orang di siklus
+        CHECK_EQ(report.issues.size(), std::size(expected));
+        for (size_t k = 0; k < std::min(report.issues.size(), std::size(expected)); ++k) {
+            const ValidationIssue& got = report.issues[k];
+            const Expect& e = expected[k];
+            if (got.kind != e.kind || got.line != e.line || got.otherId != e.otherId || got.otherLine != e.otherLine ||
+                got.count != e.count) {
+                Fail(__LINE__, "ValidationIssue");
+                std::cout << "       #" << k << " got " << IssueKindName(got.kind) << " line=" << got.line << " other="
+                          << got.otherId << "/" << got.otherLine << " count=" << got.count << ", expected "
+                          << IssueKindName(e.kind) << " line=" << e.line << "\n";
+            }
+        }
+    }
+
+    DataModel family;
+    CHECK(Load(family, Data("family.csv")));
+    CHECK(ValidateModel(family).Ok());
+
+    // Baris ID ganda yang tertimpa tidak digambar layout, begitu pula pasangan dan anaknya
+    DataModel dup;
+    WriteFile(Temp("duplicate_validate.csv"), "ID,Name,Role,Gender,FatherID,MotherID,SpouseID\n"
+                                              "1,A,r,M,0,0,2\n2,B,r,F,0,0,1\n3,C,r,M,1,2,0\n1,A2,r,M,0,0,0\n5,D,r,M,0,0,0\n");
+    CHECK(Load(dup, Temp("duplicate_validate.csv")));
+    ValidationReport dupReport = ValidateModel(dup);
+    CHECK_EQ(dupReport.unreachable, (size_t)3);
+    CHECK_EQ(dupReport.counts[(size_t)IssueKind::DuplicateId], (size_t)1);
+    RecalculateLayout(dup);
+    size_t drawn = 0;
+    for (size_t i = 0; i < dup.people.size(); ++i) drawn += dup.placed[i] ? 1 : 0;
+    CHECK_EQ(drawn + dupReport.unreachable, dup.people.size());
+
+    // Data besar (beberapa potongan per thread): hasil harus sama untuk 1..8 thread
+    DataModel broken;
+    CHECK(Load(broken, BrokenCsv()));
+    ValidationReport serial = ValidateModel(broken, 1);
+    CHECK(serial.counts[(size_t)IssueKind::DuplicateId] == 1 && serial.counts[(size_t)IssueKind::MissingFather] >= 1 &&
+          serial.counts[(size_t)IssueKind::OneSidedSpouse] >= 1);
+    for (unsigned threads : { 2u, 4u, 8u }) CHECK(SameIssues(serial, ValidateModel(broken, threads)));
+}
+
+// -----------------------------------------------------------------------------
+// KINSHIP (Koefisien keluarga kecil yang dihitung dengan tangan, data generator dicek terhadap
+// metode tabel, hasil sama untuk berapa pun thread)
+// -----------------------------------------------------------------------------
+// Referensi metode tabel: matriks phi lengkap n x n dalam urutan (generasi, indeks), hanya untuk data kecil
+static std::vector<double> TabularKinship(const PedigreeIndex& pedigree) {
+    size_t n = pedigree.Size();
+    std::vector<uint32_t> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = (uint32_t)i;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return pedigree.Generation(a) != pedigree.Generation(b) ? pedigree.Generation(a) < pedigree.Generation(b) : a < b;
+    });
+    std::vector<double> phi(n * n, 0.0);
+    auto at = [&](uint32_t a, uint32_t b) { return (a == DataModel::NO_INDEX || b == DataModel::NO_INDEX) ? 0.0 : phi[(size_t)a * n + b]; };
+    for (size_t k = 0; k < n; ++k) {
+        uint32_t x = order[k], f = pedigree.Father(x), m = pedigree.Mother(x);
+        phi[(size_t)x * n + x] = 0.5 * (1.0 + at(f, m));
+        for (size_t j = 0; j < k; ++j) {
+            uint32_t y = order[j];
+            double v = 0.5 * (at(f, y) + at(m, y));
+            phi[(size_t)x * n + y] = v;
+            phi[(size_t)y * n + x] = v;
+        }
+    }
+    return phi;
+}
+
+static void TestKinship() {
+    // Pernikahan saudara kandung (berulang), saudara tiri, sepupu, sepupu ganda, paman-keponakan, dan ibu-anak
+    DataModel model;
+    CHECK(Load(model, Data("kinship_family.csv")));
+    PedigreeIndex pedigree;
+    pedigree.Build(model);
+    KinshipIndex kinship;
+    kinship.Build(pedigree);
+    struct Expect { int a, b; double value; }; // b = 0: F(a)
+    const Expect expected[] = {
+        { 5, 0, 0.25 },     // Anak saudara kandung (3 x 4)
+        { 8, 0, 0.125 },    // Anak saudara tiri (7 x 4)
+        { 14, 0, 0.0625 },  // Anak sepupu (11 x 13)
+        { 15, 0, 0.375 },   // Ibu x anaknya yang inbred (5 x 4)
+        { 16, 0, 0.125 },   // Paman x keponakan (3 x 13)
+        { 17, 0, 0.25 },
+        { 18, 0, 0.375 },   // Saudara kandung yang keduanya inbred (5 x 17)
+        { 31, 0, 0.125 },   // Sepupu ganda (29 x 30)
+        { 3, 0, 0 }, { 13, 0, 0 }, { 29, 0, 0 },
+        { 3, 4, 0.25 }, { 3, 3, 0.5 }, { 5, 5, 0.625 }, { 3, 7, 0.125 }, { 11, 13, 0.0625 }, { 1, 5, 0.25 },
+        { 5, 4, 0.375 }, { 29, 30, 0.125 }, { 1, 2, 0 }, { 1, 6, 0 }, { 6, 29, 0 }, { 14, 31, 0.078125 },
+    };
+    size_t inbred = 0;
+    for (const Expect& e : expected) {
+        size_t a = model.IndexOf(e.a), b = e.b ? model.IndexOf(e.b) : 0;
+        double got = e.b ? kinship.Kinship(a, b) : kinship.Inbreeding(a);
+        if (std::fabs(got - e.value) > 1e-12) {
+            Fail(__LINE__, "kinship");
+            std::cout << "       " << (e.b ? "phi(" : "F(") << e.a << (e.b ? "," + std::to_string(e.b) : "") << ") = " << got
+                      << ", expected " << e.value << "\n";
+        }
+        inbred += (e.b == 0 && e.value > 0);
+    }
+    CHECK_EQ(kinship.Stats().inbred, inbred);
+    CHECK_EQ(kinship.Stats().bothParents, (size_t)18);
+    CHECK_EQ(kinship.Stats().maxInbreeding, 0.375);
+
+    // Data generator kecil dengan banyak pernikahan sepupu: semua pasangan dicek terhadap metode tabel
+    std::string path = Temp("consanguineous.csv");
+    GeneratorOptions opt;
+    opt.people = 2000;
+    opt.maxDepth = 30;
+    opt.consanguinityRate = 0.3;
+    GenerateFamilyCsv(path, opt);
+    DataModel small;
+    CHECK(Load(small, path));
+    PedigreeIndex smallPedigree;
+    smallPedigree.Build(small);
+    KinshipIndex smallKinship;
+    smallKinship.Build(smallPedigree, 4);
+    std::vector<double> reference = TabularKinship(smallPedigree);
+    size_t n = small.people.size();
+    std::vector<uint32_t> everyone(n);
+    for (size_t i = 0; i < n; ++i) everyone[i] = (uint32_t)i;
+    std::vector<double> matrix;
+    smallKinship.KinshipMatrix(everyone, matrix, 4);
+    size_t mismatches = 0;
+    for (size_t k = 0; k < n * n; ++k) mismatches += std::fabs(matrix[k] - reference[k]) > 1e-12;
+    for (size_t i = 0; i < n; ++i) mismatches += std::fabs(smallKinship.Inbreeding(i) - (2 * reference[i * n + i] - 1)) > 1e-12;
+    CHECK_EQ(mismatches, (size_t)0);
+    CHECK(smallKinship.Stats().inbred > 0);
+
+    // Data besar (generasi yang dibagi ke beberapa thread): F, batch, dan sub-matriks identik untuk 1..8 thread
+    DataModel large;
+    opt.people = 150000;
+    opt.consanguinityRate = 0.02;
+    GenerateFamilyCsv(path, opt);
+    CHECK(Load(large, path));
+    PedigreeIndex largePedigree;
+    largePedigree.Build(large);
+    KinshipIndex serial, parallel;
+    serial.Build(largePedigree, 1);
+    CHECK(serial.Stats().inbred > 0);
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    std::vector<uint32_t> group;
+    std::mt19937 rng(99);
+    for (size_t i = 0; i < large.people.size(); ++i) {
+        if (serial.Inbreeding(i) > 0 && group.size() < 300) group.push_back((uint32_t)i);
+        // Orang tua seseorang yang inbred pasti berkerabat; pasangan lain acak
+        if (serial.Inbreeding(i) > 0) pairs.push_back({ largePedigree.Father(i), largePedigree.Mother(i) });
+        if (i % 8 == 0) pairs.push_back({ (uint32_t)(rng() % large.people.size()), (uint32_t)i });
+    }
+    std::vector<double> first, firstMatrix;
+    serial.KinshipBatch(pairs, first, 1);
+    serial.KinshipMatrix(group, firstMatrix, 1);
+    for (unsigned threads : { 2u, 4u, 8u }) {
+        parallel.Build(largePedigree, threads);
+        size_t different = 0;
+        for (size_t i = 0; i < large.people.size(); ++i) different += parallel.Inbreeding(i) != serial.Inbreeding(i);
+        CHECK_EQ(different, (size_t)0);
+        std::vector<double> out, outMatrix;
+        parallel.KinshipBatch(pairs, out, threads);
+        CHECK(out == first);
+        parallel.KinshipMatrix(group, outMatrix, threads);
+        CHECK(outMatrix == firstMatrix);
+    }
+    // Sub-matriks harus sama dengan kueri satu per satu, dan phi orang tua sama dengan F anaknya
+    size_t k = group.size(), matrixMismatches = 0;
+    for (size_t i = 0; i < k; ++i) {
+        for (size_t j = 0; j < k; j += 7) matrixMismatches += firstMatrix[i * k + j] != serial.Kinship(group[i], group[j]);
+        matrixMismatches += serial.Kinship(largePedigree.Father(group[i]), largePedigree.Mother(group[i])) != serial.Inbreeding(group[i]);
+    }
+    CHECK_EQ(matrixMismatches, (size_t)0);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) g_data = argv[1];
+    if (!fs::exists(Data("family.csv"))) {
+        std::cout << "[ERROR] Fixture not found: " << Data("family.csv") << " (run from the repository root or pass the data folder)\n";
+        return 1;
+    }
+    SetLogLevel(LogLevel::Quiet);
+    g_temp = fs::temp_directory_path() / "silsilah_tests";
+    fs::remove_all(g_temp);
+    fs::create_directories(g_temp);
+
+    struct Test { const char* name; void (*fn)(); };
+    const Test tests[] = {
+        { "parse", TestParse }, { "layout", TestLayout }, { "collapse", TestCollapse }, { "reload", TestReload },
+        { "snapshot", TestSnapshot }, { "scene", TestScene }, { "pedigree", TestPedigree }, { "kinship", TestKinship },
+        { "search", TestSearch },
+        { "gedcom", TestGedcom }, { "validator", TestValidator },
+    };
+    for (const Test& t : tests) {
+        int before = g_failures;
+        auto t0 = std::chrono::steady_clock::now();
+        t.fn();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << "[TEST] " << t.name << (g_failures == before ? " ok" : " FAILED") << " (" << ms << " ms)\n";
+    }
+    fs::remove_all(g_temp);
+    std::cout << "[TEST] " << (g_failures ? std::to_string(g_failures) + " check(s) failed" : std::string("all passed")) << "\n";
+    return g_failures ? 1 : 0;
+}
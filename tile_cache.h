@@ -0,0 +1,87 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// TILE CACHE (LRU untuk tile yang sudah digambar, per level zoom)
+// Tile yang dikeluarkan tidak dihapus: objeknya (mis. bitmap) langsung dipakai ulang untuk tile
+// berikutnya, jadi setelah cache penuh menggulir tidak mengalokasikan apa pun. Invalidate()
+// menandai semua tile harus digambar ulang (data/layout berubah) tanpa membuang objeknya.
+// -----------------------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+
+// Tile kolom x, baris y di level zoom `level` (koordinat layar pada skala level itu / ukuran tile)
+struct TileKey {
+    int level = 0;
+    int x = 0;
+    int y = 0;
+    bool operator==(const TileKey& o) const { return level == o.level && x == o.x && y == o.y; }
+};
+
+struct TileKeyHash {
+    size_t operator()(const TileKey& k) const {
+        uint64_t h = (uint64_t)(uint32_t)k.x * 0x9E3779B97F4A7C15ull;
+        h ^= ((uint64_t)(uint32_t)k.y + 0x632BE59BD9B4E019ull + (h << 6) + (h >> 2)) * 0xC2B2AE3D27D4EB4Full;
+        return (size_t)(h ^ (uint64_t)(uint32_t)k.level * 0x165667B19E3779F9ull);
+    }
+};
+
+template <typename Tile>
+class TileCache {
+public:
+    explicit TileCache(size_t capacity = 160) : m_capacity(capacity ? capacity : 1) {}
+
+    // Tile untuk key; fresh = true jika isinya harus (di)gambar: tile baru, tile lama yang
+    // dipakai ulang, atau tile setelah Invalidate(). Tile menjadi yang paling baru dipakai.
+    Tile& Acquire(const TileKey& key, bool& fresh) {
+        auto found = m_map.find(key);
+        if (found != m_map.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, found->second);
+            m_hits++;
+            fresh = false;
+            return found->second->tile;
+        }
+        if (!m_free.empty()) {
+            m_lru.splice(m_lru.begin(), m_free, m_free.begin());
+        } else if (m_lru.size() < m_capacity) {
+            m_lru.emplace_front();
+        } else {
+            m_map.erase(m_lru.back().key); // Paling lama tidak dipakai
+            m_lru.splice(m_lru.begin(), m_lru, std::prev(m_lru.end()));
+        }
+        m_lru.front().key = key;
+        m_map[key] = m_lru.begin();
+        m_misses++;
+        fresh = true;
+        return m_lru.front().tile;
+    }
+
+    void Invalidate() {
+        m_map.clear();
+        m_free.splice(m_free.end(), m_lru);
+    }
+
+    // Memanggil fn(tile) untuk semua objek tile (mis. menghapus bitmap sebelum cache dibuang)
+    template <typename Fn> void ForEach(Fn&& fn) {
+        for (Entry& e : m_lru) fn(e.tile);
+        for (Entry& e : m_free) fn(e.tile);
+    }
+
+    size_t Size() const { return m_lru.size(); }
+    size_t Capacity() const { return m_capacity; }
+    uint64_t Hits() const { return m_hits; }
+    uint64_t Misses() const { return m_misses; }
+
+private:
+    struct Entry {
+        TileKey key;
+        Tile tile{};
+    };
+    size_t m_capacity;
+    std::list<Entry> m_lru;  // Depan = paling baru dipakai
+    std::list<Entry> m_free; // Objek tile yang isinya sudah tidak berlaku
+    std::unordered_map<TileKey, typename std::list<Entry>::iterator, TileKeyHash> m_map;
+    uint64_t m_hits = 0, m_misses = 0;
+};
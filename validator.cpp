@@ -0,0 +1,249 @@
+#include "validator.h"
+#include "parallel.h"
+#include "stats.h"
+
+#include <algorithm>   // std::sort untuk menyusun hasil semua thread
+#include <chrono>      // Untuk mengukur durasi validasi
+
+static const uint32_t NONE = DataModel::NO_INDEX;
+static const size_t CHUNK_PEOPLE = 1 << 16; // Orang per potongan pemeriksaan per orang
+
+const char* IssueKindName(IssueKind kind) {
+    static const char* const NAMES[] = { "duplicate_id", "missing_father", "missing_mother", "missing_spouse",
+                                         "self_spouse", "one_sided_spouse", "one_sided_ex", "father_female",
+                                         "mother_male", "same_parent", "ancestry_cycle", "unreachable" };
+    return NAMES[(int)kind];
+}
+
+static ValidationIssue MakeIssue(const DataModel& model, IssueKind kind, size_t index, int otherId, size_t other = IdIndex::NPOS) {
+    ValidationIssue issue;
+    issue.kind = kind;
+    issue.index = (uint32_t)index;
+    issue.line = model.people[index].line;
+    issue.otherId = otherId;
+    if (other != IdIndex::NPOS && other != NONE) issue.otherLine = model.people[other].line;
+    return issue;
+}
+
+// -----------------------------------------------------------------------------
+// PEMERIKSAAN PER ORANG (ID ganda, rujukan, pasangan, peran orang tua)
+// -----------------------------------------------------------------------------
+static void CheckPeople(const DataModel& model, size_t begin, size_t end, std::vector<ValidationIssue>& out) {
+    for (size_t i = begin; i < end; ++i) {
+        const Person& p = model.people[i];
+        size_t owner = model.IndexOf(p.id);
+        if (owner != i) out.push_back(MakeIssue(model, IssueKind::DuplicateId, i, p.id, owner));
+
+        uint32_t f = model.fatherIndex[i], m = model.motherIndex[i];
+        if (p.fatherId != 0 && f == NONE) out.push_back(MakeIssue(model, IssueKind::MissingFather, i, p.fatherId));
+        if (p.motherId != 0 && m == NONE) out.push_back(MakeIssue(model, IssueKind::MissingMother, i, p.motherId));
+        if (f != NONE && model.people[f].gender == Gender::Female) out.push_back(MakeIssue(model, IssueKind::FatherFemale, i, p.fatherId, f));
+        if (m != NONE && model.people[m].gender == Gender::Male) out.push_back(MakeIssue(model, IssueKind::MotherMale, i, p.motherId, m));
+        if (p.fatherId != 0 && p.fatherId == p.motherId) out.push_back(MakeIssue(model, IssueKind::SameParent, i, p.fatherId, f));
+
+        for (const SpouseLink& sp : model.Spouses(p)) {
+            size_t s = model.IndexOf(sp.id);
+            if (s == IdIndex::NPOS) {
+                out.push_back(MakeIssue(model, IssueKind::MissingSpouse, i, sp.id));
+                continue;
+            }
+            if (s == i || sp.id == p.id) {
+                out.push_back(MakeIssue(model, IssueKind::SelfSpouse, i, sp.id));
+                continue;
+            }
+            // Daftar pasangan pendek, jadi cukup dicari linear di sisi pasangan
+            const SpouseLink* back = nullptr;
+            for (const SpouseLink& r : model.Spouses(model.people[s])) {
+                if (r.id == p.id) { back = &r; break; }
+            }
+            if (!back) out.push_back(MakeIssue(model, IssueKind::OneSidedSpouse, i, sp.id, s));
+            else if (sp.ex && !back->ex) out.push_back(MakeIssue(model, IssueKind::OneSidedEx, i, sp.id, s));
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// SIKLUS LELUHUR (Urutan topologis; jika tertahan, telusuri orang tua yang belum selesai)
+// -----------------------------------------------------------------------------
+static void CheckCycles(const DataModel& model, const std::vector<uint32_t>& childStart, const std::vector<uint32_t>& children,
+                        std::vector<ValidationIssue>& out) {
+    const size_t n = model.people.size();
+    std::vector<uint32_t> father = model.fatherIndex, mother = model.motherIndex; // Hubungan yang diputus diberi NONE
+    for (size_t i = 0; i < n; ++i) {
+        if (mother[i] == father[i]) mother[i] = NONE; // SameParent: satu hubungan saja
+    }
+    std::vector<uint8_t> pending(n), queued(n, 0);
+    std::vector<uint32_t> order;
+    order.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        pending[i] = (uint8_t)((father[i] != NONE) + (mother[i] != NONE));
+        if (pending[i] == 0) { queued[i] = 1; order.push_back((uint32_t)i); }
+    }
+    std::vector<uint32_t> seen;
+    uint32_t walk = 0;
+    size_t head = 0, scan = 0;
+    for (;;) {
+        while (head < order.size()) {
+            uint32_t u = order[head++];
+            for (uint32_t k = childStart[u]; k < childStart[u + 1]; ++k) {
+                uint32_t c = children[k];
+                if (father[c] != u && mother[c] != u) continue; // Hubungan sudah diputus
+                if (--pending[c] == 0) { queued[c] = 1; order.push_back(c); }
+            }
+        }
+        if (order.size() == n) break;
+        while (queued[scan]) scan++;
+        if (seen.empty()) seen.assign(n, 0);
+        walk++;
+        auto waitingParent = [&](uint32_t x) { return (father[x] != NONE && !queued[father[x]]) ? father[x] : mother[x]; };
+        uint32_t u = (uint32_t)scan;
+        while (seen[u] != walk) { seen[u] = walk; u = waitingParent(u); }
+
+        // u ada di siklus: laporkan sekali di anggota dengan indeks terkecil, lalu putus satu hubungannya
+        uint32_t first = u, length = 0;
+        uint32_t x = u;
+        do {
+            first = std::min(first, x);
+            length++;
+            x = waitingParent(x);
+        } while (x != u);
+        uint32_t next = waitingParent(first);
+        ValidationIssue issue = MakeIssue(model, IssueKind::AncestryCycle, first, model.people[next].id, next);
+        issue.count = length;
+        out.push_back(issue);
+
+        uint32_t p = waitingParent(u);
+        (father[u] == p ? father[u] : mother[u]) = NONE;
+        if (--pending[u] == 0) { queued[u] = 1; order.push_back(u); }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// ORANG YANG TIDAK TERGAMBAR (Penelusuran seperti layout dari semua akar)
+// -----------------------------------------------------------------------------
+static void CheckReachable(const DataModel& model, const std::vector<uint32_t>& childStart, const std::vector<uint32_t>& children,
+                           std::vector<ValidationIssue>& out, size_t& unreachable) {
+    const size_t n = model.people.size();
+    std::vector<uint8_t> drawn(n, 0), unit(n, 0);
+    std::vector<uint32_t> queue;
+    queue.reserve(n);
+
+    // Akar yang ditempatkan layout: tanpa orang tua, bukan baris ID ganda yang tertimpa, dan tidak
+    // ada pasangan ber-ID lebih kecil (orang itu ditempatkan di samping pasangannya)
+    for (uint32_t r : model.rootCandidates) {
+        const Person& p = model.people[r];
+        bool leader = model.IndexOf(p.id) == r;
+        for (const SpouseLink& sp : model.Spouses(p)) leader = leader && sp.id >= p.id;
+        if (leader) { unit[r] = 1; queue.push_back(r); }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        uint32_t u = queue[head];
+        const Person& p = model.people[u];
+        drawn[u] = 1;
+        auto push = [&](ChildRange kids) {
+            for (int childId : kids) {
+                size_t c = model.IndexOf(childId);
+                if (c != IdIndex::NPOS && !unit[c]) { unit[c] = 1; queue.push_back((uint32_t)c); }
+            }
+        };
+        bool male = (p.gender == Gender::Male);
+        for (const SpouseLink& sp : model.Spouses(p)) {
+            size_t s = model.IndexOf(sp.id);
+            if (s != IdIndex::NPOS) drawn[s] = 1;
+            push(model.Children(male ? p.id : sp.id, male ? sp.id : p.id));
+        }
+        push(model.Children(male ? p.id : 0, (p.gender == Gender::Female) ? p.id : 0));
+    }
+
+    // Satu masalah per cabang: orang tak tergambar yang orang tuanya (jika ada) tergambar. Keturunannya
+    // yang juga tak tergambar dihitung di count cabang pertama yang mencapainya.
+    std::vector<uint8_t> counted(n, 0);
+    std::vector<uint32_t> stack;
+    unreachable = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (drawn[i]) continue;
+        unreachable++;
+        uint32_t f = model.fatherIndex[i], m = model.motherIndex[i];
+        if ((f != NONE && !drawn[f]) || (m != NONE && !drawn[m])) continue;
+        ValidationIssue issue = MakeIssue(model, IssueKind::Unreachable, i, 0);
+        counted[i] = 1;
+        stack.assign(1, (uint32_t)i);
+        while (!stack.empty()) {
+            uint32_t x = stack.back();
+            stack.pop_back();
+            issue.count++;
+            for (uint32_t k = childStart[x]; k < childStart[x + 1]; ++k) {
+                uint32_t c = children[k];
+                if (!drawn[c] && !counted[c]) { counted[c] = 1; stack.push_back(c); }
+            }
+        }
+        out.push_back(issue);
+    }
+}
+
+ValidationReport ValidateModel(const DataModel& model, unsigned threads) {
+    auto t0 = std::chrono::steady_clock::now();
+    ScopedTimer timer(Stage::Validate);
+    ValidationReport report;
+    const size_t n = model.people.size();
+    report.people = n;
+    threads = ResolveThreads(threads);
+
+    // Anak per orang tua (CSR), dipakai bersama (read-only) oleh pemeriksaan siklus dan jangkauan
+    std::vector<uint32_t> childStart(n + 1, 0), children;
+    for (size_t i = 0; i < n; ++i) {
+        if (model.fatherIndex[i] != NONE) childStart[model.fatherIndex[i] + 1]++;
+        if (model.motherIndex[i] != NONE && model.motherIndex[i] != model.fatherIndex[i]) childStart[model.motherIndex[i] + 1]++;
+    }
+    for (size_t i = 0; i < n; ++i) childStart[i + 1] += childStart[i];
+    children.resize(childStart[n]);
+    {
+        std::vector<uint32_t> fill(childStart.begin(), childStart.end() - 1);
+        for (size_t i = 0; i < n; ++i) {
+            if (model.fatherIndex[i] != NONE) children[fill[model.fatherIndex[i]]++] = (uint32_t)i;
+            if (model.motherIndex[i] != NONE && model.motherIndex[i] != model.fatherIndex[i]) children[fill[model.motherIndex[i]]++] = (uint32_t)i;
+        }
+    }
+
+    // Tugas 0: siklus, tugas 1: jangkauan (paling lama, jadi diambil lebih dulu), sisanya potongan per orang
+    const size_t chunks = (n + CHUNK_PEOPLE - 1) / CHUNK_PEOPLE;
+    std::vector<std::vector<ValidationIssue>> found(chunks + 2);
+    ParallelFor(chunks + 2, threads, [&](size_t task) {
+        if (task == 0) CheckCycles(model, childStart, children, found[task]);
+        else if (task == 1) CheckReachable(model, childStart, children, found[task], report.unreachable);
+        else {
+            size_t begin = (task - 2) * CHUNK_PEOPLE;
+            CheckPeople(model, begin, std::min(n, begin + CHUNK_PEOPLE), found[task]);
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& f : found) total += f.size();
+    report.issues.reserve(total);
+    for (auto& f : found) {
+        report.issues.insert(report.issues.end(), f.begin(), f.end());
+        std::vector<ValidationIssue>().swap(f);
+    }
+    std::stable_sort(report.issues.begin(), report.issues.end(), [](const ValidationIssue& a, const ValidationIssue& b) {
+        return a.index != b.index ? a.index < b.index : a.kind < b.kind;
+    });
+    for (const ValidationIssue& issue : report.issues) report.counts[(size_t)issue.kind]++;
+    report.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return report;
+}
+
+void PrintValidationReport(const DataModel& model, const ValidationReport& report, std::ostream& out, size_t limit) {
+    size_t shown = (limit == 0) ? report.issues.size() : std::min(limit, report.issues.size());
+    if (shown > 0) out << "line,issue,id,other_id,other_line,count\n";
+    for (size_t k = 0; k < shown; ++k) {
+        const ValidationIssue& issue = report.issues[k];
+        out << issue.line << ',' << IssueKindName(issue.kind) << ',' << model.people[issue.index].id << ','
+            << issue.otherId << ',' << issue.otherLine << ',' << issue.count << '\n';
+    }
+    out << "[VALIDATE] people=" << report.people << " issues=" << report.issues.size();
+    if (shown < report.issues.size()) out << " (first " << shown << " shown)";
+    out << " unreachable=" << report.unreachable << " ms=" << report.ms << "\n";
+    for (size_t k = 0; k < (size_t)IssueKind::Count; ++k) {
+        if (report.counts[k]) out << "[VALIDATE] " << IssueKindName((IssueKind)k) << "=" << report.counts[k] << "\n";
+    }
+}
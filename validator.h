@@ -0,0 +1,60 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// VALIDATOR (Pemeriksaan integritas data keluarga yang sudah dimuat)
+// Data rusak tetap dimuat apa adanya (ID ganda menimpa idToIndex, rujukan ke ID yang tidak ada
+// diabaikan, siklus orang tua dilewati layout), jadi kesalahannya tidak terlihat di tampilan.
+// ValidateModel memeriksa seluruh DataModel dan mengembalikan daftar masalah beserta nomor
+// barisnya. Pemeriksaan per orang dibagi per potongan ke beberapa thread; siklus leluhur dan
+// orang yang tidak tergambar masing-masing dikerjakan satu thread bersamaan dengan potongan itu.
+// Hasilnya sama untuk berapa pun jumlah thread.
+// -----------------------------------------------------------------------------
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "model.h"
+
+enum class IssueKind : uint8_t {
+    DuplicateId,    // ID sama dengan baris lain; baris ini tertimpa (idToIndex memakai baris terakhir)
+    MissingFather,  // ID Ayah tidak ada di data
+    MissingMother,  // ID Ibu tidak ada di data
+    MissingSpouse,  // ID pasangan tidak ada di data
+    SelfSpouse,     // Pasangan dirinya sendiri
+    OneSidedSpouse, // A mencantumkan B sebagai pasangan, B tidak mencantumkan A
+    OneSidedEx,     // Keduanya saling mencantumkan, tapi tanda cerai 'x' hanya di sisi ini
+    FatherFemale,   // Orang di kolom Ayah berjenis kelamin F
+    MotherMale,     // Orang di kolom Ibu berjenis kelamin M
+    SameParent,     // Ayah dan Ibu orang yang sama
+    AncestryCycle,  // Orang ini leluhur dirinya sendiri (satu masalah per siklus)
+    Unreachable,    // Tidak tergambar: tidak terjangkau dari akar mana pun (orang teratas tiap cabang)
+    Count
+};
+const char* IssueKindName(IssueKind kind);
+
+struct ValidationIssue {
+    IssueKind kind = IssueKind::Count;
+    uint32_t index = 0;  // Orang yang bermasalah (indeks people)
+    int line = 0;        // Baris asal orang itu di file
+    int otherId = 0;     // ID yang dirujuk (orang tua, pasangan, ID ganda, anggota siklus berikutnya)
+    int otherLine = 0;   // Baris orang yang dirujuk jika ada di data, selain itu 0
+    uint32_t count = 0;  // AncestryCycle: jumlah orang di siklus; Unreachable: orang tak tergambar di cabangnya
+};
+
+struct ValidationReport {
+    std::vector<ValidationIssue> issues;   // Urut menurut indeks orang lalu jenis masalah
+    size_t counts[(size_t)IssueKind::Count] = {};
+    size_t people = 0;
+    size_t unreachable = 0; // Semua orang yang tidak tergambar (termasuk keturunan dan anggota siklus)
+    double ms = 0;
+    bool Ok() const { return issues.empty(); }
+};
+
+// Memeriksa model yang indeksnya sudah dibangun (LoadData/LoadSnapshot). threads: 0 = otomatis.
+// "Tergambar" mengikuti aturan layout: mulai dari akar (tanpa Ayah & Ibu), lalu pasangan dan anak
+// per pasangan (anak laki-laki dicari sebagai Ayah, perempuan sebagai Ibu), tanpa melihat status ciut.
+ValidationReport ValidateModel(const DataModel& model, unsigned threads = 0);
+
+// Menulis laporan sebagai CSV "line,issue,id,other_id,other_line,count" (maksimal limit baris,
+// 0 = semua) lalu satu baris ringkasan "[VALIDATE] ..." per jenis masalah
+void PrintValidationReport(const DataModel& model, const ValidationReport& report, std::ostream& out, size_t limit = 0);